@@ -138,6 +138,8 @@ static void AD7021_2_IOCTL(bool doSle = true)
 
 void IO::interrupt1()
 {
+    PROFILE_SCOPE(PROBE_IO_INTERRUPT1);
+
     uint8_t bit = 0U;
 
     if (!m_started)
@@ -214,6 +216,10 @@ void IO::interrupt1()
         m_rxBuffer.put(bit, m_control);
     }
 
+    // one bit period per rising edge, whether receiving or transmitting
+    if (clk == 1U)
+        m_clock++;
+
     if (toRxRequest && even == ADF7021_EVEN_BIT && m_tx && clk == 0U) {
         // that is absolutely crucial in 4FSK, see datasheet:
         // enable sle after 1/4 tBit == 26uS when sending MSB (even == false) and clock is low
@@ -248,6 +254,8 @@ void IO::interrupt1()
 
 void IO::interrupt2()
 {
+    PROFILE_SCOPE(PROBE_IO_INTERRUPT2);
+
     uint8_t bit = 0U;
 
     if (m_duplex) {
@@ -1371,7 +1379,12 @@ void IO::setRX(bool doSle)
     if (!doSle) {
         toRxRequest = true;
         while(toRxRequest) {
+#if defined(HOST_SIM)
+            // polling the clock pin lets the simulated symbol clock advance
+            CLK();
+#else
             asm volatile ("nop"); 
+#endif
         }
     }
 }
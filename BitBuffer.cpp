@@ -6,6 +6,7 @@
  *
  *  Copyright (C) 2015,2016 Jonathan Naylor, G4KLX
  *  Serial FIFO Control Copyright (C) 2015 by James McLaughlin, KI6ZUM
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 #include "BitBuffer.h"
@@ -17,96 +18,237 @@
 /* Initializes a new instance of the BitBuffer class. */
 
 BitBuffer::BitBuffer(uint16_t length) :
-    m_length(length),
+    m_length(32U),
+    m_mask(0U),
     m_bits(NULL),
-    m_control(NULL),
     m_head(0U),
     m_tail(0U),
-    m_full(false),
-    m_overflow(false)
+    m_markPos(),
+    m_markControl(),
+    m_markHead(0U),
+    m_markTail(0U),
+    m_putControl(0U),
+    m_getControl(0U),
+    m_dropped(0U),
+    m_droppedSeen(0U),
+    m_marksDropped(0U)
 {
-    m_bits = new uint8_t[length / 8U];
-    m_control = new uint8_t[length / 8U];
+    while (m_length < length)
+        m_length <<= 1;
+    m_mask = m_length - 1U;
+
+    m_bits = new uint32_t[m_length / 32U];
 }
 
-/* Helper to get how much space the ring buffer has for samples. */
+/* Puts a bit into the ring buffer. */
 
-uint16_t BitBuffer::getSpace() const
+bool BitBuffer::put(uint8_t bit, uint8_t control)
 {
-    uint16_t n = 0U;
+    uint16_t head = m_head;
+    if (uint16_t(head - m_tail) >= m_length) {
+        m_dropped++;
+        return false;
+    }
 
-    if (m_tail == m_head)
-        n = m_full ? 0U : m_length;
-    else if (m_tail < m_head)
-        n = m_length - m_head + m_tail;
-    else
-        n = m_tail - m_head;
+    if ((control ? 1U : 0U) != m_putControl)
+        putMark(control);
+    BIT_RB_BARRIER();
 
-    if (n > m_length)
-        n = 0U;
+    uint16_t pos = head & m_mask;
+    uint32_t mask = 0x80000000U >> (pos & 0x1FU);
+    if (bit)
+        m_bits[pos >> 5] |= mask;
+    else
+        m_bits[pos >> 5] &= ~mask;
 
-    return n;
+    BIT_RB_BARRIER();
+    m_head = head + 1U;
+    return true;
 }
 
-/* */
+/* Gets a bit from the ring buffer. */
 
-uint16_t BitBuffer::getData() const
+bool BitBuffer::get(uint8_t& bit, uint8_t& control)
 {
-    if (m_tail == m_head)
-        return m_full ? m_length : 0U;
-    else if (m_tail < m_head)
-        return m_head - m_tail;
-    else
-        return m_length - m_tail + m_head;
+    uint16_t tail = m_tail;
+    if (m_head == tail)
+        return false;
+    BIT_RB_BARRIER();
+
+    uint16_t pos = tail & m_mask;
+    uint32_t mask = 0x80000000U >> (pos & 0x1FU);
+    bit = (m_bits[pos >> 5] & mask) ? 1U : 0U;
+
+    // apply any control mark landing on this bit
+    while (m_markTail != m_markHead) {
+        BIT_RB_BARRIER();
+        uint8_t mark = m_markTail & (BIT_RB_MARKS - 1U);
+        if (m_markPos[mark] != tail)
+            break;
+
+        m_getControl = m_markControl[mark];
+        m_markTail = m_markTail + 1U;
+    }
+    control = m_getControl;
+
+    BIT_RB_BARRIER();
+    m_tail = tail + 1U;
+    return true;
 }
 
-/* */
+/* Puts multiple bits into the ring buffer, at the current control level. */
 
-bool BitBuffer::put(uint8_t bit, uint8_t control)
+bool BitBuffer::putBits(uint32_t bits, uint8_t n)
 {
-    if (m_full) {
-        m_overflow = true;
+    uint16_t head = m_head;
+    if (uint16_t(head - m_tail) + n > m_length) {
+        m_dropped += n;
         return false;
     }
+    BIT_RB_BARRIER();
+
+    // left align the bits
+    writeBits(m_bits, head & m_mask, bits << (32U - n), n);
+
+    BIT_RB_BARRIER();
+    m_head = head + n;
+    return true;
+}
+
+/* Changes the control level, starting at the given bit after the next bit put. */
 
-    _WRITE_BIT(m_bits, m_head, bit);
-    _WRITE_BIT(m_control, m_head, control);
+bool BitBuffer::putMark(uint8_t control, uint16_t offset)
+{
+    control = control ? 1U : 0U;
+    if (control == m_putControl)
+        return true;
+
+    uint8_t head = m_markHead;
+    if (uint8_t(head - m_markTail) >= BIT_RB_MARKS) {
+        m_marksDropped++;
+        return false;
+    }
 
-    m_head++;
-    if (m_head >= m_length)
-        m_head = 0U;
+    uint8_t mark = head & (BIT_RB_MARKS - 1U);
+    m_markPos[mark] = m_head + offset;
+    m_markControl[mark] = control;
 
-    if (m_head == m_tail)
-        m_full = true;
+    BIT_RB_BARRIER();
+    m_markHead = head + 1U;
 
+    m_putControl = control;
     return true;
 }
 
-/* */
+/* Gets multiple bits from the ring buffer. */
 
-bool BitBuffer::get(uint8_t& bit, uint8_t& control)
+bool BitBuffer::getBits(uint32_t& bits, uint8_t n)
 {
-    if (m_head == m_tail && !m_full)
+    uint16_t tail = m_tail;
+    if (uint16_t(m_head - tail) < n)
         return false;
+    BIT_RB_BARRIER();
 
-    bit = _READ_BIT(m_bits, m_tail);
-    control = _READ_BIT(m_control, m_tail);
+    bits = readBits(m_bits, tail & m_mask, n);
 
-    m_full = false;
+    // retire any control marks landing on these bits
+    while (m_markTail != m_markHead) {
+        BIT_RB_BARRIER();
+        uint8_t mark = m_markTail & (BIT_RB_MARKS - 1U);
+        if (uint16_t(m_markPos[mark] - tail) >= n)
+            break;
 
-    m_tail++;
-    if (m_tail >= m_length)
-        m_tail = 0U;
+        m_getControl = m_markControl[mark];
+        m_markTail = m_markTail + 1U;
+    }
 
+    BIT_RB_BARRIER();
+    m_tail = tail + n;
     return true;
 }
 
-/* */
+/* Gets multiple bits, and their control levels, from the ring buffer. */
+
+bool BitBuffer::getBits(uint32_t& bits, uint32_t& control, uint8_t n)
+{
+    uint16_t tail = m_tail;
+    if (uint16_t(m_head - tail) < n)
+        return false;
+    BIT_RB_BARRIER();
+
+    bits = readBits(m_bits, tail & m_mask, n);
+
+    // expand the control marks landing on these bits into levels
+    uint32_t all = (n == 32U) ? 0xFFFFFFFFU : ((1U << n) - 1U);
+    control = m_getControl ? all : 0U;
+    while (m_markTail != m_markHead) {
+        BIT_RB_BARRIER();
+        uint8_t mark = m_markTail & (BIT_RB_MARKS - 1U);
+        uint16_t offset = m_markPos[mark] - tail;
+        if (offset >= n)
+            break;
+
+        // the level applies from this bit to the last bit
+        uint32_t from = all >> offset;
+        m_getControl = m_markControl[mark];
+        if (m_getControl)
+            control |= from;
+        else
+            control &= ~from;
+
+        m_markTail = m_markTail + 1U;
+    }
+
+    BIT_RB_BARRIER();
+    m_tail = tail + n;
+    return true;
+}
+
+/* Flag indicating the ring buffer has overflowed since the last call. */
 
 bool BitBuffer::hasOverflowed()
 {
-    bool overflow = m_overflow;
-    m_overflow = false;
+    uint32_t dropped = m_dropped;
+    bool overflow = dropped != m_droppedSeen;
+    m_droppedSeen = dropped;
 
     return overflow;
 }
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to write bits into a packed word array. */
+
+void BitBuffer::writeBits(volatile uint32_t* words, uint16_t pos, uint32_t bits, uint8_t n)
+{
+    uint32_t mask = 0xFFFFFFFFU << (32U - n);
+    bits &= mask;
+
+    uint16_t word = pos >> 5;
+    uint8_t offset = pos & 0x1FU;
+    words[word] = (words[word] & ~(mask >> offset)) | (bits >> offset);
+
+    // the bits straddle a word boundary
+    if (offset + n > 32U) {
+        word = (word + 1U) & (m_mask >> 5);
+        uint8_t shift = 32U - offset;
+        words[word] = (words[word] & ~(mask << shift)) | (bits << shift);
+    }
+}
+
+/* Helper to read bits from a packed word array. */
+
+uint32_t BitBuffer::readBits(const volatile uint32_t* words, uint16_t pos, uint8_t n) const
+{
+    uint16_t word = pos >> 5;
+    uint8_t offset = pos & 0x1FU;
+    uint32_t bits = words[word] << offset;
+
+    // the bits straddle a word boundary
+    if (offset + n > 32U)
+        bits |= words[(word + 1U) & (m_mask >> 5)] >> (32U - offset);
+
+    return bits >> (32U - n);
+}
@@ -6,6 +6,7 @@
  *
  *  Copyright (C) 2015,2016 Jonathan Naylor, G4KLX
  *  Serial FIFO Control Copyright (C) 2015 by James McLaughlin, KI6ZUM
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -22,23 +23,56 @@
 #elif defined(STM32F4XX)
 #include "stm32f4xx.h"
 #include <cstddef>
+#elif defined(HOST_SIM)
+#include <cstddef>
 #endif
 
 #include "Defines.h"
 
+// ---------------------------------------------------------------------------
+//  Macros
+// ---------------------------------------------------------------------------
+
+#if defined(HOST_SIM)
+/** @brief Orders the ring buffer data accesses against the publication of an index (host threads). */
+#define BIT_RB_BARRIER() __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#else
+/** @brief Orders the ring buffer data accesses against the publication of an index (single core, the
+ *  interrupt handler and the superloop only need the compiler to not reorder them). */
+#define BIT_RB_BARRIER() asm volatile("" ::: "memory")
+#endif
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/** @brief Number of control mark changes a ring buffer can hold (needs to be a power of 2!). */
+const uint8_t BIT_RB_MARKS = 16U;
+
 // ---------------------------------------------------------------------------
 //  Class Declaration
 // ---------------------------------------------------------------------------
 
 /**
  * @brief Implements a circular ring buffer for bit data.
+ * @details The bits are packed MSB first into 32-bit words. The length is rounded up to a power of
+ *  two, so the free running head and tail indices are wrapped by masking and the amount of data is
+ *  simply their difference.
+ *
+ *  Each bit carries a control level (the DMR slot control), which only changes once per burst; rather
+ *  than a control bit for every data bit the ring buffer keeps a small queue of the bit positions the
+ *  level changes at. Rings whose control level never changes pay nothing but an empty queue check.
+ *
+ *  This is a lock-free single producer/single consumer ring; the head indices (and the drop counter)
+ *  are only written by the producer (put/putBits/putMark), the tail indices only by the consumer
+ *  (get/getBits), so the interrupt handler and the superloop may each own one side.
  * @ingroup hotspot_fw
  */
 class DSP_FW_API BitBuffer {
 public:
     /**
      * @brief Initializes a new instance of the BitBuffer class.
-     * @param length Length of buffer.
+     * @param length Length of buffer (rounded up to a power of two, at least 32 bits).
      */
     BitBuffer(uint16_t length);
 
@@ -46,47 +80,120 @@ public:
      * @brief Helper to get how much space the ring buffer has for samples.
      * @returns uint16_t Amount of space remaining for data.
      */
-    uint16_t getSpace() const;
+    uint16_t getSpace() const { return m_length - uint16_t(m_head - m_tail); }
 
     /**
-     * @brief 
-     * @returns uint16_t 
+     * @brief Helper to get how much data the ring buffer has.
+     * @returns uint16_t Amount of data in the ring buffer.
      */
-    uint16_t getData() const;
+    uint16_t getData() const { return uint16_t(m_head - m_tail); }
 
     /**
-     * @brief 
-     * @param bit 
-     * @param control
-     * @returns bool 
+     * @brief Puts a bit into the ring buffer.
+     * @param bit Bit value.
+     * @param control Control level for the bit; a change from the previous bit queues a control mark.
+     * @returns bool True, if the bit was put, otherwise false if the ring buffer is full.
      */
     bool put(uint8_t bit, uint8_t control);
 
     /**
-     * @brief 
-     * @param[out] bit 
-     * @param[out] control 
-     * @returns bool 
+     * @brief Gets a bit from the ring buffer.
+     * @param[out] bit Bit value.
+     * @param[out] control Control level for the bit.
+     * @returns bool True, if a bit was got, otherwise false if the ring buffer is empty.
      */
     bool get(uint8_t& bit, uint8_t& control);
 
     /**
-     * @brief 
-     * @returns bool 
+     * @brief Puts multiple bits into the ring buffer, at the current control level.
+     * @param bits Bits to put; the n least significant bits, most significant first.
+     * @param n Number of bits (1 to 32).
+     * @returns bool True, if the bits were put, otherwise false if the ring buffer doesn't have the space
+     *  (no bits are put).
+     */
+    bool putBits(uint32_t bits, uint8_t n);
+    /**
+     * @brief Changes the control level, starting at the given bit after the next bit put.
+     * @details Marks must be put in bit order, before the bits they apply to.
+     * @param control Control level.
+     * @param offset Offset of the first bit at the control level, from the next bit put.
+     * @returns bool True, if the control mark was queued, otherwise false if the control mark queue is full
+     *  (the refusal is counted, see getMarksDropped()).
+     */
+    bool putMark(uint8_t control, uint16_t offset = 0U);
+
+    /**
+     * @brief Gets multiple bits from the ring buffer.
+     * @param[out] bits Bits got; the n least significant bits, most significant first.
+     * @param n Number of bits (1 to 32).
+     * @returns bool True, if the bits were got, otherwise false if the ring buffer doesn't have the data
+     *  (no bits are got).
+     */
+    bool getBits(uint32_t& bits, uint8_t n);
+    /**
+     * @brief Gets multiple bits, and their control levels, from the ring buffer.
+     * @param[out] bits Bits got; the n least significant bits, most significant first.
+     * @param[out] control Control levels for the bits, aligned as the bits.
+     * @param n Number of bits (1 to 32).
+     * @returns bool True, if the bits were got, otherwise false if the ring buffer doesn't have the data
+     *  (no bits are got).
+     */
+    bool getBits(uint32_t& bits, uint32_t& control, uint8_t n);
+
+    /**
+     * @brief Flag indicating the ring buffer has overflowed since the last call.
+     * @returns bool Flag indicating bits were dropped since the last call.
      */
     bool hasOverflowed();
+    /**
+     * @brief Gets the number of bits dropped because the ring buffer was full.
+     * @returns uint32_t Monotonically increasing count of dropped bits.
+     */
+    uint32_t getDropped() const { return m_dropped; }
+    /**
+     * @brief Gets the number of control level changes refused because the control mark queue was full.
+     * @details A change refused by put() is tried again with the next bit put, so it lands late rather
+     *  than being lost; each refusal is counted.
+     * @returns uint32_t Monotonically increasing count of refused control level changes.
+     */
+    uint32_t getMarksDropped() const { return m_marksDropped; }
 
 private:
     uint16_t m_length;
-    volatile uint8_t* m_bits;
-    volatile uint8_t* m_control;
+    uint16_t m_mask;
+    volatile uint32_t* m_bits;
 
     volatile uint16_t m_head;
     volatile uint16_t m_tail;
 
-    volatile bool m_full;
+    volatile uint16_t m_markPos[BIT_RB_MARKS];
+    volatile uint8_t m_markControl[BIT_RB_MARKS];
+    volatile uint8_t m_markHead;
+    volatile uint8_t m_markTail;
+
+    uint8_t m_putControl;
+    uint8_t m_getControl;
+
+    volatile uint32_t m_dropped;
+    uint32_t m_droppedSeen;
+    volatile uint32_t m_marksDropped;
 
-    bool m_overflow;
+    /**
+     * @brief Helper to write bits into a packed word array.
+     * @param words Packed word array.
+     * @param pos Bit position of the first bit.
+     * @param bits Bits to write; left aligned.
+     * @param n Number of bits (1 to 32).
+     */
+    void writeBits(volatile uint32_t* words, uint16_t pos, uint32_t bits, uint8_t n);
+    /**
+     * @brief Helper to read bits from a packed word array.
+     * @param words Packed word array.
+     * @param pos Bit position of the first bit.
+     * @param n Number of bits (1 to 32).
+     * @returns uint32_t Bits read; right aligned.
+     */
+    uint32_t readBits(const volatile uint32_t* words, uint16_t pos, uint8_t n) const;
 };
 
 #endif // __BIT_RB_H__
@@ -18,9 +18,9 @@
 
 // 4FSK symbol sequence (800 Hz "tone" at 4800 baud): +1 +3 +1 -1 -3 -1
 // Bit sequence: 00 01 00 10 11 10
-uint8_t TONE[] = { 0, 0, 0, 1, 0, 0, 1, 0, 1, 1, 1, 0 };
+const uint32_t TONE = 0x12EU;
 
-uint8_t SILENCE[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+const uint32_t SILENCE = 0x000U;
 
 const uint8_t CYCLE_LENGTH = 12U;
 
@@ -104,9 +104,9 @@ void CWIdTX::process()
     while (space > CYCLE_LENGTH) {
         bool b = _READ_BIT(m_poBuffer, m_poPtr);
         if (b)
-            io.write(TONE, CYCLE_LENGTH);
+            io.writeBits(TONE, CYCLE_LENGTH);
         else
-            io.write(SILENCE, CYCLE_LENGTH);
+            io.writeBits(SILENCE, CYCLE_LENGTH);
 
         space -= CYCLE_LENGTH;
 
@@ -103,6 +103,38 @@ typedef unsigned long long  ulong64_t;
 // Pass RSSI information to the host
 // #define SEND_RSSI_DATA
 
+// Pass the counts of bits corrected in the vocoder frames of each DMR voice burst and P25 LDU to the host (as
+// trailing bytes)
+// #define SEND_BER_DATA
+
+// Pass the bit clock (IO::getClock()) the first bit of each received frame arrived at to the host (as 4 trailing
+// bytes, after any RSSI and BER bytes)
+// #define SEND_RX_TIMESTAMP
+
+// Enable the hot path cycle profiler (reported to the host by CMD_GET_PROFILE)
+// #define ENABLE_PROFILER
+
+// Enable the received frame latency tracer (reported to the host by CMD_GET_TRACE)
+// #define ENABLE_TRACER
+
+// Count bits with branchless SWAR arithmetic instead of the byte lookup table (not yet measured on Cortex-M)
+// #define COUNT_BITS_SWAR
+
+// Drop DMR CSBKs and data headers whose BPTC (196,96) payload fails its CRC, rather than passing them to the host
+// (the number dropped is reported to the host by CMD_GET_REJECTS)
+// #define DMR_VALIDATE_DATA
+
+// Drop NXDN frames whose LICH fails its parity check, rather than passing them (flagged) to the host
+// #define NXDN_DROP_LICH_ERRORS
+
+// Drop NXDN frames whose LICH marks them idle, rather than passing them (flagged) to the host
+// #define NXDN_DROP_IDLE
+
+// Maximum number of received bits dispatched to the receivers per IO::process() pass
+#if !defined(RX_BATCH_BITS)
+#define RX_BATCH_BITS   128U
+#endif
+
 #define DESCR_DMR        "DMR, "
 #define DESCR_P25        "P25, "
 #define DESCR_NXDN       "NXDN, "
@@ -113,6 +145,30 @@ typedef unsigned long long  ulong64_t;
 #define DESCR_RSSI        ""
 #endif
 
+#if defined(SEND_BER_DATA)
+#define DESCR_BER         "BER, "
+#else
+#define DESCR_BER         ""
+#endif
+
+#if defined(SEND_RX_TIMESTAMP)
+#define DESCR_TIMESTAMP   "Timestamp, "
+#else
+#define DESCR_TIMESTAMP   ""
+#endif
+
+#if defined(ENABLE_PROFILER)
+#define DESCR_PROFILER    "Profiler, "
+#else
+#define DESCR_PROFILER    ""
+#endif
+
+#if defined(ENABLE_TRACER)
+#define DESCR_TRACER      "Tracer, "
+#else
+#define DESCR_TRACER      ""
+#endif
+
 #if defined(ZUMSPOT_ADF7021)
 #define BOARD_INFO      "ZUMspot"
 #elif defined(MMDVM_HS_HAT_REV12)
@@ -127,6 +183,8 @@ typedef unsigned long long  ulong64_t;
 #define BOARD_INFO      "SkyBridge"
 #elif defined(LONESTAR_USB)
 #define BOARD_INFO      "LS_USB_STICK"
+#elif defined(HOST_SIM)
+#define BOARD_INFO      "Host_Sim"
 #else
 #define BOARD_INFO      "MMDVM_HS"
 #endif
@@ -144,7 +202,7 @@ typedef unsigned long long  ulong64_t;
 #define RF_CHIP         "ADF7021, "
 #endif
 
-#define DESCRIPTION        "Digital Voice Modem DSP Hotspot [" BOARD_INFO "] (" RF_CHIP DESCR_DMR DESCR_P25 DESCR_NXDN DESCR_OSC DESCR_RSSI "CW Id)"
+#define DESCRIPTION        "Digital Voice Modem DSP Hotspot [" BOARD_INFO "] (" RF_CHIP DESCR_DMR DESCR_P25 DESCR_NXDN DESCR_OSC DESCR_RSSI DESCR_BER DESCR_TIMESTAMP DESCR_PROFILER DESCR_TRACER "CW Id)"
 
 const uint8_t BIT_MASK_TABLE[] = { 0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U };
 
@@ -67,12 +67,25 @@ CWIdTX cwIdTX;
 SerialPort serial;
 IO io;
 
+#if defined(ENABLE_PROFILER)
+/* Hot Path Profiler */
+Profiler profiler;
+#endif
+
+#if defined(ENABLE_TRACER)
+/* Received Frame Latency Tracer */
+Tracer tracer;
+#endif
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
 
 void setup()
 {
+#if defined(ENABLE_PROFILER)
+    profiler.init();
+#endif
     io.init();
 
     serial.start();
@@ -120,6 +133,7 @@ void loop()
         cwIdTX.process();
 }
 
+#if !defined(HOST_SIM)
 // ---------------------------------------------------------------------------
 //  Firmware Entry Point
 // ---------------------------------------------------------------------------
@@ -190,3 +204,4 @@ int main()
     for (;;)
         loop();
 }
+#endif // !HOST_SIM
@@ -31,6 +31,9 @@
 #elif defined(STM32F7XX)
 #include "stm32f7xx.h"
 #include "string.h"
+#elif defined(HOST_SIM)
+#include <cstddef>
+#include "string.h"
 #endif
 
 #include "Defines.h"
@@ -52,6 +55,8 @@
 #include "CalRSSI.h"
 #include "CWIdTX.h"
 #include "IO.h"
+#include "Profiler.h"
+#include "Tracer.h"
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -75,6 +80,18 @@ const uint8_t   CONTROL_SLOT2 = 0x00U;
 #define  DEBUG5(a,b,c,d,e)  serial.writeDebug((a),(b),(c),(d),(e))
 #define  DEBUG_DUMP(a,b)    serial.writeDump((a),(b))
 
+#if defined(ENABLE_PROFILER)
+#define  PROFILE_SCOPE(a)   ProfilerScope __profilerScope((a))
+#else
+#define  PROFILE_SCOPE(a)
+#endif
+
+#if defined(ENABLE_TRACER)
+#define  TRACE_SYNC()       tracer.sync()
+#else
+#define  TRACE_SYNC()
+#endif
+
 // ---------------------------------------------------------------------------
 //  Global Externs
 // ---------------------------------------------------------------------------
@@ -99,6 +116,14 @@ extern uint8_t m_control;
 extern SerialPort serial;
 extern IO io;
 
+#if defined(ENABLE_PROFILER)
+extern Profiler profiler;
+#endif
+
+#if defined(ENABLE_TRACER)
+extern Tracer tracer;
+#endif
+
 /* DMR BS */
 #if defined(DUPLEX)
 extern dmr::DMRIdleRX dmrIdleRX;
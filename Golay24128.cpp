@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Golay24128.h"
+#include "Utils.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// (23,12) parity, generator x^11 + x^10 + x^6 + x^5 + x^4 + x^2 + 1 (0xC75); the code is linear, so the
+// parity of the 12 data bits is the parity of the upper 6 bits XOR the parity of the lower 6 bits
+const uint16_t PARITY_TABLE_HI_23127[] = {
+    0x000U, 0x6CCU, 0x1EDU, 0x721U, 0x3DAU, 0x516U, 0x237U, 0x4FBU,
+    0x7B4U, 0x178U, 0x659U, 0x095U, 0x46EU, 0x2A2U, 0x583U, 0x34FU,
+    0x31DU, 0x5D1U, 0x2F0U, 0x43CU, 0x0C7U, 0x60BU, 0x12AU, 0x7E6U,
+    0x4A9U, 0x265U, 0x544U, 0x388U, 0x773U, 0x1BFU, 0x69EU, 0x052U,
+    0x63AU, 0x0F6U, 0x7D7U, 0x11BU, 0x5E0U, 0x32CU, 0x40DU, 0x2C1U,
+    0x18EU, 0x742U, 0x063U, 0x6AFU, 0x254U, 0x498U, 0x3B9U, 0x575U,
+    0x527U, 0x3EBU, 0x4CAU, 0x206U, 0x6FDU, 0x031U, 0x710U, 0x1DCU,
+    0x293U, 0x45FU, 0x37EU, 0x5B2U, 0x149U, 0x785U, 0x0A4U, 0x668U };
+
+const uint16_t PARITY_TABLE_LO_23127[] = {
+    0x000U, 0x475U, 0x49FU, 0x0EAU, 0x54BU, 0x13EU, 0x1D4U, 0x5A1U,
+    0x6E3U, 0x296U, 0x27CU, 0x609U, 0x3A8U, 0x7DDU, 0x737U, 0x342U,
+    0x1B3U, 0x5C6U, 0x52CU, 0x159U, 0x4F8U, 0x08DU, 0x067U, 0x412U,
+    0x750U, 0x325U, 0x3CFU, 0x7BAU, 0x21BU, 0x66EU, 0x684U, 0x2F1U,
+    0x366U, 0x713U, 0x7F9U, 0x38CU, 0x62DU, 0x258U, 0x2B2U, 0x6C7U,
+    0x585U, 0x1F0U, 0x11AU, 0x56FU, 0x0CEU, 0x4BBU, 0x451U, 0x024U,
+    0x2D5U, 0x6A0U, 0x64AU, 0x23FU, 0x79EU, 0x3EBU, 0x301U, 0x774U,
+    0x436U, 0x043U, 0x0A9U, 0x4DCU, 0x17DU, 0x508U, 0x5E2U, 0x197U };
+
+// the code is perfect; every 11 bit syndrome maps to exactly one error pattern of 3 bits or fewer, this
+// holds the data bits of that pattern (the parity bits of the pattern are recovered from the syndrome)
+const uint16_t DATA_ERROR_TABLE_23127[] = {
+    0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x048U,
+    0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x824U, 0x000U, 0x000U, 0x000U, 0x301U, 0x000U, 0x400U, 0x090U, 0x002U,
+    0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x048U, 0x000U, 0x000U, 0x000U, 0x048U, 0x000U, 0x048U, 0x048U, 0x048U,
+    0x000U, 0x000U, 0x000U, 0x010U, 0x000U, 0x001U, 0x602U, 0x180U, 0x000U, 0x086U, 0x800U, 0x420U, 0x120U, 0xA10U, 0x005U, 0x048U,
+    0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x500U, 0x000U, 0x000U, 0x000U, 0x004U, 0x000U, 0x222U, 0x090U, 0x801U,
+    0x000U, 0x000U, 0x000U, 0x042U, 0x000U, 0x001U, 0x090U, 0x208U, 0x000U, 0x808U, 0x090U, 0x420U, 0x090U, 0x144U, 0x090U, 0x090U,
+    0x000U, 0x000U, 0x000U, 0xA80U, 0x000U, 0x001U, 0x020U, 0x016U, 0x000U, 0x110U, 0x003U, 0x420U, 0xC04U, 0x080U, 0x300U, 0x048U,
+    0x000U, 0x001U, 0x10CU, 0x420U, 0x001U, 0x001U, 0x840U, 0x001U, 0x240U, 0x420U, 0x420U, 0x420U, 0x00AU, 0x001U, 0x090U, 0x420U,
+    0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x500U, 0x000U, 0x000U, 0x000U, 0x0A0U, 0x000U, 0x015U, 0xA00U, 0x002U,
+    0x000U, 0x000U, 0x000U, 0x010U, 0x000U, 0x2C0U, 0x009U, 0x002U, 0x000U, 0x808U, 0x444U, 0x002U, 0x120U, 0x002U, 0x002U, 0x002U,
+    0x000U, 0x000U, 0x000U, 0x010U, 0x000U, 0x802U, 0x084U, 0x221U, 0x000U, 0x600U, 0x003U, 0x904U, 0x120U, 0x080U, 0x410U, 0x048U,
+    0x000U, 0x010U, 0x010U, 0x010U, 0x120U, 0x40CU, 0x840U, 0x010U, 0x120U, 0x041U, 0x288U, 0x010U, 0x120U, 0x120U, 0x120U, 0x002U,
+    0x000U, 0x000U, 0x000U, 0x500U, 0x000U, 0x500U, 0x500U, 0x500U, 0x000U, 0x808U, 0x003U, 0x250U, 0x040U, 0x080U, 0x02CU, 0x500U,
+    0x000U, 0x808U, 0x220U, 0x085U, 0x006U, 0x030U, 0x840U, 0x500U, 0x808U, 0x808U, 0x100U, 0x808U, 0x601U, 0x808U, 0x090U, 0x002U,
+    0x000U, 0x064U, 0x003U, 0x008U, 0x218U, 0x080U, 0x840U, 0x500U, 0x003U, 0x080U, 0x003U, 0x003U, 0x080U, 0x080U, 0x003U, 0x080U,
+    0x480U, 0x302U, 0x840U, 0x010U, 0x840U, 0x001U, 0x840U, 0x840U, 0x014U, 0x808U, 0x003U, 0x420U, 0x120U, 0x080U, 0x840U, 0x204U,
+    0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x083U, 0x000U, 0x000U, 0x000U, 0x004U, 0x000U, 0x400U, 0xA00U, 0x130U,
+    0x000U, 0x000U, 0x000U, 0x010U, 0x000U, 0x400U, 0x140U, 0x208U, 0x000U, 0x400U, 0x02AU, 0x8C0U, 0x400U, 0x400U, 0x005U, 0x400U,
+    0x000U, 0x000U, 0x000U, 0x010U, 0x000U, 0x304U, 0x020U, 0xC00U, 0x000U, 0x821U, 0x580U, 0x202U, 0x012U, 0x080U, 0x005U, 0x048U,
+    0x000U, 0x010U, 0x010U, 0x010U, 0x888U, 0x062U, 0x005U, 0x010U, 0x240U, 0x108U, 0x005U, 0x010U, 0x005U, 0x400U, 0x005U, 0x005U,
+    0x000U, 0x000U, 0x000U, 0x004U, 0x000U, 0x850U, 0x020U, 0x208U, 0x000U, 0x004U, 0x004U, 0x004U, 0x109U, 0x080U, 0x442U, 0x004U,
+    0x000U, 0x1A0U, 0xC01U, 0x208U, 0x006U, 0x208U, 0x208U, 0x208U, 0x240U, 0x013U, 0x100U, 0x004U, 0x820U, 0x400U, 0x090U, 0x208U,
+    0x000U, 0x40AU, 0x020U, 0x141U, 0x020U, 0x080U, 0x020U, 0x020U, 0x240U, 0x080U, 0x818U, 0x004U, 0x080U, 0x080U, 0x020U, 0x080U,
+    0x240U, 0x804U, 0x082U, 0x010U, 0x510U, 0x001U, 0x020U, 0x208U, 0x240U, 0x240U, 0x240U, 0x420U, 0x240U, 0x080U, 0x005U, 0x902U,
+    0x000U, 0x000U, 0x000U, 0x010U, 0x000U, 0x028U, 0xA00U, 0x044U, 0x000U, 0x142U, 0xA00U, 0x409U, 0xA00U, 0x080U, 0xA00U, 0xA00U,
+    0x000U, 0x010U, 0x010U, 0x010U, 0x006U, 0x901U, 0x4A0U, 0x010U, 0x081U, 0x224U, 0x100U, 0x010U, 0x058U, 0x400U, 0xA00U, 0x002U,
+    0x000U, 0x010U, 0x010U, 0x010U, 0x441U, 0x080U, 0x10AU, 0x010U, 0x00CU, 0x080U, 0x060U, 0x010U, 0x080U, 0x080U, 0xA00U, 0x080U,
+    0x010U, 0x010U, 0x010U, 0x010U, 0x200U, 0x010U, 0x010U, 0x010U, 0xC02U, 0x010U, 0x010U, 0x010U, 0x120U, 0x080U, 0x005U, 0x010U,
+    0x000U, 0x201U, 0x0C8U, 0x822U, 0x006U, 0x080U, 0x011U, 0x500U, 0x430U, 0x080U, 0x100U, 0x004U, 0x080U, 0x080U, 0xA00U, 0x080U,
+    0x006U, 0x440U, 0x100U, 0x010U, 0x006U, 0x006U, 0x006U, 0x208U, 0x100U, 0x808U, 0x100U, 0x100U, 0x006U, 0x080U, 0x100U, 0x061U,
+    0x900U, 0x080U, 0x604U, 0x010U, 0x080U, 0x080U, 0x020U, 0x080U, 0x080U, 0x080U, 0x003U, 0x080U, 0x080U, 0x080U, 0x080U, 0x080U,
+    0x029U, 0x010U, 0x010U, 0x010U, 0x006U, 0x080U, 0x840U, 0x010U, 0x240U, 0x080U, 0x100U, 0x010U, 0x080U, 0x080U, 0x408U, 0x080U,
+    0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x210U, 0x000U, 0x000U, 0x000U, 0x0A0U, 0x000U, 0x400U, 0x106U, 0x801U,
+    0x000U, 0x000U, 0x000U, 0x042U, 0x000U, 0x400U, 0x009U, 0x180U, 0x000U, 0x400U, 0x800U, 0x01CU, 0x400U, 0x400U, 0x260U, 0x400U,
+    0x000U, 0x000U, 0x000U, 0x405U, 0x000U, 0x802U, 0x020U, 0x180U, 0x000U, 0x110U, 0x800U, 0x202U, 0x281U, 0x024U, 0x410U, 0x048U,
+    0x000U, 0x228U, 0x800U, 0x180U, 0x054U, 0x180U, 0x180U, 0x180U, 0x800U, 0x041U, 0x800U, 0x800U, 0x00AU, 0x400U, 0x800U, 0x180U,
+    0x000U, 0x000U, 0x000U, 0x042U, 0x000U, 0x08CU, 0x020U, 0x801U, 0x000U, 0x110U, 0x608U, 0x801U, 0x040U, 0x801U, 0x801U, 0x801U,
+    0x000U, 0x042U, 0x042U, 0x042U, 0xB00U, 0x030U, 0x404U, 0x042U, 0x025U, 0x280U, 0x100U, 0x042U, 0x00AU, 0x400U, 0x090U, 0x801U,
+    0x000U, 0x110U, 0x020U, 0x008U, 0x020U, 0x640U, 0x020U, 0x020U, 0x110U, 0x110U, 0x0C4U, 0x110U, 0x00AU, 0x110U, 0x020U, 0x801U,
+    0x480U, 0x804U, 0x211U, 0x042U, 0x00AU, 0x001U, 0x020U, 0x180U, 0x00AU, 0x110U, 0x800U, 0x420U, 0x00AU, 0x00AU, 0x00AU, 0x204U,
+    0x000U, 0x000U, 0x000U, 0x0A0U, 0x000U, 0x802U, 0x009U, 0x044U, 0x000U, 0x0A0U, 0x0A0U, 0x0A0U, 0x040U, 0x308U, 0x410U, 0x0A0U,
+    0x000U, 0x104U, 0x009U, 0xE00U, 0x009U, 0x030U, 0x009U, 0x009U, 0x212U, 0x041U, 0x100U, 0x0A0U, 0x884U, 0x400U, 0x009U, 0x002U,
+    0x000U, 0x802U, 0x340U, 0x008U, 0x802U, 0x802U, 0x410U, 0x802U, 0x00CU, 0x041U, 0x410U, 0x0A0U, 0x410U, 0x802U, 0x410U, 0x410U,
+    0x480U, 0x041U, 0x026U, 0x010U, 0x200U, 0x802U, 0x009U, 0x180U, 0x041U, 0x041U, 0x800U, 0x041U, 0x120U, 0x041U, 0x410U, 0x204U,
+    0x000U, 0x201U, 0x814U, 0x008U, 0x040U, 0x030U, 0x282U, 0x500U, 0x040U, 0x406U, 0x100U, 0x0A0U, 0x040U, 0x040U, 0x040U, 0x801U,
+    0x480U, 0x030U, 0x100U, 0x042U, 0x030U, 0x030U, 0x009U, 0x030U, 0x100U, 0x808U, 0x100U, 0x100U, 0x040U, 0x030U, 0x100U, 0x204U,
+    0x480U, 0x008U, 0x008U, 0x008U, 0x105U, 0x802U, 0x020U, 0x008U, 0xA20U, 0x110U, 0x003U, 0x008U, 0x040U, 0x080U, 0x410U, 0x204U,
+    0x480U, 0x480U, 0x480U, 0x008U, 0x480U, 0x030U, 0x840U, 0x204U, 0x480U, 0x041U, 0x100U, 0x204U, 0x00AU, 0x204U, 0x204U, 0x204U,
+    0x000U, 0x000U, 0x000U, 0x908U, 0x000U, 0x400U, 0x020U, 0x044U, 0x000U, 0x400U, 0x051U, 0x202U, 0x400U, 0x400U, 0x088U, 0x400U,
+    0x000U, 0x400U, 0x284U, 0x021U, 0x400U, 0x400U, 0x812U, 0x400U, 0x400U, 0x400U, 0x100U, 0x400U, 0x400U, 0x400U, 0x400U, 0x400U,
+    0x000U, 0x0C0U, 0x020U, 0x202U, 0x020U, 0x019U, 0x020U, 0x020U, 0x00CU, 0x202U, 0x202U, 0x202U, 0x940U, 0x400U, 0x020U, 0x202U,
+    0x103U, 0x804U, 0x448U, 0x010U, 0x200U, 0x400U, 0x020U, 0x180U, 0x0B0U, 0x400U, 0x800U, 0x202U, 0x400U, 0x400U, 0x005U, 0x400U,
+    0x000U, 0x201U, 0x020U, 0x490U, 0x020U, 0x102U, 0x020U, 0x020U, 0x882U, 0x068U, 0x100U, 0x004U, 0x214U, 0x400U, 0x020U, 0x801U,
+    0x018U, 0x804U, 0x100U, 0x042U, 0x0C1U, 0x400U, 0x020U, 0x208U, 0x100U, 0x400U, 0x100U, 0x100U, 0x400U, 0x400U, 0x100U, 0x400U,
+    0x020U, 0x804U, 0x020U, 0x020U, 0x020U, 0x020U, 0x020U, 0x020U, 0x401U, 0x110U, 0x020U, 0x202U, 0x020U, 0x080U, 0x020U, 0x020U,
+    0x804U, 0x804U, 0x020U, 0x804U, 0x020U, 0x804U, 0x020U, 0x020U, 0x240U, 0x804U, 0x100U, 0x089U, 0x00AU, 0x400U, 0x020U, 0x050U,
+    0x000U, 0x201U, 0x402U, 0x044U, 0x190U, 0x044U, 0x044U, 0x044U, 0x00CU, 0x810U, 0x100U, 0x0A0U, 0x023U, 0x400U, 0xA00U, 0x044U,
+    0x860U, 0x08AU, 0x100U, 0x010U, 0x200U, 0x400U, 0x009U, 0x044U, 0x100U, 0x400U, 0x100U, 0x100U, 0x400U, 0x400U, 0x100U, 0x400U,
+    0x00CU, 0x520U, 0x881U, 0x010U, 0x200U, 0x802U, 0x020U, 0x044U, 0x00CU, 0x00CU, 0x00CU, 0x202U, 0x00CU, 0x080U, 0x410U, 0x101U,
+    0x200U, 0x010U, 0x010U, 0x010U, 0x200U, 0x200U, 0x200U, 0x010U, 0x00CU, 0x041U, 0x100U, 0x010U, 0x200U, 0x400U, 0x0C2U, 0x828U,
+    0x201U, 0x201U, 0x100U, 0x201U, 0xC08U, 0x201U, 0x020U, 0x044U, 0x100U, 0x201U, 0x100U, 0x100U, 0x040U, 0x080U, 0x100U, 0x01AU,
+    0x100U, 0x201U, 0x100U, 0x100U, 0x006U, 0x030U, 0x100U, 0x880U, 0x100U, 0x100U, 0x100U, 0x100U, 0x100U, 0x400U, 0x100U, 0x100U,
+    0x052U, 0x201U, 0x020U, 0x008U, 0x020U, 0x080U, 0x020U, 0x020U, 0x00CU, 0x080U, 0x100U, 0xC40U, 0x080U, 0x080U, 0x020U, 0x080U,
+    0x480U, 0x804U, 0x100U, 0x010U, 0x200U, 0x148U, 0x020U, 0x403U, 0x100U, 0x022U, 0x100U, 0x100U, 0x811U, 0x080U, 0x100U, 0x204U,
+    0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x000U, 0x210U, 0x000U, 0x000U, 0x000U, 0x004U, 0x000U, 0x980U, 0x421U, 0x002U,
+    0x000U, 0x000U, 0x000U, 0x488U, 0x000U, 0x001U, 0x140U, 0x002U, 0x000U, 0x070U, 0x800U, 0x002U, 0x20CU, 0x002U, 0x002U, 0x002U,
+    0x000U, 0x000U, 0x000U, 0x122U, 0x000U, 0x001U, 0x084U, 0xC00U, 0x000U, 0x600U, 0x800U, 0x091U, 0x012U, 0x024U, 0x300U, 0x048U,
+    0x000U, 0x001U, 0x800U, 0x244U, 0x001U, 0x001U, 0x038U, 0x001U, 0x800U, 0x108U, 0x800U, 0x800U, 0x4C0U, 0x001U, 0x800U, 0x002U,
+    0x000U, 0x000U, 0x000U, 0x004U, 0x000U, 0x001U, 0x80AU, 0x0E0U, 0x000U, 0x004U, 0x004U, 0x004U, 0x040U, 0x418U, 0x300U, 0x004U,
+    0x000U, 0x001U, 0x220U, 0x910U, 0x001U, 0x001U, 0x404U, 0x001U, 0x502U, 0x280U, 0x049U, 0x004U, 0x820U, 0x001U, 0x090U, 0x002U,
+    0x000U, 0x001U, 0x450U, 0x008U, 0x001U, 0x001U, 0x300U, 0x001U, 0x0A8U, 0x842U, 0x300U, 0x004U, 0x300U, 0x001U, 0x300U, 0x300U,
+    0x001U, 0x001U, 0x082U, 0x001U, 0x001U, 0x001U, 0x001U, 0x001U, 0x014U, 0x001U, 0x800U, 0x420U, 0x001U, 0x001U, 0x300U, 0x001U,
+    0x000U, 0x000U, 0x000U, 0x841U, 0x000U, 0x028U, 0x084U, 0x002U, 0x000U, 0x600U, 0x118U, 0x002U, 0x040U, 0x002U, 0x002U, 0x002U,
+    0x000U, 0x104U, 0x220U, 0x002U, 0xC10U, 0x002U, 0x002U, 0x002U, 0x081U, 0x002U, 0x002U, 0x002U, 0x002U, 0x002U, 0x002U, 0x002U,
+    0x000U, 0x600U, 0x084U, 0x008U, 0x084U, 0x150U, 0x084U, 0x084U, 0x600U, 0x600U, 0x060U, 0x600U, 0x809U, 0x600U, 0x084U, 0x002U,
+    0x04AU, 0x8A0U, 0x501U, 0x010U, 0x200U, 0x001U, 0x084U, 0x002U, 0x014U, 0x600U, 0x800U, 0x002U, 0x120U, 0x002U, 0x002U, 0x002U,
+    0x000U, 0x092U, 0x220U, 0x008U, 0x040U, 0xA04U, 0x011U, 0x500U, 0x040U, 0x121U, 0xC80U, 0x004U, 0x040U, 0x040U, 0x040U, 0x002U,
+    0x220U, 0x440U, 0x220U, 0x220U, 0x188U, 0x001U, 0x220U, 0x002U, 0x014U, 0x808U, 0x220U, 0x002U, 0x040U, 0x002U, 0x002U, 0x002U,
+    0x900U, 0x008U, 0x008U, 0x008U, 0x422U, 0x001U, 0x084U, 0x008U, 0x014U, 0x600U, 0x003U, 0x008U, 0x040U, 0x080U, 0x300U, 0x830U,
+    0x014U, 0x001U, 0x220U, 0x008U, 0x001U, 0x001U, 0x840U, 0x001U, 0x014U, 0x014U, 0x014U, 0x1C0U, 0x014U, 0x001U, 0x408U, 0x002U,
+    0x000U, 0x000U, 0x000U, 0x004U, 0x000U, 0x028U, 0x140U, 0xC00U, 0x000U, 0x004U, 0x004U, 0x004U, 0x012U, 0x241U, 0x088U, 0x004U,
+    0x000U, 0xA02U, 0x140U, 0x021U, 0x140U, 0x094U, 0x140U, 0x140U, 0x081U, 0x108U, 0x610U, 0x004U, 0x820U, 0x400U, 0x140U, 0x002U,
+    0x000U, 0x0C0U, 0x209U, 0xC00U, 0x012U, 0xC00U, 0xC00U, 0xC00U, 0x012U, 0x108U, 0x060U, 0x004U, 0x012U, 0x012U, 0x012U, 0xC00U,
+    0x424U, 0x108U, 0x082U, 0x010U, 0x200U, 0x001U, 0x140U, 0xC00U, 0x108U, 0x108U, 0x800U, 0x108U, 0x012U, 0x108U, 0x005U, 0x2A0U,
+    0x000U, 0x004U, 0x004U, 0x004U, 0x680U, 0x102U, 0x011U, 0x004U, 0x004U, 0x004U, 0x004U, 0x004U, 0x820U, 0x004U, 0x004U, 0x004U,
+    0x018U, 0x440U, 0x082U, 0x004U, 0x820U, 0x001U, 0x140U, 0x208U, 0x820U, 0x004U, 0x004U, 0x004U, 0x820U, 0x820U, 0x820U, 0x004U,
+    0x900U, 0x230U, 0x082U, 0x004U, 0x04CU, 0x001U, 0x020U, 0xC00U, 0x401U, 0x004U, 0x004U, 0x004U, 0x012U, 0x080U, 0x300U, 0x004U,
+    0x082U, 0x001U, 0x082U, 0x082U, 0x001U, 0x001U, 0x082U, 0x001U, 0x240U, 0x108U, 0x082U, 0x004U, 0x820U, 0x001U, 0x408U, 0x050U,
+    0x000U, 0x028U, 0x402U, 0x380U, 0x028U, 0x028U, 0x011U, 0x028U, 0x081U, 0x810U, 0x060U, 0x004U, 0x504U, 0x028U, 0xA00U, 0x002U,
+    0x081U, 0x440U, 0x80CU, 0x010U, 0x200U, 0x028U, 0x140U, 0x002U, 0x081U, 0x081U, 0x081U, 0x002U, 0x081U, 0x002U, 0x002U, 0x002U,
+    0x900U, 0x007U, 0x060U, 0x010U, 0x200U, 0x028U, 0x084U, 0xC00U, 0x060U, 0x600U, 0x060U, 0x060U, 0x012U, 0x080U, 0x060U, 0x101U,
+    0x200U, 0x010U, 0x010U, 0x010U, 0x200U, 0x200U, 0x200U, 0x010U, 0x081U, 0x108U, 0x060U, 0x010U, 0x200U, 0x844U, 0x408U, 0x002U,
+    0x900U, 0x440U, 0x011U, 0x004U, 0x011U, 0x028U, 0x011U, 0x011U, 0x20AU, 0x004U, 0x004U, 0x004U, 0x040U, 0x080U, 0x011U, 0x004U,
+    0x440U, 0x440U, 0x220U, 0x440U, 0x006U, 0x440U, 0x011U, 0x880U, 0x081U, 0x440U, 0x100U, 0x004U, 0x820U, 0x310U, 0x408U, 0x002U,
+    0x900U, 0x900U, 0x900U, 0x008U, 0x900U, 0x080U, 0x011U, 0x242U, 0x900U, 0x080U, 0x060U, 0x004U, 0x080U, 0x080U, 0x408U, 0x080U,
+    0x900U, 0x440U, 0x082U, 0x010U, 0x200U, 0x001U, 0x408U, 0x124U, 0x014U, 0x022U, 0x408U, 0xA01U, 0x408U, 0x080U, 0x408U, 0x408U,
+    0x000U, 0x000U, 0x000U, 0x210U, 0x000U, 0x210U, 0x210U, 0x210U, 0x000U, 0x00BU, 0x800U, 0x540U, 0x040U, 0x024U, 0x088U, 0x210U,
+    0x000U, 0x104U, 0x800U, 0x021U, 0x0A2U, 0x848U, 0x404U, 0x210U, 0x800U, 0x280U, 0x800U, 0x800U, 0x111U, 0x400U, 0x800U, 0x002U,
+    0x000U, 0x0C0U, 0x800U, 0x008U, 0x508U, 0x024U, 0x043U, 0x210U, 0x800U, 0x024U, 0x800U, 0x800U, 0x024U, 0x024U, 0x800U, 0x024U,
+    0x800U, 0x412U, 0x800U, 0x800U, 0x200U, 0x001U, 0x800U, 0x180U, 0x800U, 0x800U, 0x800U, 0x800U, 0x800U, 0x024U, 0x800U, 0x800U,
+    0x000U, 0xC20U, 0x181U, 0x008U, 0x040U, 0x102U, 0x404U, 0x210U, 0x040U, 0x280U, 0x032U, 0x004U, 0x040U, 0x040U, 0x040U, 0x801U,
+    0x018U, 0x280U, 0x404U, 0x042U, 0x404U, 0x001U, 0x404U, 0x404U, 0x280U, 0x280U, 0x800U, 0x280U, 0x040U, 0x280U, 0x404U, 0x128U,
+    0x206U, 0x008U, 0x008U, 0x008U, 0x890U, 0x001U, 0x020U, 0x008U, 0x401U, 0x110U, 0x800U, 0x008U, 0x040U, 0x024U, 0x300U, 0x482U,
+    0x160U, 0x001U, 0x800U, 0x008U, 0x001U, 0x001U, 0x404U, 0x001U, 0x800U, 0x280U, 0x800U, 0x800U, 0x00AU, 0x001U, 0x800U, 0x050U,
+    0x000U, 0x104U, 0x402U, 0x008U, 0x040U, 0x481U, 0x920U, 0x210U, 0x040U, 0x810U, 0x205U, 0x0A0U, 0x040U, 0x040U, 0x040U, 0x002U,
+    0x104U, 0x104U, 0x0D0U, 0x104U, 0x200U, 0x104U, 0x009U, 0x002U, 0x428U, 0x104U, 0x800U, 0x002U, 0x040U, 0x002U, 0x002U, 0x002U,
+    0x031U, 0x008U, 0x008U, 0x008U, 0x200U, 0x802U, 0x084U, 0x008U, 0x182U, 0x600U, 0x800U, 0x008U, 0x040U, 0x024U, 0x410U, 0x101U,
+    0x200U, 0x104U, 0x800U, 0x008U, 0x200U, 0x200U, 0x200U, 0x460U, 0x800U, 0x041U, 0x800U, 0x800U, 0x200U, 0x098U, 0x800U, 0x002U,
+    0x040U, 0x008U, 0x008U, 0x008U, 0x040U, 0x040U, 0x040U, 0x008U, 0x040U, 0x040U, 0x040U, 0x008U, 0x040U, 0x040U, 0x040U, 0x040U,
+    0x803U, 0x104U, 0x220U, 0x008U, 0x040U, 0x030U, 0x404U, 0x880U, 0x040U, 0x280U, 0x100U, 0x411U, 0x040U, 0x040U, 0x040U, 0x002U,
+    0x008U, 0x008U, 0x008U, 0x008U, 0x040U, 0x008U, 0x008U, 0x008U, 0x040U, 0x008U, 0x008U, 0x008U, 0x040U, 0x040U, 0x040U, 0x008U,
+    0x480U, 0x008U, 0x008U, 0x008U, 0x200U, 0x001U, 0x112U, 0x008U, 0x014U, 0x022U, 0x800U, 0x008U, 0x040U, 0xD00U, 0x0A1U, 0x204U,
+    0x000U, 0x0C0U, 0x402U, 0x021U, 0x805U, 0x102U, 0x088U, 0x210U, 0x320U, 0x810U, 0x088U, 0x004U, 0x088U, 0x400U, 0x088U, 0x088U,
+    0x018U, 0x021U, 0x021U, 0x021U, 0x200U, 0x400U, 0x140U, 0x021U, 0x046U, 0x400U, 0x800U, 0x021U, 0x400U, 0x400U, 0x088U, 0x400U,
+    0x0C0U, 0x0C0U, 0x114U, 0x0C0U, 0x200U, 0x0C0U, 0x020U, 0xC00U, 0x401U, 0x0C0U, 0x800U, 0x202U, 0x012U, 0x024U, 0x088U, 0x101U,
+    0x200U, 0x0C0U, 0x800U, 0x021U, 0x200U, 0x200U, 0x200U, 0x00EU, 0x800U, 0x108U, 0x800U, 0x800U, 0x200U, 0x400U, 0x800U, 0x050U,
+    0x018U, 0x102U, 0xA40U, 0x004U, 0x102U, 0x102U, 0x020U, 0x102U, 0x401U, 0x004U, 0x004U, 0x004U, 0x040U, 0x102U, 0x088U, 0x004U,
+    0x018U, 0x018U, 0x018U, 0x021U, 0x018U, 0x102U, 0x404U, 0x880U, 0x018U, 0x280U, 0x100U, 0x004U, 0x820U, 0x400U, 0x203U, 0x050U,
+    0x401U, 0x0C0U, 0x020U, 0x008U, 0x020U, 0x102U, 0x020U, 0x020U, 0x401U, 0x401U, 0x401U, 0x004U, 0x401U, 0xA08U, 0x020U, 0x050U,
+    0x018U, 0x804U, 0x082U, 0x700U, 0x200U, 0x001U, 0x020U, 0x050U, 0x401U, 0x022U, 0x800U, 0x050U, 0x184U, 0x050U, 0x050U, 0x050U,
+    0x402U, 0x810U, 0x402U, 0x402U, 0x200U, 0x028U, 0x402U, 0x044U, 0x810U, 0x810U, 0x402U, 0x810U, 0x040U, 0x810U, 0x088U, 0x101U,
+    0x200U, 0x104U, 0x402U, 0x021U, 0x200U, 0x200U, 0x200U, 0x880U, 0x081U, 0x810U, 0x100U, 0x248U, 0x200U, 0x400U, 0x034U, 0x002U,
+    0x200U, 0x0C0U, 0x402U, 0x008U, 0x200U, 0x200U, 0x200U, 0x101U, 0x00CU, 0x810U, 0x060U, 0x101U, 0x200U, 0x101U, 0x101U, 0x101U,
+    0x200U, 0x200U, 0x200U, 0x010U, 0x200U, 0x200U, 0x200U, 0x200U, 0x200U, 0x022U, 0x800U, 0x484U, 0x200U, 0x200U, 0x200U, 0x101U,
+    0x0A4U, 0x201U, 0x402U, 0x008U, 0x040U, 0x102U, 0x011U, 0x880U, 0x040U, 0x810U, 0x100U, 0x004U, 0x040U, 0x040U, 0x040U, 0x620U,
+    0x018U, 0x440U, 0x100U, 0x880U, 0x200U, 0x880U, 0x880U, 0x880U, 0x100U, 0x022U, 0x100U, 0x100U, 0x040U, 0x00DU, 0x100U, 0x880U,
+    0x900U, 0x008U, 0x008U, 0x008U, 0x200U, 0x414U, 0x020U, 0x008U, 0x401U, 0x022U, 0x290U, 0x008U, 0x040U, 0x080U, 0x806U, 0x101U,
+    0x200U, 0x022U, 0x045U, 0x008U, 0x200U, 0x200U, 0x200U, 0x880U, 0x022U, 0x022U, 0x100U, 0x022U, 0x200U, 0x022U, 0x408U, 0x050U };
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Encodes 12 data bits as a (23,12) codeword. */
+
+uint32_t Golay24128::encode23127(uint32_t data)
+{
+    data &= 0xFFFU;
+    return (data << 11) | getParity(data);
+}
+
+/* Encodes 12 data bits as a (24,12) codeword. */
+
+uint32_t Golay24128::encode24128(uint32_t data)
+{
+    uint32_t code = encode23127(data);
+    return (code << 1) | (countBits32(code) & 0x01U);
+}
+
+/* Decodes a (23,12) codeword, correcting up to 3 bit errors. */
+
+uint32_t Golay24128::decode23127(uint32_t code, uint8_t& errs)
+{
+    uint32_t data = (code >> 11) & 0xFFFU;
+    uint32_t syndrome = (code ^ getParity(data)) & 0x7FFU;
+    if (syndrome == 0U) {
+        errs = 0U;
+        return data;
+    }
+
+    uint32_t dataError = DATA_ERROR_TABLE_23127[syndrome];
+    uint32_t parityError = syndrome ^ getParity(dataError);
+
+    errs = countBits16(uint16_t(dataError)) + countBits16(uint16_t(parityError));
+    return data ^ dataError;
+}
+
+/* Decodes a (24,12) codeword, correcting up to 3 bit errors. */
+
+uint32_t Golay24128::decode24128(uint32_t code, uint8_t& errs)
+{
+    uint32_t data = decode23127((code >> 1) & 0x7FFFFFU, errs);
+    if (errs != 0U || (countBits32(code & 0xFFFFFFU) & 0x01U) != 0U)
+        errs = countBits32((encode24128(data) ^ code) & 0xFFFFFFU);
+
+    return data;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Gets the 11 parity bits for 12 data bits. */
+
+uint32_t Golay24128::getParity(uint32_t data)
+{
+    return PARITY_TABLE_HI_23127[(data >> 6) & 0x3FU] ^ PARITY_TABLE_LO_23127[data & 0x3FU];
+}
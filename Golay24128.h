@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file Golay24128.h
+ * @ingroup hotspot_fw
+ * @file Golay24128.cpp
+ * @ingroup hotspot_fw
+ */
+#if !defined(__GOLAY24128_H__)
+#define __GOLAY24128_H__
+
+#include "Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements the Golay (23,12,7) and extended Golay (24,12,8) codes used to protect
+ *  the most significant vocoder bits.
+ * @ingroup hotspot_fw
+ */
+class DSP_FW_API Golay24128 {
+public:
+    /**
+     * @brief Encodes 12 data bits as a (23,12) codeword.
+     * @param data 12 data bits.
+     * @returns uint32_t 23 bit codeword; data in the upper 12 bits, parity in the lower 11 bits.
+     */
+    static uint32_t encode23127(uint32_t data);
+    /**
+     * @brief Encodes 12 data bits as a (24,12) codeword.
+     * @param data 12 data bits.
+     * @returns uint32_t 24 bit codeword; the (23,12) codeword followed by an even parity bit.
+     */
+    static uint32_t encode24128(uint32_t data);
+
+    /**
+     * @brief Decodes a (23,12) codeword, correcting up to 3 bit errors.
+     * @param code Received 23 bit codeword.
+     * @param[out] errs Count of bits corrected.
+     * @returns uint32_t 12 data bits.
+     */
+    static uint32_t decode23127(uint32_t code, uint8_t& errs);
+    /**
+     * @brief Decodes a (24,12) codeword, correcting up to 3 bit errors.
+     * @param code Received 24 bit codeword.
+     * @param[out] errs Count of bits that differ from the corrected codeword (including the parity bit).
+     * @returns uint32_t 12 data bits.
+     */
+    static uint32_t decode24128(uint32_t code, uint8_t& errs);
+
+private:
+    /**
+     * @brief Gets the 11 parity bits for 12 data bits.
+     * @param data 12 data bits.
+     * @returns uint32_t 11 parity bits.
+     */
+    static uint32_t getParity(uint32_t data);
+};
+
+#endif // __GOLAY24128_H__
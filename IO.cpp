@@ -24,9 +24,12 @@ IO::IO():
     m_started(false),
     m_rxBuffer(1024U),
     m_txBuffer(1024U),
+    m_rxPeak(0U),
     m_ledCount(0U),
     m_ledValue(true),
     m_watchdog(0U),
+    m_clock(0U),
+    m_rxClock(0U),
     m_int1Counter(0U),
     m_int2Counter(0U),
     m_rxFrequency(DEFAULT_FREQUENCY),
@@ -82,8 +85,7 @@ void IO::start()
 
 void IO::process()
 {
-    uint8_t bit;
-    uint8_t control;
+    PROFILE_SCOPE(PROBE_IO_PROCESS);
 
     m_ledCount++;
     if (m_started) {
@@ -126,31 +128,73 @@ void IO::process()
         setRX(false);
     }
 
-    if (m_rxBuffer.getData() >= 1U) {
-        m_rxBuffer.get(bit, control);
+    // the backlog is read between two reads of the clock, so an interrupt putting (and counting) a bit in
+    // between can't skew the clock of the oldest bit waiting
+    uint32_t clock;
+    uint16_t count;
+    do {
+        clock = m_clock;
+        count = m_rxBuffer.getData();
+    } while (clock != m_clock);
 
-        if (m_modemState == STATE_DMR) {
-            /** Digital Mobile Radio */
+    if (count == 0U)
+        return;
+
+    if (count > m_rxPeak)
+        m_rxPeak = count;
+
+    // the bits waiting were received in the bit periods just counted, so this is the bit clock the bit
+    // before the oldest was received at
+    m_rxClock = clock - count;
+
+    // drain the pending bits, up to the batch budget, so a slow superloop pass (serial traffic,
+    // transmitter processing) doesn't leave the interrupt handler to overflow the ring buffer
+    if (count > RX_BATCH_BITS)
+        count = RX_BATCH_BITS;
+
+    while (count > 0U) {
+        uint8_t n = (count > 32U) ? 32U : uint8_t(count);
+        count -= n;
+
+        // only the duplex DMR receiver follows the slot control level
+        uint32_t bits = 0U;
 #if defined(DUPLEX)
-            if (m_duplex && !m_forceDMO) {
-                if (m_tx)
-                    dmrRX.databit(bit, control);
+        uint32_t control = 0U;
+        if (m_modemState == STATE_DMR && m_duplex && !m_forceDMO && m_tx)
+            m_rxBuffer.getBits(bits, control, n);
+        else
+            m_rxBuffer.getBits(bits, n);
+#else
+        m_rxBuffer.getBits(bits, n);
+#endif
+
+        for (uint32_t mask = 1U << (n - 1U); mask != 0U; mask >>= 1) {
+            uint8_t bit = (bits & mask) ? 1U : 0U;
+            m_rxClock++;
+
+            if (m_modemState == STATE_DMR) {
+                /** Digital Mobile Radio */
+#if defined(DUPLEX)
+                if (m_duplex && !m_forceDMO) {
+                    if (m_tx)
+                        dmrRX.databit(bit, (control & mask) ? 1U : 0U);
+                    else
+                        dmrIdleRX.databit(bit);
+                }
                 else
-                    dmrIdleRX.databit(bit);
-            }
-            else
-                dmrDMORX.databit(bit);
+                    dmrDMORX.databit(bit);
 #else
-            dmrDMORX.databit(bit);
+                dmrDMORX.databit(bit);
 #endif
-        }
-        else if (m_modemState == STATE_P25) {
-            /** Project 25 */
-            p25RX.databit(bit);
-        }
-        else if (m_modemState == STATE_NXDN) {
-            /** Next Generation Digital Narrowband */
-            nxdnRX.databit(bit);
+            }
+            else if (m_modemState == STATE_P25) {
+                /** Project 25 */
+                p25RX.databit(bit);
+            }
+            else if (m_modemState == STATE_NXDN) {
+                /** Next Generation Digital Narrowband */
+                nxdnRX.databit(bit);
+            }
         }
     }
 }
@@ -162,11 +206,21 @@ void IO::write(uint8_t* data, uint16_t length, const uint8_t* control)
     if (!m_started)
         return;
 
-    for (uint16_t i = 0U; i < length; i++) {
-        if (control == NULL)
-            m_txBuffer.put(data[i], MARK_NONE);
-        else
-            m_txBuffer.put(data[i], control[i]);
+    // pack the bits into words for the ring buffer
+    uint16_t i = 0U;
+    while (i < length) {
+        uint16_t left = length - i;
+        uint8_t n = (left > 32U) ? 32U : uint8_t(left);
+        bool fits = m_txBuffer.getSpace() >= n;
+
+        uint32_t bits = 0U;
+        for (uint8_t j = 0U; j < n; j++, i++) {
+            bits = (bits << 1) | (data[i] ? 1U : 0U);
+            if (control != NULL && fits)
+                m_txBuffer.putMark((control[i] != MARK_NONE) ? 1U : 0U, j);
+        }
+
+        m_txBuffer.putBits(bits, n);
     }
 
     // switch the transmitter on if needed
@@ -176,6 +230,56 @@ void IO::write(uint8_t* data, uint16_t length, const uint8_t* control)
     }
 }
 
+/* Write packed bytes to air interface. */
+
+void IO::writeBytes(const uint8_t* data, uint16_t length, const uint8_t* marks)
+{
+    if (!m_started)
+        return;
+
+    // move up to four bytes into the ring buffer at a time
+    uint16_t i = 0U;
+    while (i < length) {
+        uint16_t left = length - i;
+        uint8_t n = (left > 4U) ? 4U : uint8_t(left);
+
+        bool fits = m_txBuffer.getSpace() >= n * 8U;
+
+        uint32_t bits = 0U;
+        for (uint8_t j = 0U; j < n; j++, i++) {
+            bits = (bits << 8) | data[i];
+
+            // a slot marked byte switches the control level on its last bit
+            if (marks != NULL && marks[i] != MARK_NONE && fits)
+                m_txBuffer.putMark((marks[i] == MARK_SLOT2) ? 1U : 0U, j * 8U + 7U);
+        }
+
+        m_txBuffer.putBits(bits, n * 8U);
+    }
+
+    // switch the transmitter on if needed
+    if (!m_tx) {
+        setTX();
+        m_tx = true;
+    }
+}
+
+/* Write a burst of bits to air interface. */
+
+void IO::writeBits(uint32_t bits, uint8_t length)
+{
+    if (!m_started)
+        return;
+
+    m_txBuffer.putBits(bits, length);
+
+    // switch the transmitter on if needed
+    if (!m_tx) {
+        setTX();
+        m_tx = true;
+    }
+}
+
 /* Helper to get how much space the transmit ring buffer has for samples. */
 
 uint16_t IO::getSpace() const
@@ -287,6 +391,53 @@ bool IO::hasRXOverflow()
     return m_rxBuffer.hasOverflowed();
 }
 
+/* Gets the peak RX ring buffer backlog, in bits, since the last call. */
+
+uint16_t IO::getRXPeak()
+{
+    uint16_t peak = m_rxPeak;
+    m_rxPeak = 0U;
+
+    return peak;
+}
+
+/* Helper to get the bit clock of the first bit of a received frame, as 4 bytes (MSB first). */
+
+void IO::getRXTimestamp(uint16_t bits, uint8_t* timestamp) const
+{
+    uint32_t clock = m_rxClock - (bits - 1U);
+
+    timestamp[0U] = (clock >> 24) & 0xFFU;
+    timestamp[1U] = (clock >> 16) & 0xFFU;
+    timestamp[2U] = (clock >> 8) & 0xFFU;
+    timestamp[3U] = (clock >> 0) & 0xFFU;
+}
+
+/* Gets the bit clock the next bit written to the transmit ring buffer goes out at. */
+
+uint32_t IO::getTXClock() const
+{
+    // as with the receive backlog, the backlog is read between two reads of the clock
+    uint32_t clock;
+    uint16_t count;
+    do {
+        clock = m_clock;
+        count = m_txBuffer.getData();
+    } while (clock != m_clock);
+
+    // the clock counts rising edges and a bit is sent on the falling edge after, so the bits waiting go out
+    // in the bit periods after this one (a pass run between the two edges sends them a bit period earlier)
+    return clock + count + 1U;
+}
+
+/* Gets the rate of the air interface bit clock for the current modem state. */
+
+uint32_t IO::getClockRate() const
+{
+    // 4FSK carries 2 bits a symbol; NXDN runs at 2400 baud, DMR and P25 at 4800 baud
+    return (m_modemState == STATE_NXDN) ? 4800U : 9600U;
+}
+
 /* */
 
 void IO::resetWatchdog()
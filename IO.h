@@ -17,6 +17,8 @@
  * @ingroup hotspot_fw
  * @file IOSTM.cpp
  * @ingroup hotspot_fw
+ * @file IOHost.cpp
+ * @ingroup hotspot_fw
  * @file ADF7021.cpp
  * @ingroup hotspot_fw
  */
@@ -73,6 +75,7 @@ public:
 
     /**
      * @brief Process bits from air interface.
+     * @details All pending received bits, up to RX_BATCH_BITS, are dispatched to the active receiver per pass.
      */
     void process();
 
@@ -80,9 +83,23 @@ public:
      * @brief Write bits to air interface.
      * @param data Data to write.
      * @param length Length of data buffer.
-     * @param control 
+     * @param control Slot control marks for each bit; NULL for none.
      */
     void write(uint8_t* data, uint16_t length, const uint8_t* control = NULL);
+    /**
+     * @brief Write packed bytes to air interface.
+     * @param data Data to write (packed, MSB first).
+     * @param length Length of data buffer in bytes.
+     * @param marks Slot control mark for each byte (MARK_SLOT1/MARK_SLOT2 switch the control level on
+     *  the last bit of the byte); NULL for none.
+     */
+    void writeBytes(const uint8_t* data, uint16_t length, const uint8_t* marks = NULL);
+    /**
+     * @brief Write a burst of bits to air interface.
+     * @param bits Bits to write; the length least significant bits, most significant first.
+     * @param length Number of bits (1 to 32).
+     */
+    void writeBits(uint32_t bits, uint8_t length);
 
     /**
      * @brief Helper to get how much space the transmit ring buffer has for samples.
@@ -172,6 +189,72 @@ public:
      * @returns bool Flag indicating the RX ring buffer has overflowed.
      */
     bool hasRXOverflow(void);
+    /**
+     * @brief Gets the number of bits dropped because the TX ring buffer was full.
+     * @returns uint32_t Monotonically increasing count of dropped bits.
+     */
+    uint32_t getTXDropped(void) const { return m_txBuffer.getDropped(); }
+    /**
+     * @brief Gets the number of bits dropped because the RX ring buffer was full.
+     * @returns uint32_t Monotonically increasing count of dropped bits.
+     */
+    uint32_t getRXDropped(void) const { return m_rxBuffer.getDropped(); }
+    /**
+     * @brief Gets the number of control level changes refused because the TX ring buffer's mark queue was full.
+     * @returns uint32_t Monotonically increasing count of refused control level changes.
+     */
+    uint32_t getTXMarksDropped(void) const { return m_txBuffer.getMarksDropped(); }
+    /**
+     * @brief Gets the number of control level changes refused because the RX ring buffer's mark queue was full.
+     * @returns uint32_t Monotonically increasing count of refused control level changes.
+     */
+    uint32_t getRXMarksDropped(void) const { return m_rxBuffer.getMarksDropped(); }
+    /**
+     * @brief Gets the peak RX ring buffer backlog since the last call.
+     * @returns uint16_t Peak number of bits waiting in the RX ring buffer at the start of a IO::process() pass.
+     */
+    uint16_t getRXPeak(void);
+#if defined(HOST_SIM)
+    /**
+     * @brief Helper to write a bit straight into the RX ring buffer, bypassing the air interface.
+     * @param bit Bit to write.
+     * @param control Slot control mark for the bit.
+     * @returns bool True, if the bit was written, otherwise false if the RX ring buffer is full.
+     */
+    bool injectRX(uint8_t bit, uint8_t control);
+    /**
+     * @brief Helper to get how much space the RX ring buffer has for bits.
+     * @returns uint16_t Amount of space in the RX ring buffer for bits.
+     */
+    uint16_t getRXSpace(void) const;
+#endif
+
+    /**
+     * @brief Gets the air interface bit clock, which counts every bit period whether receiving or transmitting.
+     * @returns uint32_t Free running count of bit periods.
+     */
+    uint32_t getClock(void) const { return m_clock; }
+    /**
+     * @brief Gets the rate of the air interface bit clock for the current modem state.
+     * @returns uint32_t Bit periods per second.
+     */
+    uint32_t getClockRate(void) const;
+    /**
+     * @brief Gets the bit clock of the received bit being handed to the receivers.
+     * @returns uint32_t Bit clock the bit was received at.
+     */
+    uint32_t getRXClock(void) const { return m_rxClock; }
+    /**
+     * @brief Helper to get the bit clock of the first bit of a received frame, as 4 bytes (MSB first).
+     * @param bits Number of bits of the frame received, up to and including the bit being handed to the receivers.
+     * @param[out] timestamp Buffer for the bit clock.
+     */
+    void getRXTimestamp(uint16_t bits, uint8_t* timestamp) const;
+    /**
+     * @brief Gets the bit clock the next bit written to the transmit ring buffer goes out at.
+     * @returns uint32_t Bit clock the next bit written is transmitted at.
+     */
+    uint32_t getTXClock(void) const;
 
     /**
      * @brief 
@@ -290,11 +373,14 @@ private:
 
     BitBuffer m_rxBuffer;
     BitBuffer m_txBuffer;
+    uint16_t m_rxPeak;
 
     uint32_t m_ledCount;
     bool m_ledValue;
 
     volatile uint32_t m_watchdog;
+    volatile uint32_t m_clock;
+    uint32_t m_rxClock;
 
     volatile uint16_t m_int1Counter;
     volatile uint16_t m_int2Counter;
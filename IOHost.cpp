@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "IO.h"
+
+#if defined(HOST_SIM)
+#include "host/HostSim.h"
+
+/*
+    The host simulator replaces the STM32 GPIO/EXTI backend; the ADF7021
+    control pins are no-ops, the symbol clock, RXD and TXD pins are provided
+    by the simulated air interface (see host/HostSim.cpp).
+*/
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Gets the CPU type the firmware is running on. */
+
+uint8_t IO::getCPU() const
+{
+    return CPU_TYPE_STM32;
+}
+
+/* Gets the unique identifier for the air interface. */
+
+void IO::getUDID(uint8_t* buffer)
+{
+    for (uint8_t i = 0U; i < 12U; i++)
+        buffer[i] = 0xA0U + i;
+}
+
+/* */
+
+void IO::resetMCU()
+{
+    DEBUG1("reset - bye-bye");
+
+    hostSim.requestReset();
+}
+
+/* Helper to write a bit straight into the RX ring buffer, bypassing the air interface. */
+
+bool IO::injectRX(uint8_t bit, uint8_t control)
+{
+    // the injected bit stands in for one received from the air, so it takes a bit period
+    m_clock++;
+    return m_rxBuffer.put(bit, control);
+}
+
+/* Helper to get how much space the RX ring buffer has for bits. */
+
+uint16_t IO::getRXSpace() const
+{
+    return m_rxBuffer.getSpace();
+}
+
+/* */
+
+void IO::delayBit()
+{
+    /* stub */
+}
+
+#if defined(ZUMSPOT_ADF7021) || defined(SKYBRIDGE_HS)
+/* */
+
+bool IO::isDualBand()
+{
+    return false;
+}
+#endif
+
+/* */
+
+void IO::SCLK(bool on)
+{
+    /* stub */
+}
+
+/* */
+
+void IO::SDATA(bool on)
+{
+    /* stub */
+}
+
+/* */
+
+bool IO::SREAD()
+{
+    return false;
+}
+
+/* */
+
+void IO::SLE1(bool on)
+{
+    /* stub */
+}
+
+#if defined(DUPLEX)
+/* */
+
+void IO::SLE2(bool on)
+{
+    /* stub */
+}
+
+/* */
+
+bool IO::RXD2()
+{
+    return hostSim.getRXD();
+}
+#endif
+
+/* */
+
+void IO::CE(bool on)
+{
+    /* stub */
+}
+
+/* */
+
+bool IO::RXD1()
+{
+    return hostSim.getRXD();
+}
+
+/* */
+
+bool IO::CLK()
+{
+    // polling the clock pin outside of the interrupt handler (i.e. busy waiting
+    // for a clock edge) lets the virtual symbol clock advance
+    if (m_started && !hostSim.inInterrupt())
+        hostSim.clockEdge();
+
+    return hostSim.getCLK();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+#if defined(ZUMSPOT_ADF7021) || defined(SKYBRIDGE_HS)
+/* */
+
+void IO::setBandVHF(bool enable)
+{
+    /* stub */
+}
+
+/* */
+
+bool IO::hasSingleADF7021()
+{
+    return true;
+}
+#endif
+
+/* */
+
+void IO::delayIfCal()
+{
+    /* stub */
+}
+
+/* */
+
+void IO::delayReset()
+{
+    /* stub */
+}
+
+/* */
+
+void IO::delayUS(uint32_t us)
+{
+    /* stub */
+}
+
+/* Initializes hardware interrupts. */
+
+void IO::initInt()
+{
+    hostSim.reset();
+}
+
+/* Starts hardware interrupts. */
+
+void IO::startInt()
+{
+    /* stub */
+}
+
+#if defined(BIDIR_DATA_PIN)
+/* */
+
+void IO::setDataDirOut(bool dir)
+{
+    /* stub */
+}
+
+/* */
+
+void IO::setRXDInt(bool on)
+{
+    hostSim.setTXD(on);
+}
+#endif
+
+/* */
+
+void IO::setTXDInt(bool on)
+{
+#if !defined(BIDIR_DATA_PIN)
+    hostSim.setTXD(on);
+#endif
+}
+
+/* */
+
+void IO::setLEDInt(bool on)
+{
+    /* stub */
+}
+
+/* */
+
+void IO::setPTTInt(bool on)
+{
+    hostSim.setPTT(on);
+}
+
+/* */
+
+void IO::setCOSInt(bool on)
+{
+    /* stub */
+}
+
+/* */
+
+void IO::setDMRInt(bool on)
+{
+    /* stub */
+}
+
+/* */
+
+void IO::setP25Int(bool on)
+{
+    /* stub */
+}
+
+/* */
+
+void IO::setNXDNInt(bool on)
+{
+    /* stub */
+}
+
+#endif // HOST_SIM
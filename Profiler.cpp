@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "Profiler.h"
+
+#if defined(ENABLE_PROFILER)
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the Profiler class. */
+
+Profiler::Profiler() :
+    m_count(),
+    m_min(),
+    m_max(),
+    m_total(),
+    m_histogram()
+{
+    reset();
+}
+
+/* Initializes and starts the profiler clock. */
+
+void Profiler::init()
+{
+#if !defined(HOST_SIM)
+    // enable the trace block and start the DWT cycle counter
+    PROFILER_DEMCR |= PROFILER_DEMCR_TRCENA;
+#if defined(STM32F7XX)
+    PROFILER_DWT_LAR = PROFILER_DWT_LAR_KEY;
+#endif
+    PROFILER_DWT_CYCCNT = 0U;
+    PROFILER_DWT_CTRL |= PROFILER_DWT_CYCCNTENA;
+#endif
+    reset();
+}
+
+/* Resets the statistics of all probes. */
+
+void Profiler::reset()
+{
+    for (uint8_t i = 0U; i < PROBE_COUNT; i++)
+        reset(PROFILER_PROBE(i));
+}
+
+/* Resets the statistics of the given probe. */
+
+void Profiler::reset(PROFILER_PROBE probe)
+{
+    m_count[probe] = 0U;
+    m_min[probe] = 0xFFFFFFFFU;
+    m_max[probe] = 0U;
+    m_total[probe] = 0U;
+    ::memset(m_histogram[probe], 0x00U, sizeof(m_histogram[probe]));
+}
+
+/* Records a duration for the given probe. */
+
+void Profiler::record(PROFILER_PROBE probe, uint32_t ticks)
+{
+    m_count[probe]++;
+    m_total[probe] += ticks;
+
+    if (ticks < m_min[probe])
+        m_min[probe] = ticks;
+    if (ticks > m_max[probe])
+        m_max[probe] = ticks;
+
+    // log2 bin; bin n holds 2^(n - 1) <= ticks < 2^n
+    uint8_t bin = (ticks == 0U) ? 0U : uint8_t(32 - __builtin_clz(ticks));
+    if (bin >= PROFILER_HISTOGRAM_BINS)
+        bin = PROFILER_HISTOGRAM_BINS - 1U;
+
+    if (m_histogram[probe][bin] < 0xFFFFU)
+        m_histogram[probe][bin]++;
+}
+
+/* Gets the mean duration recorded for the given probe. */
+
+uint32_t Profiler::getMean(PROFILER_PROBE probe) const
+{
+    if (m_count[probe] == 0U)
+        return 0U;
+
+    return uint32_t(m_total[probe] / m_count[probe]);
+}
+
+/* Gets the units of the profiler clock. */
+
+PROFILER_UNIT Profiler::getUnit() const
+{
+#if defined(HOST_SIM)
+    return PROFILER_UNIT_NS;
+#else
+    return PROFILER_UNIT_CYCLES;
+#endif
+}
+
+/* Finalizes a instance of the ProfilerScope class. */
+
+ProfilerScope::~ProfilerScope()
+{
+    profiler.record(m_probe, Profiler::now() - m_start);
+}
+
+#endif // ENABLE_PROFILER
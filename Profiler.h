@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file Profiler.h
+ * @ingroup hotspot_fw
+ * @file Profiler.cpp
+ * @ingroup hotspot_fw
+ */
+#if !defined(__PROFILER_H__)
+#define __PROFILER_H__
+
+#if defined(STM32F10X_MD)
+#include "stm32f10x.h"
+#elif defined(STM32F4XX)
+#include "stm32f4xx.h"
+#elif defined(STM32F7XX)
+#include "stm32f7xx.h"
+#elif defined(HOST_SIM)
+#include <time.h>
+#endif
+
+#include "Defines.h"
+
+#if defined(ENABLE_PROFILER)
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup hotspot_fw
+ * @{
+ */
+
+/**
+ * @brief Hot path profiler probes.
+ */
+enum PROFILER_PROBE {
+    PROBE_IO_INTERRUPT1 = 0U,           //! IO::interrupt1()
+    PROBE_IO_INTERRUPT2,                //! IO::interrupt2()
+    PROBE_IO_PROCESS,                   //! IO::process()
+    PROBE_SERIAL_PROCESS,               //! SerialPort::process()
+
+    PROBE_DMR_RX_DATABIT,               //! DMRRX::databit()
+    PROBE_DMR_SLOT_RX_DATABIT,          //! DMRSlotRX::databit()
+    PROBE_DMR_SLOT_RX_SYNC,             //! DMRSlotRX::correlateSync()
+    PROBE_DMR_IDLE_RX_DATABIT,          //! DMRIdleRX::databit()
+    PROBE_DMR_DMO_RX_DATABIT,           //! DMRDMORX::databit()
+    PROBE_DMR_DMO_RX_SYNC,              //! DMRDMORX::correlateSync()
+    PROBE_P25_RX_DATABIT,               //! P25RX::databit()
+    PROBE_P25_RX_SYNC,                  //! P25RX::correlateSync()
+    PROBE_P25_RX_NID,                   //! P25RX::decodeNid()
+    PROBE_NXDN_RX_DATABIT,              //! NXDNRX::databit()
+    PROBE_NXDN_RX_SYNC,                 //! NXDNRX::correlateSync()
+
+    PROBE_DMR_TX_PROCESS,               //! DMRTX::process()
+    PROBE_DMR_DMO_TX_PROCESS,           //! DMRDMOTX::process()
+    PROBE_P25_TX_PROCESS,               //! P25TX::process()
+    PROBE_NXDN_TX_PROCESS,              //! NXDNTX::process()
+
+    PROBE_COUNT
+};
+
+/**
+ * @brief Units of the profiler clock.
+ */
+enum PROFILER_UNIT {
+    PROFILER_UNIT_CYCLES = 0U,          //! CPU Cycles (DWT Cycle Counter)
+    PROFILER_UNIT_NS = 1U               //! Nanoseconds (Host Monotonic Clock)
+};
+
+/** @brief Number of log2 histogram bins kept per probe. */
+const uint8_t   PROFILER_HISTOGRAM_BINS = 16U;
+
+#if !defined(HOST_SIM)
+/** @brief Cortex-M Debug Exception and Monitor Control Register. */
+#define PROFILER_DEMCR          (*(volatile uint32_t*)0xE000EDFCU)
+/** @brief Cortex-M DWT Control Register. */
+#define PROFILER_DWT_CTRL       (*(volatile uint32_t*)0xE0001000U)
+/** @brief Cortex-M DWT Cycle Count Register. */
+#define PROFILER_DWT_CYCCNT     (*(volatile uint32_t*)0xE0001004U)
+
+#define PROFILER_DEMCR_TRCENA   0x01000000U
+#define PROFILER_DWT_CYCCNTENA  0x00000001U
+#if defined(STM32F7XX)
+/** @brief Cortex-M7 DWT Lock Access Register; the DWT ignores writes until it is unlocked. */
+#define PROFILER_DWT_LAR        (*(volatile uint32_t*)0xE0001FB0U)
+#define PROFILER_DWT_LAR_KEY    0xC5ACCE55U
+#endif
+#endif // !defined(HOST_SIM)
+/** @} */
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a hot path profiler, keeping min/max/mean and a log2 histogram of the
+ *  duration of each probe.
+ * @details On the STM32 the durations are in CPU cycles taken from the DWT cycle counter, on
+ *  the host simulator they are in nanoseconds taken from the monotonic clock.
+ * @ingroup hotspot_fw
+ */
+class DSP_FW_API Profiler {
+public:
+    /**
+     * @brief Initializes a new instance of the Profiler class.
+     */
+    Profiler();
+
+    /**
+     * @brief Initializes and starts the profiler clock.
+     */
+    void init();
+
+    /**
+     * @brief Resets the statistics of all probes.
+     */
+    void reset();
+    /**
+     * @brief Resets the statistics of the given probe.
+     * @param probe Profiler probe.
+     */
+    void reset(PROFILER_PROBE probe);
+
+    /**
+     * @brief Records a duration for the given probe.
+     * @param probe Profiler probe.
+     * @param ticks Duration in profiler clock ticks.
+     */
+    void record(PROFILER_PROBE probe, uint32_t ticks);
+
+    /**
+     * @brief Gets the number of durations recorded for the given probe.
+     * @param probe Profiler probe.
+     * @returns uint32_t Number of durations recorded.
+     */
+    uint32_t getCount(PROFILER_PROBE probe) const { return m_count[probe]; }
+    /**
+     * @brief Gets the shortest duration recorded for the given probe.
+     * @param probe Profiler probe.
+     * @returns uint32_t Shortest duration in profiler clock ticks.
+     */
+    uint32_t getMin(PROFILER_PROBE probe) const { return (m_count[probe] > 0U) ? m_min[probe] : 0U; }
+    /**
+     * @brief Gets the longest duration recorded for the given probe.
+     * @param probe Profiler probe.
+     * @returns uint32_t Longest duration in profiler clock ticks.
+     */
+    uint32_t getMax(PROFILER_PROBE probe) const { return m_max[probe]; }
+    /**
+     * @brief Gets the mean duration recorded for the given probe.
+     * @param probe Profiler probe.
+     * @returns uint32_t Mean duration in profiler clock ticks.
+     */
+    uint32_t getMean(PROFILER_PROBE probe) const;
+    /**
+     * @brief Gets the number of durations recorded in the given histogram bin of the given probe.
+     * @details Bin 0 counts durations of 0 ticks, bin n counts durations of 2^(n - 1) to 2^n - 1
+     *  ticks; the last bin also counts all longer durations.
+     * @param probe Profiler probe.
+     * @param bin Histogram bin.
+     * @returns uint16_t Number of durations recorded in the histogram bin (saturates).
+     */
+    uint16_t getBin(PROFILER_PROBE probe, uint8_t bin) const { return m_histogram[probe][bin]; }
+
+    /**
+     * @brief Gets the units of the profiler clock.
+     * @returns PROFILER_UNIT Units of the profiler clock.
+     */
+    PROFILER_UNIT getUnit() const;
+
+    /**
+     * @brief Gets the current value of the profiler clock.
+     * @returns uint32_t Current value of the profiler clock.
+     */
+    static inline uint32_t now()
+    {
+#if defined(HOST_SIM)
+        struct timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return uint32_t(ts.tv_sec) * 1000000000U + uint32_t(ts.tv_nsec);
+#else
+        return PROFILER_DWT_CYCCNT;
+#endif
+    }
+
+private:
+    uint32_t m_count[PROBE_COUNT];
+    uint32_t m_min[PROBE_COUNT];
+    uint32_t m_max[PROBE_COUNT];
+    ulong64_t m_total[PROBE_COUNT];
+    uint16_t m_histogram[PROBE_COUNT][PROFILER_HISTOGRAM_BINS];
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a scoped profiler probe; the duration from construction to destruction
+ *  is recorded for the probe.
+ * @ingroup hotspot_fw
+ */
+class DSP_FW_API ProfilerScope {
+public:
+    /**
+     * @brief Initializes a new instance of the ProfilerScope class.
+     * @param probe Profiler probe.
+     */
+    ProfilerScope(PROFILER_PROBE probe) :
+        m_probe(probe),
+        m_start(Profiler::now())
+    {
+        /* stub */
+    }
+    /**
+     * @brief Finalizes a instance of the ProfilerScope class.
+     */
+    ~ProfilerScope();
+
+private:
+    PROFILER_PROBE m_probe;
+    uint32_t m_start;
+};
+
+#endif // ENABLE_PROFILER
+#endif // __PROFILER_H__
@@ -6,6 +6,7 @@
  *
  *  Copyright (c) 2020 Jonathan Naylor, G4KLX
  *  Copyright (c) 2020 Geoffrey Merck, F4FXL - KC3FRA
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 #if defined(STM32F10X_MD) || defined(STM32F4XX)
@@ -19,7 +20,11 @@
 /* Initializes a new instance of the STM_UART class. */
 
 STM_UART::STM_UART() :
-    m_usart(NULL)
+    m_usart(NULL),
+    m_rxFifo(),
+    m_txFifo(),
+    m_rxDropped(0U),
+    m_txDropped(0U)
 {
     /* stub */
 }
@@ -31,22 +36,18 @@ void STM_UART::init(USART_TypeDef* usart)
     m_usart = usart;
 }
 
-/*  */
+/* Writes as many bytes as the transmit FIFO has space for; the rest are counted as dropped. */
 
-void STM_UART::write(const uint8_t* data, uint16_t length)
+uint16_t STM_UART::write(const uint8_t* data, uint16_t length)
 {
     if (length == 0U || m_usart == NULL)
-        return;
+        return 0U;
 
-
-    m_txFifo.put(data[0]);
-    USART_ITConfig(m_usart, USART_IT_TXE, ENABLE);//switch TX IRQ is on
-
-    for (uint16_t i = 1U; i < length; i++) {
-        m_txFifo.put(data[i]);
-    }
+    uint16_t written = m_txFifo.put(data, length);
+    m_txDropped += length - written;
 
     USART_ITConfig(m_usart, USART_IT_TXE, ENABLE);//make sure TX IRQ is on
+    return written;
 }
 
 /*  */
@@ -56,6 +57,20 @@ uint8_t STM_UART::read()
     return m_rxFifo.get();
 }
 
+/* Gets the received bytes that can be read without wrapping, leaving them in the FIFO. */
+
+uint16_t STM_UART::peek(const uint8_t** data)
+{
+    return m_rxFifo.peek(data);
+}
+
+/* Discards received bytes previously returned by peek(). */
+
+void STM_UART::consume(uint16_t length)
+{
+    m_rxFifo.consume(length);
+}
+
 /*  */
 
 void STM_UART::handleIRQ()
@@ -64,8 +79,11 @@ void STM_UART::handleIRQ()
         return;
 
     if (USART_GetITStatus(m_usart, USART_IT_RXNE)) {
+        uint8_t c = (uint8_t)USART_ReceiveData(m_usart);
         if (!m_rxFifo.isFull())
-            m_rxFifo.put((uint8_t)USART_ReceiveData(m_usart));
+            m_rxFifo.put(c);
+        else
+            m_rxDropped++;
         USART_ClearITPendingBit(USART1, USART_IT_RXNE);
     }
 
@@ -96,14 +114,14 @@ void STM_UART::flush()
 
 uint16_t STM_UART::available()
 {
-    return m_rxFifo.isEmpty() ? 0U : 1U;
+    return m_rxFifo.getData();
 }
 
 /*  */
 
 uint16_t STM_UART::availableForWrite()
 {
-    return m_txFifo.isFull() ? 0U : 1U;
+    return m_txFifo.getSpace();
 }
 
 #endif
@@ -6,6 +6,7 @@
  *
  *  Copyright (c) 2020 Jonathan Naylor, G4KLX
  *  Copyright (c) 2020 Geoffrey Merck, F4FXL - KC3FRA
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -66,6 +67,51 @@ public:
     {
         m_buffer[BUFFER_MASK & (m_head++)] = data;
     }
+    /**
+     * @brief Puts as many bytes as there is space for.
+     * @param[in] data Bytes to put.
+     * @param length Number of bytes to put.
+     * @returns uint16_t Number of bytes put.
+     */
+    uint16_t put(const uint8_t* data, uint16_t length)
+    {
+        uint16_t space = getSpace();
+        if (length > space)
+            length = space;
+
+        uint16_t head = m_head;
+        for (uint16_t i = 0U; i < length; i++)
+            m_buffer[BUFFER_MASK & (head + i)] = data[i];
+
+        // publish the bytes only once they are all in the buffer
+        m_head = head + length;
+        return length;
+    }
+
+    /**
+     * @brief Gets the bytes that can be read without wrapping, leaving them in the buffer.
+     * @param[out] data Pointer to the first unread byte.
+     * @returns uint16_t Number of contiguous unread bytes.
+     */
+    uint16_t peek(const uint8_t** data)
+    {
+        uint16_t tail = m_tail & BUFFER_MASK;
+        uint16_t length = getData();
+        if (length > BUFFER_SIZE - tail)
+            length = BUFFER_SIZE - tail;
+
+        // the writer never touches unread bytes, so they may be read without the volatile qualifier
+        *data = (const uint8_t*)m_buffer + tail;
+        return length;
+    }
+    /**
+     * @brief Discards bytes previously returned by peek().
+     * @param length Number of bytes to discard.
+     */
+    void consume(uint16_t length)
+    {
+        m_tail += length;
+    }
 
     /**
      * @brief Helper to reset data values to defaults.
@@ -94,6 +140,34 @@ public:
         return ((m_head + 1U) & BUFFER_MASK) == (m_tail & BUFFER_MASK);
     }
 
+    /**
+     * @brief Helper to get how much data is in the buffer.
+     * @returns uint16_t Number of unread bytes.
+     */
+    uint16_t getData()
+    {
+        return uint16_t(m_head - m_tail) & BUFFER_MASK;
+    }
+    /**
+     * @brief Helper to get how much space the buffer has for data.
+     * @returns uint16_t Number of bytes that can be put.
+     */
+    uint16_t getSpace()
+    {
+        // one slot is kept free so a full buffer can be told from an empty one
+        return BUFFER_MASK - getData();
+    }
+    /**
+     * @brief Gets the free running count of bytes put in the buffer.
+     * @returns uint16_t Number of bytes put (wraps).
+     */
+    uint16_t getPut() const { return m_head; }
+    /**
+     * @brief Gets the free running count of bytes taken from the buffer.
+     * @returns uint16_t Number of bytes taken (wraps).
+     */
+    uint16_t getTaken() const { return m_tail; }
+
 private:
     volatile uint8_t  m_buffer[BUFFER_SIZE];
     volatile uint16_t m_head;
@@ -127,11 +201,23 @@ public:
      */
     uint8_t read();
     /**
-     * @brief 
+     * @brief Gets the received bytes that can be read without wrapping, leaving them in the FIFO.
+     * @param[out] data Pointer to the first unread byte.
+     * @returns uint16_t Number of contiguous unread bytes.
+     */
+    uint16_t peek(const uint8_t** data);
+    /**
+     * @brief Discards received bytes previously returned by peek().
+     * @param length Number of bytes to discard.
+     */
+    void consume(uint16_t length);
+    /**
+     * @brief Writes as many bytes as the transmit FIFO has space for; the rest are counted as dropped.
      * @param[in] data 
      * @param length
+     * @returns uint16_t Number of bytes accepted.
      */
-    void write(const uint8_t* data, uint16_t length);
+    uint16_t write(const uint8_t* data, uint16_t length);
 
     /**
      * @brief 
@@ -157,11 +243,35 @@ public:
      */
     uint16_t availableForWrite();
 
+    /**
+     * @brief Gets the number of received bytes dropped because the receive FIFO was full.
+     * @returns uint32_t Number of bytes dropped.
+     */
+    uint32_t getRXDropped() const { return m_rxDropped; }
+    /**
+     * @brief Gets the number of bytes refused by write() because the transmit FIFO was full.
+     * @returns uint32_t Number of bytes dropped.
+     */
+    uint32_t getTXDropped() const { return m_txDropped; }
+    /**
+     * @brief Gets the free running count of bytes written to the transmit FIFO.
+     * @returns uint16_t Number of bytes written (wraps).
+     */
+    uint16_t getTXWritten() const { return m_txFifo.getPut(); }
+    /**
+     * @brief Gets the free running count of bytes the UART has taken from the transmit FIFO.
+     * @returns uint16_t Number of bytes sent (wraps).
+     */
+    uint16_t getTXSent() const { return m_txFifo.getTaken(); }
+
 private:
     USART_TypeDef* m_usart;
     
     STM_UARTFIFO m_rxFifo;
     STM_UARTFIFO m_txFifo;
+
+    volatile uint32_t m_rxDropped;
+    uint32_t m_txDropped;
 };
 
 #endif // __SERIAL_PORT_H__
@@ -23,6 +23,8 @@
 #elif defined(STM32F4XX)
 #include "stm32f4xx.h"
 #include <cstddef>
+#elif defined(HOST_SIM)
+#include <cstddef>
 #endif
 
 #include "Defines.h"
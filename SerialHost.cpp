@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "SerialPort.h"
+
+#if defined(HOST_SIM)
+#include "host/HostSim.h"
+
+/*
+    The host simulator replaces the STM32 UARTs with in-memory byte streams;
+    only the host port (1) is connected.
+*/
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Reads data from the modem flash parititon. */
+
+void SerialPort::flashRead()
+{
+    uint8_t reply[249U];
+
+    reply[0U] = DVM_SHORT_FRAME_START;
+    reply[1U] = 249U;
+    reply[2U] = CMD_FLSH_READ;
+
+    ::memcpy(reply + 3U, hostSim.getFlash(), 246U);
+
+    writeInt(1U, reply, 249U, NULL, 0U);
+}
+
+/* Writes data to the modem flash partition. */
+
+uint8_t SerialPort::flashWrite(const uint8_t* data, uint8_t length)
+{
+    if (length > 249U) {
+        return RSN_FLASH_WRITE_TOO_BIG;
+    }
+
+    uint8_t* flash = hostSim.getFlash();
+    ::memset(flash, 0xFFU, HOST_FLASH_SIZE);
+    ::memcpy(flash, data, length);
+
+    return RSN_OK;
+}
+
+/* */
+
+void SerialPort::beginInt(uint8_t n, int speed)
+{
+    /* stub */
+}
+
+/* */
+
+int SerialPort::availableInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        return int(hostSim.getModemRX().getData());
+    default:
+        return 0;
+    }
+}
+
+/* */
+
+int SerialPort::availableForWriteInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        return int(hostSim.getModemTX().getSpace());
+    default:
+        return 0;
+    }
+}
+
+/* */
+
+uint8_t SerialPort::readInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        return hostSim.getModemRX().read();
+    default:
+        return 0U;
+    }
+}
+
+/* Gets the received bytes that can be read without wrapping, leaving them in the receive FIFO. */
+
+uint16_t SerialPort::peekInt(uint8_t n, const uint8_t** data)
+{
+    switch (n) {
+    case 1U:
+    {
+        // a span is at most a uint16_t long; the rest is handed out on the next call
+        uint32_t length = hostSim.getModemRX().peek(data);
+        return (length > 0xFFFFU) ? 0xFFFFU : uint16_t(length);
+    }
+    default:
+        return 0U;
+    }
+}
+
+/* Discards received bytes previously returned by peekInt(). */
+
+void SerialPort::consumeInt(uint8_t n, uint16_t length)
+{
+    switch (n) {
+    case 1U:
+        hostSim.getModemRX().skip(length);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Gets the number of received bytes dropped because the receive FIFO was full. */
+
+uint32_t SerialPort::droppedInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        return hostSim.getModemRX().getLost();
+    default:
+        return 0U;
+    }
+}
+
+/* Gets the free running count of bytes written to the transmit FIFO. */
+
+uint16_t SerialPort::txWrittenInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        return uint16_t(hostSim.getModemTX().getWritten());
+    default:
+        return 0U;
+    }
+}
+
+/* Gets the free running count of bytes the UART has taken from the transmit FIFO. */
+
+uint16_t SerialPort::txSentInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        // the host reading the modem to host stream stands in for the UART sending it
+        return uint16_t(hostSim.getModemTX().getRead());
+    default:
+        return 0U;
+    }
+}
+
+/* */
+
+uint16_t SerialPort::writeInt(uint8_t n, const uint8_t* data, uint16_t length, bool flush)
+{
+    switch (n) {
+    case 1U:
+        return uint16_t(hostSim.getModemTX().write(data, length));
+    default:
+        return 0U;
+    }
+}
+
+#endif // HOST_SIM
@@ -34,7 +34,17 @@ SerialPort::SerialPort() :
     m_ptr(0U),
     m_len(0U),
     m_dblFrame(false),
-    m_debug(false)
+    m_debug(false),
+    m_txDropped(0U),
+    m_batch(),
+    m_batchLen(0U),
+    m_batchFrames(0U),
+    m_batchStart(0U),
+    m_batchTimeout(0U),
+    m_creditAck(false),
+    m_creditInterval(0U),
+    m_creditStart(0U),
+    m_credits()
 {
     // stub
 }
@@ -50,370 +60,112 @@ void SerialPort::start()
 
 void SerialPort::process()
 {
-    while (availableInt(1U)) {
-        uint8_t c = readInt(1U);
-
-        if (m_ptr == 0U) {
-            if (c == DVM_SHORT_FRAME_START) {
-                // Handle the frame start correctly
-                m_buffer[0U] = c;
-                m_ptr = 1U;
-                m_len = 0U;
-                m_dblFrame = false;
-            }
-            else if (c == DVM_LONG_FRAME_START) {
-                // Handle the frame start correctly
-                m_buffer[0U] = c;
-                m_ptr = 1U;
-                m_len = 0U;
-                m_dblFrame = true;
+    PROFILE_SCOPE(PROBE_SERIAL_PROCESS);
+
+    // take the received bytes a contiguous span of the FIFO at a time, so a whole frame is normally
+    // handled by one pass rather than a byte per call down to the UART
+    const uint8_t* data = NULL;
+    uint16_t length = 0U;
+    while ((length = peekInt(1U, &data)) > 0U) {
+        for (uint16_t used = 0U; used < length; ) {
+            uint8_t c = data[used++];
+
+            if (m_ptr == 0U) {
+                if (c == DVM_SHORT_FRAME_START) {
+                    // Handle the frame start correctly
+                    m_buffer[0U] = c;
+                    m_ptr = 1U;
+                    m_len = 0U;
+                    m_dblFrame = false;
+                }
+                else if (c == DVM_LONG_FRAME_START) {
+                    // Handle the frame start correctly
+                    m_buffer[0U] = c;
+                    m_ptr = 1U;
+                    m_len = 0U;
+                    m_dblFrame = true;
+                }
+                else {
+                    m_ptr = 0U;
+                    m_len = 0U;
+                }
             }
-            else {
-                m_ptr = 0U;
-                m_len = 0U;
+            else if (m_ptr == 1U) {
+                // Handle the frame length
+                if (m_dblFrame) {
+                    m_buffer[m_ptr] = c;
+                    m_len = ((c & 0xFFU) << 8);
+                    // DEBUG3("long frame, len msb", m_len, c);
+                } else {
+                    m_len = m_buffer[m_ptr] = c;
+                    // DEBUG2("short frame, len", m_len);
+                }
+                m_ptr = 2U;
             }
-        }
-        else if (m_ptr == 1U) {
-            // Handle the frame length
-            if (m_dblFrame) {
+            else if (m_ptr == 2U && m_dblFrame) {
+                // Handle the frame length
                 m_buffer[m_ptr] = c;
-                m_len = ((c & 0xFFU) << 8);
-                // DEBUG3("long frame, len msb", m_len, c);
-            } else {
-                m_len = m_buffer[m_ptr] = c;
-                // DEBUG2("short frame, len", m_len);
+                m_len = (m_len + (c & 0xFFU));
+                if (m_len > SERIAL_FB_LEN)
+                    m_len = SERIAL_FB_LEN; // don't allow length to be longer then the buffer
+                // DEBUG3("long frame, len lsb", m_len, c);
+                m_ptr = 3U;
             }
-            m_ptr = 2U;
-        }
-        else if (m_ptr == 2U && m_dblFrame) {
-            // Handle the frame length
-            m_buffer[m_ptr] = c;
-            m_len = (m_len + (c & 0xFFU));
-            if (m_len > SERIAL_FB_LEN)
-                m_len = SERIAL_FB_LEN; // don't allow length to be longer then the buffer
-            // DEBUG3("long frame, len lsb", m_len, c);
-            m_ptr = 3U;
-        }
-        else {
-            // Any other bytes are added to the buffer
-            m_buffer[m_ptr] = c;
-            m_ptr++;
-
-            // The full packet has been received, process it
-            if (m_ptr == m_len) {
-                uint8_t err = 2U;
-                uint8_t offset = 2U;
-                if (m_dblFrame)
-                    offset = 3U;
-
-                // DEBUG4("m_buffer [b0 - b2]", m_buffer[0], m_buffer[1], m_buffer[2]);
-                // DEBUG4("m_buffer [b3 - b5]", m_buffer[3], m_buffer[4], m_buffer[5]);
-
-                switch (m_buffer[offset]) {
-                case CMD_GET_STATUS:
-                    getStatus();
-                    break;
-
-                case CMD_GET_VERSION:
-                    getVersion();
-                    break;
-
-                case CMD_SET_CONFIG:
-                    err = setConfig(m_buffer + 3U, m_len - 3U);
-                    if (err == RSN_OK)
-                        sendACK();
-                    else
-                        sendNAK(err);
-                    break;
-
-                case CMD_SET_MODE:
-                    err = setMode(m_buffer + 3U, m_len - 3U);
-                    if (err == RSN_OK)
-                        sendACK();
-                    else
-                        sendNAK(err);
-                    break;
-
-                case CMD_SET_SYMLVLADJ:
-                    sendACK(); // CMD_SET_RXLEVEL not supported by HS
-                    break;
-
-                case CMD_SET_RXLEVEL:
-                    sendACK(); // CMD_SET_RXLEVEL not supported by HS
-                    break;
-
-                case CMD_SET_RFPARAMS:
-                    err = setRFParams(m_buffer + 3U, m_len - 3U);
-                    if (err == RSN_OK)
-                        sendACK();
-                    else
-                        sendNAK(err);
-                    break;
-
-                case CMD_CAL_DATA:
-                    if (m_modemState == STATE_DMR_DMO_CAL_1K || m_modemState == STATE_DMR_CAL_1K ||
-                        m_modemState == STATE_DMR_LF_CAL || m_modemState == STATE_DMR_CAL)
-                        err = calDMR.write(m_buffer + 3U, m_len - 3U);
-                    if (m_modemState == STATE_P25_CAL_1K || m_modemState == STATE_P25_CAL)
-                        err = calP25.write(m_buffer + 3U, m_len - 3U);
-                    if (m_modemState == STATE_NXDN_CAL)
-                        err = calNXDN.write(m_buffer + 3U, m_len - 3U);
-                    if (err == RSN_OK)
-                    {
-                        sendACK();
-                    }
-                    else {
-                        DEBUG2("SerialPort::process() received invalid calibration data", err);
-                        sendNAK(err);
-                    }
-                    break;
-
-                case CMD_FLSH_READ:
-                    flashRead();
-                    break;
-
-                case CMD_FLSH_WRITE:
-                    err = flashWrite(m_buffer + 3U, m_len - 3U);
-                    if (err == RSN_OK) {
-                        sendACK();
-                    }
-                    else {
-                        DEBUG2("SerialPort::process() received invalid data to write to flash", err);
-                        sendNAK(err);
-                    }
-                    break;
-
-                case CMD_RESET_MCU:
-                    io.resetMCU();
-                    break;
-
-                case CMD_SET_BUFFERS:
-                    err = setBuffers(m_buffer + 3U, m_len - 3U);
-                    if (err == RSN_OK) {
-                        sendACK();
-                    }
-                    else {
-                        DEBUG2("SerialPort::process() received invalid data to set buffers", err);
-                        sendNAK(err);
-                    }
-                    break;
-
-                /** CW */
-                case CMD_SEND_CWID:
-                    err = RSN_RINGBUFF_FULL;
-                    if (m_modemState == STATE_IDLE) {
-                        m_cwIdState = true;
-                        
-                        DEBUG2("SerialPort::process() setting modem state", STATE_CW);
-                        io.rf1Conf(STATE_CW, true);
-                        
-                        err = cwIdTX.write(m_buffer + 3U, m_len - 3U);
-                    }
-                    if (err != RSN_OK) {
-                        DEBUG2("SerialPort::process() invalid CW Id data", err);
-                        sendNAK(err);
-                    }
-                    break;
-
-                /** Digital Mobile Radio */
-                case CMD_DMR_DATA1:
-#if defined(DUPLEX)
-                    if (m_dmrEnable) {
-                        if (m_modemState == STATE_IDLE || m_modemState == STATE_DMR) {
-                            if (m_duplex)
-                                err = dmrTX.writeData1(m_buffer + 3U, m_len - 3U);
-                        }
-                    }
-                    if (err == RSN_OK) {
-                        if (m_modemState == STATE_IDLE)
-                            setMode(STATE_DMR);
-                    }
-                    else {
-                        DEBUG2("SerialPort::process() received invalid DMR data", err);
-                        sendNAK(err);
-                    }
-#else
-                    sendNAK(RSN_INVALID_REQUEST);
-#endif
-                    break;
-
-                case CMD_DMR_DATA2:
-                    if (m_dmrEnable) {
-                        if (m_modemState == STATE_IDLE || m_modemState == STATE_DMR) {
-#if defined(DUPLEX)
-                            if (m_duplex)
-                                err = dmrTX.writeData2(m_buffer + 3U, m_len - 3U);
-                            else
-                                err = dmrDMOTX.writeData(m_buffer + 3U, m_len - 3U);
-#else
-                            err = dmrDMOTX.writeData(m_buffer + 3U, m_len - 3U);
-#endif
-                        }
-                    }
-                    if (err == RSN_OK) {
-                        if (m_modemState == STATE_IDLE)
-                            setMode(STATE_DMR);
-                    }
-                    else {
-                        DEBUG2("SerialPort::process() received invalid DMR data", err);
-                        sendNAK(err);
-                    }
-                    break;
-
-                case CMD_DMR_START:
-#if defined(DUPLEX)
-                    if (m_dmrEnable) {
-                        err = RSN_INVALID_DMR_START;
-                        if (m_len == 4U) {
-                            if (m_buffer[3U] == 0x01U && m_modemState == STATE_DMR) {
-                                if (!m_tx)
-                                    dmrTX.setStart(true);
-                                err = RSN_OK;
-                            }
-                            else if (m_buffer[3U] == 0x00U && m_modemState == STATE_DMR) {
-                                if (m_tx)
-                                    dmrTX.setStart(false);
-                                err = RSN_OK;
-                            }
-                        }
-                    }
-                    if (err != RSN_OK) {
-                        DEBUG3("SerialPort::process() received invalid DMR start", err, m_len);
-                        sendNAK(err);
-                    }
-#else
-                    sendNAK(RSN_INVALID_REQUEST);
-#endif
-                    break;
+            else {
+                // Any other bytes are added to the buffer, along with as much of the rest of the frame as
+                // the span holds
+                m_buffer[m_ptr] = c;
+                m_ptr++;
 
-                case CMD_DMR_SHORTLC:
-#if defined(DUPLEX)
-                    if (m_dmrEnable)
-                        err = dmrTX.writeShortLC(m_buffer + 3U, m_len - 3U);
-                    if (err != RSN_OK) {
-                        DEBUG2("SerialPort::process() received invalid DMR Short LC", err);
-                        sendNAK(err);
-                    }
-#else
-                    sendNAK(RSN_INVALID_REQUEST);
-#endif
-                    break;
+                if (m_ptr < m_len) {
+                    uint16_t count = m_len - m_ptr;
+                    if (count > length - used)
+                        count = length - used;
 
-                case CMD_DMR_ABORT:
-#if defined(DUPLEX)
-                    if (m_dmrEnable)
-                        err = dmrTX.writeAbort(m_buffer + 3U, m_len - 3U);
-                    if (err != RSN_OK) {
-                        DEBUG2("SerialPort::process() received invalid DMR Abort", err);
-                        sendNAK(err);
-                    }
-#else
-                    sendNAK(RSN_INVALID_REQUEST);
-#endif
-                    break;
+                    ::memcpy(m_buffer + m_ptr, data + used, count);
+                    m_ptr += count;
+                    used += count;
+                }
 
-                case CMD_DMR_CACH_AT_CTRL:
-#if defined(DUPLEX)
-                    if (m_dmrEnable) {
-                        err = RSN_INVALID_REQUEST;
-                        if (m_len == 4U) {
-                            dmrTX.setIgnoreCACH_AT(m_buffer[3U]);
-                            err = RSN_OK;
-                        }
-                    }
-                    if (err != RSN_OK) {
-                        DEBUG2("SerialPort::process() received invalid DMR CACH AT Control", err);
-                        sendNAK(err);
-                    }
-#else
-                    sendNAK(RSN_INVALID_REQUEST);
-#endif
-                    break;
+                // The full packet has been received, process it
+                if (m_ptr == m_len) {
+                    processFrame();
 
-                case CMD_DMR_CLEAR1:
-#if defined(DUPLEX)
-                    if (m_dmrEnable) {
-                        if (m_modemState == STATE_IDLE || m_modemState == STATE_P25)
-                            dmrTX.resetFifo1();
-                    }
-#else
-                    sendNAK(RSN_INVALID_REQUEST);
-#endif
-                    break;
-                case CMD_DMR_CLEAR2:
-#if defined(DUPLEX)
-                    if (m_dmrEnable) {
-                        if (m_modemState == STATE_IDLE || m_modemState == STATE_P25)
-                            dmrTX.resetFifo2();
-                    }
-#else
-                    sendNAK(RSN_INVALID_REQUEST);
-#endif
-                    break;
-
-
-                /** Project 25 */
-                case CMD_P25_DATA:
-                    if (m_p25Enable) {
-                        if (m_modemState == STATE_IDLE || m_modemState == STATE_P25) {
-                            if (m_dblFrame)
-                                err = p25TX.writeData(m_buffer + 4U, m_len - 4U);
-                            else
-                                err = p25TX.writeData(m_buffer + 3U, m_len - 3U);
-                        }
-                    }
-                    if (err == RSN_OK) {
-                        if (m_modemState == STATE_IDLE)
-                            setMode(STATE_P25);
-                    }
-                    else {
-                        DEBUG2("SerialPort::process() received invalid P25 data", err);
-                        sendNAK(err);
-                    }
-                    break;
-
-                case CMD_P25_CLEAR:
-                    if (m_p25Enable) {
-                        if (m_modemState == STATE_IDLE || m_modemState == STATE_P25)
-                            p25TX.clear();
-                    }
-                    break;
-
-                /** Next Generation Digital Narrowband */
-                case CMD_NXDN_DATA:
-                    if (m_nxdnEnable) {
-                        if (m_modemState == STATE_IDLE || m_modemState == STATE_NXDN)
-                            err = nxdnTX.writeData(m_buffer + 3U, m_len - 3U);
-                    }
-                    if (err == RSN_OK) {
-                        if (m_modemState == STATE_IDLE)
-                            setMode(STATE_NXDN);
-                    }
-                    else {
-                        DEBUG2("SerialPort::process() received invalid NXDN data", err);
-                        sendNAK(err);
-                    }
-                    break;
-                case CMD_NXDN_CLEAR:
-                    if (m_nxdnEnable) {
-                        if (m_modemState == STATE_IDLE || m_modemState == STATE_P25)
-                            nxdnTX.clear();
-                    }
-                    break;
-
-                default:
-                    // Handle this, send a NAK back
-                    sendNAK(RSN_NAK);
-                    break;
+                    m_ptr = 0U;
+                    m_len = 0U;
+                    m_dblFrame = false;
                 }
-
-                m_ptr = 0U;
-                m_len = 0U;
-                m_dblFrame = false;
             }
         }
+
+        consumeInt(1U, length);
     }
 
+    // write the batched frames once the oldest has been held back for the flush deadline
+    if (m_batchLen > 0U) {
+        uint32_t deadline = (uint32_t(m_batchTimeout) * io.getClockRate()) / 1000U;
+        if ((io.getClock() - m_batchStart) >= deadline)
+            flushBatch();
+    }
+
+    // check the TX FIFO credits once every event interval, and report them if they have changed
+    if (m_creditInterval > 0U) {
+        uint32_t interval = (uint32_t(m_creditInterval) * io.getClockRate()) / 1000U;
+        if ((io.getClock() - m_creditStart) >= interval) {
+            uint8_t credits[SERIAL_CREDITS_LEN];
+            getCredits(credits);
+            m_creditStart = io.getClock();
+
+            if (::memcmp(credits, m_credits, SERIAL_CREDITS_LEN) != 0)
+                writeCredits();
+        }
+    }
+
+#if defined(ENABLE_TRACER)
+    // the traced frame is sent once the UART has taken its last byte from the transmit FIFO
+    tracer.process(txSentInt(1U));
+#endif
+
     if (io.getWatchdog() >= 48000U) {
         m_ptr = 0U;
         m_len = 0U;
@@ -468,22 +220,19 @@ void SerialPort::writeDMRData(bool slot, const uint8_t* data, uint8_t length)
     if (!m_dmrEnable)
         return;
 
-    if (length + 3U > 40U) {
+    if (length + 3U > 44U) {
         m_buffer[2U] = slot ? CMD_DMR_DATA2 : CMD_DMR_DATA1;
         sendNAK(RSN_ILLEGAL_LENGTH);
         return;
     }
 
-    uint8_t reply[40U];
-    ::memset(reply, 0x00U, 40U);
-
-    reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = length + 3U;
-    reply[2U] = slot ? CMD_DMR_DATA2 : CMD_DMR_DATA1;
-
-    ::memcpy(reply + 3U, data, length);
+    uint8_t header[3U];
+    header[0U] = DVM_SHORT_FRAME_START;
+    header[1U] = length + 3U;
+    header[2U] = slot ? CMD_DMR_DATA2 : CMD_DMR_DATA1;
 
-    writeInt(1U, reply, length + 3U);
+    SerialSpan payload = { data, length };
+    writeBatched(header, 3U, &payload, 1U, true);
 }
 
 /* Write lost DMR frame data to serial port. */
@@ -502,12 +251,12 @@ void SerialPort::writeDMRLost(bool slot)
     reply[1U] = 3U;
     reply[2U] = slot ? CMD_DMR_LOST2 : CMD_DMR_LOST1;
 
-    writeInt(1U, reply, 3);
+    writeBatched(reply, 3, NULL, 0U);
 }
 
 /* Write P25 frame data to serial port. */
 
-void SerialPort::writeP25Data(const uint8_t* data, uint16_t length)
+void SerialPort::writeP25Data(uint8_t flags, const uint8_t* data, uint16_t length, const uint8_t* trailer, uint8_t trailerLength)
 {
     if (m_modemState != STATE_P25 && m_modemState != STATE_IDLE)
         return;
@@ -515,33 +264,30 @@ void SerialPort::writeP25Data(const uint8_t* data, uint16_t length)
     if (!m_p25Enable)
         return;
 
-    if (length + 4U > 520U) {
+    // the flags byte leads the frame data
+    uint16_t total = length + trailerLength + 1U;
+    if (total + 4U > 524U) {
         m_buffer[2U] = CMD_P25_DATA;
         sendNAK(RSN_ILLEGAL_LENGTH);
         return;
     }
 
-    uint8_t reply[520U];
-    ::memset(reply, 0x00U, 520U);
-
-    if (length < 252U) {
-        reply[0U] = DVM_SHORT_FRAME_START;
-        reply[1U] = length + 3U;
-        reply[2U] = CMD_P25_DATA;
-        ::memcpy(reply + 3U, data, length);
-
-        writeInt(1U, reply, length + 3U);
+    uint8_t header[5U];
+    uint8_t headerLength = 0U;
+    if (total < 252U) {
+        header[headerLength++] = DVM_SHORT_FRAME_START;
+        header[headerLength++] = total + 3U;
     }
     else {
-        length += 4U;
-        reply[0U] = DVM_LONG_FRAME_START;
-        reply[1U] = (length >> 8U) & 0xFFU;
-        reply[2U] = (length & 0xFFU);
-        reply[3U] = CMD_P25_DATA;
-        ::memcpy(reply + 4U, data, length);
-
-        writeInt(1U, reply, length + 4U);
+        header[headerLength++] = DVM_LONG_FRAME_START;
+        header[headerLength++] = ((total + 4U) >> 8U) & 0xFFU;
+        header[headerLength++] = ((total + 4U) & 0xFFU);
     }
+    header[headerLength++] = CMD_P25_DATA;
+    header[headerLength++] = flags;
+
+    SerialSpan payload[2U] = { { data, length }, { trailer, trailerLength } };
+    writeBatched(header, headerLength, payload, 2U, true);
 }
 
 /* Write lost P25 frame data to serial port. */
@@ -560,7 +306,7 @@ void SerialPort::writeP25Lost()
     reply[1U] = 3U;
     reply[2U] = CMD_P25_LOST;
 
-    writeInt(1U, reply, 3);
+    writeBatched(reply, 3, NULL, 0U);
 }
 
 /* Write NXDN frame data to serial port. */
@@ -579,16 +325,13 @@ void SerialPort::writeNXDNData(const uint8_t* data, uint8_t length)
         return;
     }
 
-    uint8_t reply[130U];
-    ::memset(reply, 0x00U, 130U);
-
-    reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = length + 3U;
-    reply[2U] = CMD_NXDN_DATA;
-
-    ::memcpy(reply + 3U, data, length);
+    uint8_t header[3U];
+    header[0U] = DVM_SHORT_FRAME_START;
+    header[1U] = length + 3U;
+    header[2U] = CMD_NXDN_DATA;
 
-    writeInt(1U, reply, length + 3U);
+    SerialSpan payload = { data, length };
+    writeBatched(header, 3U, &payload, 1U, true);
 }
 
 /* Write lost NXDN frame data to serial port. */
@@ -607,7 +350,7 @@ void SerialPort::writeNXDNLost()
     reply[1U] = 3U;
     reply[2U] = CMD_NXDN_LOST;
 
-    writeInt(1U, reply, 3);
+    writeBatched(reply, 3, NULL, 0U);
 }
 
 /* Write calibration frame data to serial port. */
@@ -620,16 +363,13 @@ void SerialPort::writeCalData(const uint8_t* data, uint8_t length)
         return;
     }
 
-    uint8_t reply[130U];
-    ::memset(reply, 0x00U, 130U);
+    uint8_t header[3U];
+    header[0U] = DVM_SHORT_FRAME_START;
+    header[1U] = length + 3U;
+    header[2U] = CMD_CAL_DATA;
 
-    reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = length + 3U;
-    reply[2U] = CMD_CAL_DATA;
-
-    ::memcpy(reply + 3U, data, length);
-
-    writeInt(1U, reply, length + 3U);
+    SerialSpan payload = { data, length };
+    writeInt(1U, header, 3U, &payload, 1U);
 }
 
 /* Write RSSI frame data to serial port. */
@@ -645,225 +385,545 @@ void SerialPort::writeRSSIData(const uint8_t* data, uint8_t length)
         return;
     }
 
-    uint8_t reply[30U];
-    ::memset(reply, 0x00U, 30U);
-
-    reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = length + 3U;
-    reply[2U] = CMD_RSSI_DATA;
-
-    ::memcpy(reply + 3U, data, length);
+    uint8_t header[3U];
+    header[0U] = DVM_SHORT_FRAME_START;
+    header[1U] = length + 3U;
+    header[2U] = CMD_RSSI_DATA;
 
-    writeInt(1U, reply, length + 3U);
+    SerialSpan payload = { data, length };
+    writeInt(1U, header, 3U, &payload, 1U);
 }
 
-/* */
+/* Write a report of a frame sent after its launch time to serial port. */
 
-void SerialPort::writeDebug(const char* text)
+void SerialPort::writeTXLate(uint8_t cmd, uint32_t launch, uint32_t start)
 {
-    if (!m_debug)
-        return;
-
-    uint8_t reply[130U];
-    ::memset(reply, 0x00U, 130U);
+    uint8_t reply[12U];
 
     reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = 0U;
-    reply[2U] = CMD_DEBUG1;
+    reply[1U] = 12U;
+    reply[2U] = CMD_TX_LATE;
+    reply[3U] = cmd;
 
-    uint8_t count = 3U;
-    for (uint8_t i = 0U; text[i] != '\0'; i++, count++)
-        reply[count] = text[i];
+    for (uint8_t i = 0U; i < 4U; i++) {
+        reply[4U + i] = (launch >> (24U - i * 8U)) & 0xFFU;
+        reply[8U + i] = (start >> (24U - i * 8U)) & 0xFFU;
+    }
 
-    reply[1U] = count;
+    writeInt(1U, reply, 12U, NULL, 0U);
+}
+
+/* */
 
-    writeInt(1U, reply, count, true);
+void SerialPort::writeDebug(const char* text)
+{
+    writeDebug(CMD_DEBUG1, text, NULL, 0U);
 }
 
 /* */
 
 void SerialPort::writeDebug(const char* text, int16_t n1)
 {
-    if (!m_debug)
-        return;
+    int16_t values[1U] = { n1 };
+    writeDebug(CMD_DEBUG2, text, values, 1U);
+}
 
-    uint8_t reply[130U];
-    ::memset(reply, 0x00U, 130U);
+/* */
 
-    reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = 0U;
-    reply[2U] = CMD_DEBUG2;
+void SerialPort::writeDebug(const char* text, int16_t n1, int16_t n2)
+{
+    int16_t values[2U] = { n1, n2 };
+    writeDebug(CMD_DEBUG3, text, values, 2U);
+}
 
-    uint8_t count = 3U;
-    for (uint8_t i = 0U; text[i] != '\0'; i++, count++)
-        reply[count] = text[i];
+/* */
 
-    reply[count++] = (n1 >> 8) & 0xFF;
-    reply[count++] = (n1 >> 0) & 0xFF;
+void SerialPort::writeDebug(const char* text, int16_t n1, int16_t n2, int16_t n3)
+{
+    int16_t values[3U] = { n1, n2, n3 };
+    writeDebug(CMD_DEBUG4, text, values, 3U);
+}
 
-    reply[1U] = count;
+/* */
 
-    writeInt(1U, reply, count, true);
+void SerialPort::writeDebug(const char* text, int16_t n1, int16_t n2, int16_t n3, int16_t n4)
+{
+    int16_t values[4U] = { n1, n2, n3, n4 };
+    writeDebug(CMD_DEBUG5, text, values, 4U);
 }
 
 /* */
 
-void SerialPort::writeDebug(const char* text, int16_t n1, int16_t n2)
+void SerialPort::writeDump(const uint8_t* data, uint16_t length)
 {
     if (!m_debug)
         return;
 
-    uint8_t reply[130U];
-    ::memset(reply, 0x00U, 130U);
+    if (length + 4U > 516U) {
+        m_buffer[2U] = CMD_DEBUG_DUMP;
+        sendNAK(RSN_ILLEGAL_LENGTH);
+        return;
+    }
 
-    reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = 0U;
-    reply[2U] = CMD_DEBUG3;
+    uint8_t header[4U];
+    uint8_t headerLength = 0U;
+    if (length > 252U) {
+        header[headerLength++] = DVM_LONG_FRAME_START;
+        header[headerLength++] = (length >> 8U) & 0xFFU;
+        header[headerLength++] = (length & 0xFFU);
+    }
+    else {
+        header[headerLength++] = DVM_SHORT_FRAME_START;
+        header[headerLength++] = length + 3U;
+    }
+    header[headerLength++] = CMD_DEBUG_DUMP;
 
-    uint8_t count = 3U;
-    for (uint8_t i = 0U; text[i] != '\0'; i++, count++)
-        reply[count] = text[i];
+    SerialSpan payload = { data, length };
+    writeInt(1U, header, headerLength, &payload, 1U);
+}
 
-    reply[count++] = (n1 >> 8) & 0xFF;
-    reply[count++] = (n1 >> 0) & 0xFF;
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
 
-    reply[count++] = (n2 >> 8) & 0xFF;
-    reply[count++] = (n2 >> 0) & 0xFF;
+/* Process a complete frame in the frame buffer. */
 
-    reply[1U] = count;
+void SerialPort::processFrame()
+{
+    uint8_t err = 2U;
+    uint8_t offset = 2U;
+    if (m_dblFrame)
+        offset = 3U;
 
-    writeInt(1U, reply, count, true);
-}
+    // DEBUG4("m_buffer [b0 - b2]", m_buffer[0], m_buffer[1], m_buffer[2]);
+    // DEBUG4("m_buffer [b3 - b5]", m_buffer[3], m_buffer[4], m_buffer[5]);
 
-/* */
+    switch (m_buffer[offset]) {
+    case CMD_GET_STATUS:
+        getStatus();
+        break;
 
-void SerialPort::writeDebug(const char* text, int16_t n1, int16_t n2, int16_t n3)
-{
-    if (!m_debug)
-        return;
+    case CMD_GET_VERSION:
+        getVersion();
+        break;
 
-    uint8_t reply[130U];
-    ::memset(reply, 0x00U, 130U);
+    case CMD_GET_PROFILE:
+#if defined(ENABLE_PROFILER)
+        err = getProfile(m_buffer + 3U, m_len - 3U);
+        if (err != RSN_OK)
+            sendNAK(err);
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
 
-    reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = 0U;
-    reply[2U] = CMD_DEBUG4;
+    case CMD_GET_TRACE:
+#if defined(ENABLE_TRACER)
+        err = getTrace(m_buffer + 3U, m_len - 3U);
+        if (err != RSN_OK)
+            sendNAK(err);
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
 
-    uint8_t count = 3U;
-    for (uint8_t i = 0U; text[i] != '\0'; i++, count++)
-        reply[count] = text[i];
+    case CMD_SET_CONFIG:
+        err = setConfig(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK)
+            sendACK();
+        else
+            sendNAK(err);
+        break;
 
-    reply[count++] = (n1 >> 8) & 0xFF;
-    reply[count++] = (n1 >> 0) & 0xFF;
+    case CMD_SET_MODE:
+        err = setMode(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK)
+            sendACK();
+        else
+            sendNAK(err);
+        break;
 
-    reply[count++] = (n2 >> 8) & 0xFF;
-    reply[count++] = (n2 >> 0) & 0xFF;
+    case CMD_SET_SYMLVLADJ:
+        sendACK(); // CMD_SET_RXLEVEL not supported by HS
+        break;
 
-    reply[count++] = (n3 >> 8) & 0xFF;
-    reply[count++] = (n3 >> 0) & 0xFF;
+    case CMD_SET_RXLEVEL:
+        sendACK(); // CMD_SET_RXLEVEL not supported by HS
+        break;
 
-    reply[1U] = count;
+    case CMD_SET_RFPARAMS:
+        err = setRFParams(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK)
+            sendACK();
+        else
+            sendNAK(err);
+        break;
 
-    writeInt(1U, reply, count, true);
-}
+    case CMD_CAL_DATA:
+        if (m_modemState == STATE_DMR_DMO_CAL_1K || m_modemState == STATE_DMR_CAL_1K ||
+            m_modemState == STATE_DMR_LF_CAL || m_modemState == STATE_DMR_CAL)
+            err = calDMR.write(m_buffer + 3U, m_len - 3U);
+        if (m_modemState == STATE_P25_CAL_1K || m_modemState == STATE_P25_CAL)
+            err = calP25.write(m_buffer + 3U, m_len - 3U);
+        if (m_modemState == STATE_NXDN_CAL)
+            err = calNXDN.write(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK)
+        {
+            sendACK();
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid calibration data", err);
+            sendNAK(err);
+        }
+        break;
 
-/* */
+    case CMD_FLSH_READ:
+        flashRead();
+        break;
 
-void SerialPort::writeDebug(const char* text, int16_t n1, int16_t n2, int16_t n3, int16_t n4)
-{
-    if (!m_debug)
-        return;
+    case CMD_FLSH_WRITE:
+        err = flashWrite(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK) {
+            sendACK();
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid data to write to flash", err);
+            sendNAK(err);
+        }
+        break;
 
-    uint8_t reply[130U];
-    ::memset(reply, 0x00U, 130U);
+    case CMD_RESET_MCU:
+        io.resetMCU();
+        break;
 
-    reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = 0U;
-    reply[2U] = CMD_DEBUG5;
+    case CMD_SET_BUFFERS:
+        err = setBuffers(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK) {
+            sendACK();
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid data to set buffers", err);
+            sendNAK(err);
+        }
+        break;
 
-    uint8_t count = 3U;
-    for (uint8_t i = 0U; text[i] != '\0'; i++, count++)
-        reply[count] = text[i];
+    case CMD_SET_ALLOW_LIST:
+        err = setAllowList(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK) {
+            sendACK();
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid allow list", err);
+            sendNAK(err);
+        }
+        break;
 
-    reply[count++] = (n1 >> 8) & 0xFF;
-    reply[count++] = (n1 >> 0) & 0xFF;
+    case CMD_GET_REJECTS:
+        getRejects();
+        break;
 
-    reply[count++] = (n2 >> 8) & 0xFF;
-    reply[count++] = (n2 >> 0) & 0xFF;
+    case CMD_BATCH:
+        processBatch();
+        break;
 
-    reply[count++] = (n3 >> 8) & 0xFF;
-    reply[count++] = (n3 >> 0) & 0xFF;
+    case CMD_SET_BATCH:
+        err = setBatch(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK) {
+            sendACK();
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid batch deadline", err);
+            sendNAK(err);
+        }
+        break;
 
-    reply[count++] = (n4 >> 8) & 0xFF;
-    reply[count++] = (n4 >> 0) & 0xFF;
+    case CMD_SET_CREDITS:
+        err = setCredits(m_buffer + 3U, m_len - 3U);
+        if (err == RSN_OK) {
+            sendACK();
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid credit reporting", err);
+            sendNAK(err);
+        }
+        break;
 
-    reply[1U] = count;
+    case CMD_TX_CREDITS:
+        writeCredits();
+        break;
 
-    writeInt(1U, reply, count, true);
-}
+    /** CW */
+    case CMD_SEND_CWID:
+        err = RSN_RINGBUFF_FULL;
+        if (m_modemState == STATE_IDLE) {
+            m_cwIdState = true;
+            
+            DEBUG2("SerialPort::process() setting modem state", STATE_CW);
+            io.rf1Conf(STATE_CW, true);
+            
+            err = cwIdTX.write(m_buffer + 3U, m_len - 3U);
+        }
+        if (err != RSN_OK) {
+            DEBUG2("SerialPort::process() invalid CW Id data", err);
+            sendNAK(err);
+        }
+        break;
 
-/* */
+    /** Digital Mobile Radio */
+    case CMD_DMR_DATA1:
+#if defined(DUPLEX)
+        if (m_dmrEnable) {
+            if (m_modemState == STATE_IDLE || m_modemState == STATE_DMR) {
+                if (m_duplex)
+                    err = dmrTX.writeData1(m_buffer + 3U, m_len - 3U);
+            }
+        }
+        if (err == RSN_OK) {
+            if (m_modemState == STATE_IDLE)
+                setMode(STATE_DMR);
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid DMR data", err);
+            sendNAK(err);
+        }
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
 
-void SerialPort::writeDump(const uint8_t* data, uint16_t length)
-{
-    if (!m_debug)
-        return;
+    case CMD_DMR_DATA2:
+        if (m_dmrEnable) {
+            if (m_modemState == STATE_IDLE || m_modemState == STATE_DMR) {
+#if defined(DUPLEX)
+                if (m_duplex)
+                    err = dmrTX.writeData2(m_buffer + 3U, m_len - 3U);
+                else
+                    err = dmrDMOTX.writeData(m_buffer + 3U, m_len - 3U);
+#else
+                err = dmrDMOTX.writeData(m_buffer + 3U, m_len - 3U);
+#endif
+            }
+        }
+        if (err == RSN_OK) {
+            if (m_modemState == STATE_IDLE)
+                setMode(STATE_DMR);
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid DMR data", err);
+            sendNAK(err);
+        }
+        break;
 
-    if (length + 4U > 516U) {
-        m_buffer[2U] = CMD_DEBUG_DUMP;
-        sendNAK(RSN_ILLEGAL_LENGTH);
-        return;
-    }
+    case CMD_DMR_START:
+#if defined(DUPLEX)
+        if (m_dmrEnable) {
+            err = RSN_INVALID_DMR_START;
+            if (m_len == 4U) {
+                if (m_buffer[3U] == 0x01U && m_modemState == STATE_DMR) {
+                    if (!m_tx)
+                        dmrTX.setStart(true);
+                    err = RSN_OK;
+                }
+                else if (m_buffer[3U] == 0x00U && m_modemState == STATE_DMR) {
+                    if (m_tx)
+                        dmrTX.setStart(false);
+                    err = RSN_OK;
+                }
+            }
+        }
+        if (err != RSN_OK) {
+            DEBUG3("SerialPort::process() received invalid DMR start", err, m_len);
+            sendNAK(err);
+        }
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
 
-    uint8_t reply[516U];
-    ::memset(reply, 0x00U, 516U);
+    case CMD_DMR_SHORTLC:
+#if defined(DUPLEX)
+        if (m_dmrEnable)
+            err = dmrTX.writeShortLC(m_buffer + 3U, m_len - 3U);
+        if (err != RSN_OK) {
+            DEBUG2("SerialPort::process() received invalid DMR Short LC", err);
+            sendNAK(err);
+        }
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
 
-    if (length > 252U) {
-        reply[0U] = DVM_LONG_FRAME_START;
-        reply[1U] = (length >> 8U) & 0xFFU;
-        reply[2U] = (length & 0xFFU);
-        reply[3U] = CMD_DEBUG_DUMP;
+    case CMD_DMR_ABORT:
+#if defined(DUPLEX)
+        if (m_dmrEnable)
+            err = dmrTX.writeAbort(m_buffer + 3U, m_len - 3U);
+        if (err != RSN_OK) {
+            DEBUG2("SerialPort::process() received invalid DMR Abort", err);
+            sendNAK(err);
+        }
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
 
-        for (uint8_t i = 0U; i < length; i++)
-            reply[i + 4U] = data[i];
+    case CMD_DMR_CACH_AT_CTRL:
+#if defined(DUPLEX)
+        if (m_dmrEnable) {
+            err = RSN_INVALID_REQUEST;
+            if (m_len == 4U) {
+                dmrTX.setIgnoreCACH_AT(m_buffer[3U]);
+                err = RSN_OK;
+            }
+        }
+        if (err != RSN_OK) {
+            DEBUG2("SerialPort::process() received invalid DMR CACH AT Control", err);
+            sendNAK(err);
+        }
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
 
-        writeInt(1U, reply, length + 4U);
-    }
-    else {
-        reply[0U] = DVM_SHORT_FRAME_START;
-        reply[1U] = length + 3U;
-        reply[2U] = CMD_DEBUG_DUMP;
+    case CMD_DMR_CLEAR1:
+#if defined(DUPLEX)
+        if (m_dmrEnable) {
+            if (m_modemState == STATE_IDLE || m_modemState == STATE_P25)
+                dmrTX.resetFifo1();
+        }
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
+    case CMD_DMR_CLEAR2:
+#if defined(DUPLEX)
+        if (m_dmrEnable) {
+            if (m_modemState == STATE_IDLE || m_modemState == STATE_P25)
+                dmrTX.resetFifo2();
+        }
+#else
+        sendNAK(RSN_INVALID_REQUEST);
+#endif
+        break;
+
+
+    /** Project 25 */
+    case CMD_P25_DATA:
+        if (m_p25Enable) {
+            if (m_modemState == STATE_IDLE || m_modemState == STATE_P25) {
+                if (m_dblFrame)
+                    err = p25TX.writeData(m_buffer + 4U, m_len - 4U);
+                else
+                    err = p25TX.writeData(m_buffer + 3U, m_len - 3U);
+            }
+        }
+        if (err == RSN_OK) {
+            if (m_modemState == STATE_IDLE)
+                setMode(STATE_P25);
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid P25 data", err);
+            sendNAK(err);
+        }
+        break;
 
-        for (uint8_t i = 0U; i < length; i++)
-            reply[i + 3U] = data[i];
+    case CMD_P25_CLEAR:
+        if (m_p25Enable) {
+            if (m_modemState == STATE_IDLE || m_modemState == STATE_P25)
+                p25TX.clear();
+        }
+        break;
 
-        writeInt(1U, reply, length + 3U);
+    /** Next Generation Digital Narrowband */
+    case CMD_NXDN_DATA:
+        if (m_nxdnEnable) {
+            if (m_modemState == STATE_IDLE || m_modemState == STATE_NXDN)
+                err = nxdnTX.writeData(m_buffer + 3U, m_len - 3U);
+        }
+        if (err == RSN_OK) {
+            if (m_modemState == STATE_IDLE)
+                setMode(STATE_NXDN);
+        }
+        else {
+            DEBUG2("SerialPort::process() received invalid NXDN data", err);
+            sendNAK(err);
+        }
+        break;
+    case CMD_NXDN_CLEAR:
+        if (m_nxdnEnable) {
+            if (m_modemState == STATE_IDLE || m_modemState == STATE_P25)
+                nxdnTX.clear();
+        }
+        break;
+
+    default:
+        // Handle this, send a NAK back
+        sendNAK(RSN_NAK);
+        break;
     }
 }
 
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
+/* Process a batch of frames from the host, handling each as if it had arrived alone. */
+
+void SerialPort::processBatch()
+{
+    uint16_t offset = m_dblFrame ? 4U : 3U;
+    uint16_t end = m_len;
+
+    // each frame is moved to the start of the frame buffer in turn; the frames after it are never
+    // overwritten, as every frame starts past the batch header
+    while (offset < end) {
+        const uint8_t* frame = m_buffer + offset;
+        uint16_t left = end - offset;
+
+        bool dblFrame = frame[0U] == DVM_LONG_FRAME_START;
+        uint16_t length = 0U;
+        if (frame[0U] == DVM_SHORT_FRAME_START && left >= 3U)
+            length = frame[1U];
+        else if (dblFrame && left >= 4U)
+            length = (frame[1U] << 8) + frame[2U];
+
+        uint8_t headerLength = dblFrame ? 4U : 3U;
+        if (length < headerLength || length > left || frame[headerLength - 1U] == CMD_BATCH) {
+            DEBUG3("SerialPort::processBatch() received invalid batched frame", offset, length);
+            m_buffer[2U] = CMD_BATCH;
+            sendNAK(RSN_ILLEGAL_LENGTH);
+            return;
+        }
+
+        ::memmove(m_buffer, frame, length);
+        offset += length;
+
+        m_len = length;
+        m_dblFrame = dblFrame;
+        processFrame();
+    }
+}
 
 /* Write acknowlegement. */
 
 void SerialPort::sendACK()
 {
-    uint8_t reply[4U];
+    uint8_t reply[4U + SERIAL_CREDITS_LEN];
 
     reply[0U] = DVM_SHORT_FRAME_START;
     reply[1U] = 4U;
     reply[2U] = CMD_ACK;
     reply[3U] = m_buffer[2U];
 
-    writeInt(1U, reply, 4);
+    if (m_creditAck) {
+        getCredits(reply + 4U);
+        ::memcpy(m_credits, reply + 4U, SERIAL_CREDITS_LEN);
+        reply[1U] += SERIAL_CREDITS_LEN;
+    }
+
+    writeInt(1U, reply, reply[1U], NULL, 0U);
 }
 
 /* Write negative acknowlegement. */
 
 void SerialPort::sendNAK(uint8_t err)
 {
-    uint8_t reply[5U];
+    uint8_t reply[5U + SERIAL_CREDITS_LEN];
 
     reply[0U] = DVM_SHORT_FRAME_START;
     reply[1U] = 5U;
@@ -871,7 +931,145 @@ void SerialPort::sendNAK(uint8_t err)
     reply[3U] = m_buffer[2U];
     reply[4U] = err;
 
-    writeInt(1U, reply, 5);
+    if (m_creditAck) {
+        getCredits(reply + 5U);
+        ::memcpy(m_credits, reply + 5U, SERIAL_CREDITS_LEN);
+        reply[1U] += SERIAL_CREDITS_LEN;
+    }
+
+    writeInt(1U, reply, reply[1U], NULL, 0U);
+}
+
+/* Write debug text followed by its values. */
+
+void SerialPort::writeDebug(uint8_t cmd, const char* text, const int16_t* values, uint8_t count)
+{
+    if (!m_debug)
+        return;
+
+    // the text is written straight from its string; only the values are packed
+    uint8_t textLength = 0U;
+    while (text[textLength] != '\0' && textLength < 120U)
+        textLength++;
+
+    uint8_t packed[8U];
+    for (uint8_t i = 0U; i < count; i++) {
+        packed[i * 2U] = (values[i] >> 8) & 0xFF;
+        packed[i * 2U + 1U] = (values[i] >> 0) & 0xFF;
+    }
+
+    uint8_t header[3U];
+    header[0U] = DVM_SHORT_FRAME_START;
+    header[1U] = 3U + textLength + (count * 2U);
+    header[2U] = cmd;
+
+    SerialSpan payload[2U] = { { (const uint8_t*)text, textLength }, { packed, uint16_t(count * 2U) } };
+    writeInt(1U, header, 3U, payload, 2U, true);
+}
+
+/* Writes a frame header followed by its payload spans, without assembling the frame first. */
+
+void SerialPort::writeInt(uint8_t n, const uint8_t* header, uint8_t headerLength, const SerialSpan* spans, uint8_t count, bool flush)
+{
+    // batched frames go out first, to keep the frames in the order they were written
+    if (n == 1U && m_batchLen > 0U)
+        flushBatch();
+
+    uint16_t length = headerLength;
+    for (uint8_t i = 0U; i < count; i++)
+        length += spans[i].length;
+
+    // a truncated frame would throw the host out of step with the framing, so the frame goes out whole
+    // or not at all
+    if (availableForWriteInt(n) < int(length)) {
+        m_txDropped += length;
+#if defined(ENABLE_TRACER)
+        if (n == 1U)
+            tracer.dropped();
+#endif
+        return;
+    }
+
+    // each span goes straight into the UART transmit FIFO; only the last is flushed
+    writeInt(n, header, headerLength, flush && count == 0U);
+    for (uint8_t i = 0U; i < count; i++)
+        writeInt(n, spans[i].data, spans[i].length, flush && (i + 1U) == count);
+
+#if defined(ENABLE_TRACER)
+    if (n == 1U)
+        tracer.queued(txWrittenInt(n));
+#endif
+}
+
+/* Adds a received frame to the batch, if batching is enabled, otherwise writes it. */
+
+void SerialPort::writeBatched(const uint8_t* header, uint8_t headerLength, const SerialSpan* spans, uint8_t count, bool data)
+{
+    uint16_t length = headerLength;
+    for (uint8_t i = 0U; i < count; i++)
+        length += spans[i].length;
+
+    // frames too big to batch are written alone (after any frames already batched)
+    if (m_batchTimeout == 0U || length > SERIAL_BATCH_LEN - SERIAL_BATCH_HEADER_LEN) {
+#if defined(ENABLE_TRACER)
+        // the frames already batched are written first, so the next write to the UART is this frame
+        flushBatch();
+        if (data)
+            tracer.frame();
+#endif
+        writeInt(1U, header, headerLength, spans, count);
+        return;
+    }
+
+    if (m_batchLen + length > SERIAL_BATCH_LEN)
+        flushBatch();
+
+#if defined(ENABLE_TRACER)
+    // the traced frame is enqueued when the batch holding it is written
+    if (data)
+        tracer.frame();
+#endif
+
+    // the flush deadline runs from the first frame batched
+    if (m_batchLen == 0U) {
+        m_batchLen = SERIAL_BATCH_HEADER_LEN;
+        m_batchFrames = 0U;
+        m_batchStart = io.getClock();
+    }
+
+    ::memcpy(m_batch + m_batchLen, header, headerLength);
+    m_batchLen += headerLength;
+    for (uint8_t i = 0U; i < count; i++) {
+        ::memcpy(m_batch + m_batchLen, spans[i].data, spans[i].length);
+        m_batchLen += spans[i].length;
+    }
+
+    m_batchFrames++;
+}
+
+/* Writes any batched frames; a single frame is written as is, rather than in a batch. */
+
+void SerialPort::flushBatch()
+{
+    if (m_batchLen == 0U)
+        return;
+
+    // the batch is emptied first, as the writer flushes any batched frames before writing its own
+    uint16_t length = m_batchLen;
+    m_batchLen = 0U;
+
+    SerialSpan frames = { m_batch + SERIAL_BATCH_HEADER_LEN, uint16_t(length - SERIAL_BATCH_HEADER_LEN) };
+    if (m_batchFrames == 1U) {
+        writeInt(1U, NULL, 0U, &frames, 1U);
+        return;
+    }
+
+    m_batch[0U] = DVM_LONG_FRAME_START;
+    m_batch[1U] = (length >> 8) & 0xFFU;
+    m_batch[2U] = (length >> 0) & 0xFFU;
+    m_batch[3U] = CMD_BATCH;
+
+    writeInt(1U, m_batch, SERIAL_BATCH_HEADER_LEN, &frames, 1U);
 }
 
 /* Write modem DSP status. */
@@ -884,7 +1082,7 @@ void SerialPort::getStatus()
 
     // send all sorts of interesting internal values
     reply[0U] = DVM_SHORT_FRAME_START;
-    reply[1U] = 12U;
+    reply[1U] = 14U;
     reply[2U] = CMD_GET_STATUS;
 
     reply[3U] = 0x01U;
@@ -939,7 +1137,12 @@ void SerialPort::getStatus()
     else
         reply[11U] = 0U;
 
-    writeInt(1U, reply, 12);
+    // peak RX ring buffer backlog (in bits) since the last status
+    uint16_t rxPeak = io.getRXPeak();
+    reply[12U] = (rxPeak >> 8) & 0xFFU;
+    reply[13U] = rxPeak & 0xFFU;
+
+    writeInt(1U, reply, 14, NULL, 0U);
 }
 
 /* Write modem DSP version. */
@@ -957,7 +1160,7 @@ void SerialPort::getVersion()
     reply[4U] = io.getCPU();
 
     // Reserve 16 bytes for the UDID
-    ::memcpy(reply + 5U, 0x00U, 16U);
+    ::memset(reply + 5U, 0x00U, 16U);
     io.getUDID(reply + 5U);
 
     uint8_t count = 21U;
@@ -966,9 +1169,145 @@ void SerialPort::getVersion()
 
     reply[1U] = count;
 
-    writeInt(1U, reply, count);
+    writeInt(1U, reply, count, NULL, 0U);
 }
 
+#if defined(ENABLE_PROFILER)
+/* Write modem hot path profile from serial port data. */
+
+uint8_t SerialPort::getProfile(const uint8_t* data, uint8_t length)
+{
+    if (length < 1U)
+        return RSN_ILLEGAL_LENGTH;
+
+    uint8_t probe = data[0U];
+    bool reset = (length >= 2U) && ((data[1U] & 0x01U) == 0x01U);
+
+    // reset all probes
+    if (probe == 0xFFU) {
+        if (!reset)
+            return RSN_INVALID_REQUEST;
+
+        profiler.reset();
+        sendACK();
+        return RSN_OK;
+    }
+
+    if (probe >= PROBE_COUNT)
+        return RSN_INVALID_REQUEST;
+
+    uint8_t reply[54U];
+    ::memset(reply, 0x00U, 54U);
+
+    reply[0U] = DVM_SHORT_FRAME_START;
+    reply[1U] = 54U;
+    reply[2U] = CMD_GET_PROFILE;
+
+    reply[3U] = probe;
+    reply[4U] = PROBE_COUNT;
+    reply[5U] = uint8_t(profiler.getUnit());
+
+    uint32_t values[4U];
+    values[0U] = profiler.getCount(PROFILER_PROBE(probe));
+    values[1U] = profiler.getMin(PROFILER_PROBE(probe));
+    values[2U] = profiler.getMax(PROFILER_PROBE(probe));
+    values[3U] = profiler.getMean(PROFILER_PROBE(probe));
+
+    uint8_t count = 6U;
+    for (uint8_t i = 0U; i < 4U; i++) {
+        reply[count++] = (values[i] >> 24) & 0xFFU;
+        reply[count++] = (values[i] >> 16) & 0xFFU;
+        reply[count++] = (values[i] >> 8) & 0xFFU;
+        reply[count++] = (values[i] >> 0) & 0xFFU;
+    }
+
+    for (uint8_t i = 0U; i < PROFILER_HISTOGRAM_BINS; i++) {
+        uint16_t bin = profiler.getBin(PROFILER_PROBE(probe), i);
+        reply[count++] = (bin >> 8) & 0xFFU;
+        reply[count++] = (bin >> 0) & 0xFFU;
+    }
+
+    if (reset)
+        profiler.reset(PROFILER_PROBE(probe));
+
+    writeInt(1U, reply, count, NULL, 0U);
+    return RSN_OK;
+}
+#endif
+
+#if defined(ENABLE_TRACER)
+/* Write received frame latency trace from serial port data. */
+
+uint8_t SerialPort::getTrace(const uint8_t* data, uint8_t length)
+{
+    if (length < 1U)
+        return RSN_ILLEGAL_LENGTH;
+
+    uint8_t stage = data[0U];
+    bool reset = (length >= 2U) && ((data[1U] & 0x01U) == 0x01U);
+
+    // reset all stages and/or set the sampling interval
+    if (stage == 0xFFU) {
+        if (!reset && length < 3U)
+            return RSN_INVALID_REQUEST;
+
+        if (reset)
+            tracer.reset();
+        if (length >= 3U)
+            tracer.setInterval(data[2U]);
+
+        sendACK();
+        return RSN_OK;
+    }
+
+    if (stage >= TRACE_STAGE_COUNT)
+        return RSN_INVALID_REQUEST;
+
+    uint8_t reply[60U];
+    ::memset(reply, 0x00U, 60U);
+
+    reply[0U] = DVM_SHORT_FRAME_START;
+    reply[1U] = 60U;
+    reply[2U] = CMD_GET_TRACE;
+
+    reply[3U] = stage;
+    reply[4U] = TRACE_STAGE_COUNT;
+    reply[5U] = tracer.getInterval();
+
+    // the latencies are in bit periods of the current modem state
+    uint16_t rate = uint16_t(io.getClockRate());
+    reply[6U] = (rate >> 8) & 0xFFU;
+    reply[7U] = (rate >> 0) & 0xFFU;
+
+    uint32_t values[5U];
+    values[0U] = tracer.getAbandoned();
+    values[1U] = tracer.getCount(TRACER_STAGE(stage));
+    values[2U] = tracer.getMin(TRACER_STAGE(stage));
+    values[3U] = tracer.getMax(TRACER_STAGE(stage));
+    values[4U] = tracer.getMean(TRACER_STAGE(stage));
+
+    uint8_t count = 8U;
+    for (uint8_t i = 0U; i < 5U; i++) {
+        reply[count++] = (values[i] >> 24) & 0xFFU;
+        reply[count++] = (values[i] >> 16) & 0xFFU;
+        reply[count++] = (values[i] >> 8) & 0xFFU;
+        reply[count++] = (values[i] >> 0) & 0xFFU;
+    }
+
+    for (uint8_t i = 0U; i < TRACER_HISTOGRAM_BINS; i++) {
+        uint16_t bin = tracer.getBin(TRACER_STAGE(stage), i);
+        reply[count++] = (bin >> 8) & 0xFFU;
+        reply[count++] = (bin >> 0) & 0xFFU;
+    }
+
+    if (reset)
+        tracer.reset(TRACER_STAGE(stage));
+
+    writeInt(1U, reply, count, NULL, 0U);
+    return RSN_OK;
+}
+#endif
+
 /* Helper to validate the passed modem state is valid. */
 
 uint8_t SerialPort::modemStateCheck(DVM_STATE state)
@@ -1352,3 +1691,170 @@ uint8_t SerialPort::setBuffers(const uint8_t* data, uint8_t length)
 
     return RSN_OK;
 }
+
+/* Sets the DMR color codes or P25 NACs the receivers allow. */
+
+uint8_t SerialPort::setAllowList(const uint8_t* data, uint8_t length)
+{
+    // the allow lists are replaced by the single color code and NAC of CMD_SET_CONFIG, so this follows it
+    if (length < 3U)
+        return RSN_ILLEGAL_LENGTH;
+
+    switch (data[0U]) {
+    case 0x00U:     // DMR; bitmask of the allowed color codes
+        {
+            uint16_t colorCodes = (data[1U] << 8) + (data[2U]);
+            if (colorCodes == 0U)
+                return RSN_INVALID_DMR_CC;
+
+#if defined(DUPLEX)
+            dmrRX.setColorCodes(colorCodes);
+            dmrIdleRX.setColorCodes(colorCodes);
+#endif
+            dmrDMORX.setColorCodes(colorCodes);
+        }
+        break;
+    case 0x01U:     // P25; list of the allowed NACs
+        {
+            if (((length - 1U) % 2U) != 0U)
+                return RSN_ILLEGAL_LENGTH;
+
+            p25RX.setNAC((data[1U] << 8) + (data[2U]));
+            for (uint8_t i = 3U; i < length; i += 2U)
+                p25RX.allowNAC((data[i] << 8) + (data[i + 1U]));
+        }
+        break;
+    default:
+        return RSN_INVALID_REQUEST;
+    }
+
+    return RSN_OK;
+}
+
+/* Write the number of frames the receivers rejected early, by reason. */
+
+void SerialPort::getRejects()
+{
+    // the DMR payload CRC drops and the P25 NID bits corrected follow the reasons the reply started with, so
+    // older hosts can ignore them
+    uint32_t values[6U];
+#if defined(DUPLEX)
+    values[0U] = dmrRX.getRejected() + dmrIdleRX.getRejected() + dmrDMORX.getRejected();
+    values[4U] = dmrRX.getFiltered() + dmrIdleRX.getFiltered() + dmrDMORX.getFiltered();
+#else
+    values[0U] = dmrDMORX.getRejected();
+    values[4U] = dmrDMORX.getFiltered();
+#endif
+    values[1U] = p25RX.getRejected(p25::P25RXR_NID);
+    values[2U] = p25RX.getRejected(p25::P25RXR_NAC);
+    values[3U] = p25RX.getRejected(p25::P25RXR_DUID);
+    values[5U] = p25RX.getNIDCorrected();
+
+    uint8_t reply[27U];
+    reply[0U] = DVM_SHORT_FRAME_START;
+    reply[1U] = 27U;
+    reply[2U] = CMD_GET_REJECTS;
+
+    uint8_t count = 3U;
+    for (uint8_t i = 0U; i < 6U; i++) {
+        reply[count++] = (values[i] >> 24) & 0xFFU;
+        reply[count++] = (values[i] >> 16) & 0xFFU;
+        reply[count++] = (values[i] >> 8) & 0xFFU;
+        reply[count++] = (values[i] >> 0) & 0xFFU;
+    }
+
+    writeInt(1U, reply, count, NULL, 0U);
+}
+
+/* Sets how long received frames may be held back to be batched together. */
+
+uint8_t SerialPort::setBatch(const uint8_t* data, uint8_t length)
+{
+    if (length < 1U)
+        return RSN_ILLEGAL_LENGTH;
+
+    // a deadline of 0 ms turns batching off
+    flushBatch();
+    m_batchTimeout = data[0U];
+
+    return RSN_OK;
+}
+
+/* Sets whether acknowlegements carry the TX FIFO credits, and how often credit events are sent. */
+
+uint8_t SerialPort::setCredits(const uint8_t* data, uint8_t length)
+{
+    if (length < 1U)
+        return RSN_ILLEGAL_LENGTH;
+
+    m_creditAck = (data[0U] & 0x01U) == 0x01U;
+
+    // an event interval of 0 ms (or none given) turns the credit events off
+    m_creditInterval = 0U;
+    if (length >= 2U)
+        m_creditInterval = data[1U];
+
+    m_creditStart = io.getClock();
+    ::memset(m_credits, 0x00U, SERIAL_CREDITS_LEN);
+
+    return RSN_OK;
+}
+
+/* Helper to fill in the free bytes and queued airtime of each TX FIFO. */
+
+void SerialPort::getCredits(uint8_t* credits)
+{
+    // free bytes and queued milliseconds for DMR slot 1, DMR slot 2 (or DMO), P25 and NXDN in turn;
+    // a FIFO that is not in use reports no space
+    uint16_t values[SERIAL_CREDITS_LEN / 2U];
+    ::memset(values, 0x00U, sizeof(values));
+
+    if (m_dmrEnable) {
+#if defined(DUPLEX)
+        if (m_duplex) {
+            values[0U] = dmrTX.getFreeBytes1();
+            values[1U] = dmrTX.getQueuedMs1();
+            values[2U] = dmrTX.getFreeBytes2();
+            values[3U] = dmrTX.getQueuedMs2();
+        } else {
+            values[2U] = dmrDMOTX.getFreeBytes();
+            values[3U] = dmrDMOTX.getQueuedMs();
+        }
+#else
+        values[2U] = dmrDMOTX.getFreeBytes();
+        values[3U] = dmrDMOTX.getQueuedMs();
+#endif
+    }
+
+    if (m_p25Enable) {
+        values[4U] = p25TX.getFreeBytes();
+        values[5U] = p25TX.getQueuedMs();
+    }
+
+    if (m_nxdnEnable) {
+        values[6U] = nxdnTX.getFreeBytes();
+        values[7U] = nxdnTX.getQueuedMs();
+    }
+
+    for (uint8_t i = 0U; i < (SERIAL_CREDITS_LEN / 2U); i++) {
+        credits[i * 2U + 0U] = (values[i] >> 8) & 0xFFU;
+        credits[i * 2U + 1U] = (values[i] >> 0) & 0xFFU;
+    }
+}
+
+/* Write the TX FIFO credits. */
+
+void SerialPort::writeCredits()
+{
+    uint8_t reply[3U + SERIAL_CREDITS_LEN];
+
+    reply[0U] = DVM_SHORT_FRAME_START;
+    reply[1U] = 3U + SERIAL_CREDITS_LEN;
+    reply[2U] = CMD_TX_CREDITS;
+
+    getCredits(reply + 3U);
+    ::memcpy(m_credits, reply + 3U, SERIAL_CREDITS_LEN);
+    m_creditStart = io.getClock();
+
+    writeInt(1U, reply, 3U + SERIAL_CREDITS_LEN, NULL, 0U);
+}
@@ -16,6 +16,8 @@
  * @ingroup hotspot_fw
  * @file SerialSTM.cpp
  * @ingroup hotspot_fw
+ * @file SerialHost.cpp
+ * @ingroup hotspot_fw
  */
 #if !defined(__SERIAL_PORT_H__)
 #define __SERIAL_PORT_H__
@@ -76,14 +78,25 @@ enum DVM_COMMANDS {
     CMD_SET_SYMLVLADJ = 0x04U,          //! Set Symbol Level Adjustments
     CMD_SET_RXLEVEL = 0x05U,            //! Set Rx Level
     CMD_SET_RFPARAMS = 0x06U,           //! (Hotspot) Set RF Parameters
+    CMD_GET_PROFILE = 0x07U,            //! Get Hot Path Profile
 
     CMD_CAL_DATA = 0x08U,               //! Calibration Data
     CMD_RSSI_DATA = 0x09U,              //! RSSI Data
 
     CMD_SEND_CWID = 0x0AU,              //! Send Continous Wave ID (Morse)
 
+    CMD_SET_ALLOW_LIST = 0x0BU,         //! Set Receive Allow List
+    CMD_GET_REJECTS = 0x0CU,            //! Get Receive Reject Counts
+    CMD_BATCH = 0x0DU,                  //! Batch of Frames
+    CMD_SET_BATCH = 0x0EU,              //! Set Batch Flush Deadline
+
     CMD_SET_BUFFERS = 0x0FU,            //! Set FIFO Buffer Lengths
 
+    CMD_SET_CREDITS = 0x10U,            //! Set TX Credit Reporting
+    CMD_TX_CREDITS = 0x11U,             //! TX FIFO Credits
+    CMD_TX_LATE = 0x12U,                //! TX Frame Sent Late
+    CMD_GET_TRACE = 0x13U,              //! Get Received Frame Latency Trace
+
     CMD_DMR_DATA1 = 0x18U,              //! DMR Data Slot 1
     CMD_DMR_LOST1 = 0x19U,              //! DMR Data Lost Slot 1
     CMD_DMR_DATA2 = 0x1AU,              //! DMR Data Slot 2
@@ -155,10 +168,25 @@ enum CMD_REASON_CODE {
 const uint8_t DVM_SHORT_FRAME_START = 0xFEU;
 const uint8_t DVM_LONG_FRAME_START = 0xFDU;
 
+/** @brief Control/flags byte flag of a data command, indicating a 4 byte launch time (bit clock, MSB first) follows. */
+const uint8_t DVM_TX_LAUNCH = 0x80U;
+
 #define SERIAL_FB_LEN 518U
+#define SERIAL_BATCH_LEN 512U
+#define SERIAL_BATCH_HEADER_LEN 4U
+#define SERIAL_CREDITS_LEN 16U
 #define SERIAL_SPEED 115200
 /** @} */
 
+/**
+ * @brief Span of bytes gathered into a frame written to the serial port.
+ * @ingroup hotspot_fw
+ */
+struct SerialSpan {
+    const uint8_t* data;                //! Data
+    uint16_t length;                    //! Length of data
+};
+
 // ---------------------------------------------------------------------------
 //  Class Declaration
 // ---------------------------------------------------------------------------
@@ -212,10 +240,13 @@ public:
 
     /**
      * @brief Write P25 frame data to serial port.
+     * @param flags Frame flags (sync).
      * @param[in] data Data to write.
      * @param length Length of data to write.
+     * @param[in] trailer Trailing metadata (RSSI and BER) to write after the data.
+     * @param trailerLength Length of trailing metadata to write.
      */
-    void writeP25Data(const uint8_t* data, uint16_t length);
+    void writeP25Data(uint8_t flags, const uint8_t* data, uint16_t length, const uint8_t* trailer = NULL, uint8_t trailerLength = 0U);
     /**
      * @brief Write lost P25 frame data to serial port.
      */
@@ -244,6 +275,13 @@ public:
      * @param length Length of data to write.
      */
     void writeRSSIData(const uint8_t* data, uint8_t length);
+    /**
+     * @brief Write a report of a frame sent after its launch time to serial port.
+     * @param cmd Data command the frame was written with.
+     * @param launch Launch time of the frame.
+     * @param start Bit clock the frame was sent at.
+     */
+    void writeTXLate(uint8_t cmd, uint32_t launch, uint32_t start);
 
     /**
      * @brief 
@@ -287,6 +325,17 @@ public:
      */
     void writeDump(const uint8_t* data, uint16_t length);
 
+    /**
+     * @brief Gets the number of frame bytes not written because the transmit FIFO had no space for the frame.
+     * @returns uint32_t Number of bytes dropped.
+     */
+    uint32_t getTXDropped() const { return m_txDropped; }
+    /**
+     * @brief Gets the number of received bytes dropped because the receive FIFO was full.
+     * @returns uint32_t Number of bytes dropped.
+     */
+    uint32_t getRXDropped() { return droppedInt(1U); }
+
 private:
     uint8_t m_buffer[SERIAL_FB_LEN];
     uint16_t m_ptr;
@@ -295,6 +344,28 @@ private:
 
     bool m_debug;
 
+    uint32_t m_txDropped;
+
+    uint8_t m_batch[SERIAL_BATCH_LEN];
+    uint16_t m_batchLen;
+    uint8_t m_batchFrames;
+    uint32_t m_batchStart;
+    uint8_t m_batchTimeout;
+
+    bool m_creditAck;
+    uint8_t m_creditInterval;
+    uint32_t m_creditStart;
+    uint8_t m_credits[SERIAL_CREDITS_LEN];
+
+    /**
+     * @brief Process a complete frame in the frame buffer.
+     */
+    void processFrame();
+    /**
+     * @brief Process a batch of frames from the host, handling each as if it had arrived alone.
+     */
+    void processBatch();
+
     /**
      * @brief Write acknowlegement.
      */
@@ -304,6 +375,14 @@ private:
      * @param err 
      */
     void sendNAK(uint8_t err);
+    /**
+     * @brief Write debug text followed by its values.
+     * @param cmd Debug command.
+     * @param[in] text 
+     * @param[in] values 
+     * @param count Number of values.
+     */
+    void writeDebug(uint8_t cmd, const char* text, const int16_t* values, uint8_t count);
     /**
      * @brief Write modem DSP status.
      */
@@ -312,6 +391,24 @@ private:
      * @brief Write modem DSP version.
      */
     void getVersion();
+#if defined(ENABLE_PROFILER)
+    /**
+     * @brief Write modem hot path profile from serial port data.
+     * @param[in] data Buffer containing profile request frame.
+     * @param length Length of buffer.
+     * @returns uint8_t Reason code.
+     */
+    uint8_t getProfile(const uint8_t* data, uint8_t length);
+#endif
+#if defined(ENABLE_TRACER)
+    /**
+     * @brief Write received frame latency trace from serial port data.
+     * @param[in] data Buffer containing trace request frame.
+     * @param length Length of buffer.
+     * @returns uint8_t Reason code.
+     */
+    uint8_t getTrace(const uint8_t* data, uint8_t length);
+#endif
     /**
      * @brief Helper to validate the passed modem state is valid.
      * @param state 
@@ -351,6 +448,54 @@ private:
      * @returns uint8_t Reason code.
      */
     uint8_t setBuffers(const uint8_t* data, uint8_t length);
+    /**
+     * @brief Sets the DMR color codes or P25 NACs the receivers allow.
+     * @param[in] data Buffer containing allow list frame.
+     * @param length Length of buffer.
+     * @returns uint8_t Reason code.
+     */
+    uint8_t setAllowList(const uint8_t* data, uint8_t length);
+    /**
+     * @brief Write the number of frames the receivers rejected early, by reason, the number of DMR CSBKs
+     *  and data headers dropped as their payload failed its CRC, and the number of P25 NID bits corrected.
+     */
+    void getRejects();
+    /**
+     * @brief Sets how long received frames may be held back to be batched together.
+     * @param[in] data Buffer containing set batch frame.
+     * @param length Length of buffer.
+     * @returns uint8_t Reason code.
+     */
+    uint8_t setBatch(const uint8_t* data, uint8_t length);
+    /**
+     * @brief Sets whether acknowlegements carry the TX FIFO credits, and how often credit events are sent.
+     * @param[in] data Buffer containing set credits frame.
+     * @param length Length of buffer.
+     * @returns uint8_t Reason code.
+     */
+    uint8_t setCredits(const uint8_t* data, uint8_t length);
+    /**
+     * @brief Helper to fill in the free bytes and queued airtime of each TX FIFO.
+     * @param[out] credits Buffer of SERIAL_CREDITS_LEN bytes.
+     */
+    void getCredits(uint8_t* credits);
+    /**
+     * @brief Write the TX FIFO credits.
+     */
+    void writeCredits();
+    /**
+     * @brief Adds a received frame to the batch, if batching is enabled, otherwise writes it.
+     * @param[in] header Frame header.
+     * @param headerLength Length of frame header.
+     * @param[in] spans Payload spans.
+     * @param count Number of payload spans.
+     * @param data Flag indicating the frame is received frame data (rather than a lost frame).
+     */
+    void writeBatched(const uint8_t* header, uint8_t headerLength, const SerialSpan* spans, uint8_t count, bool data = false);
+    /**
+     * @brief Writes any batched frames; a single frame is written as is, rather than in a batch.
+     */
+    void flushBatch();
 
     /**
      * @brief Reads data from the modem flash parititon.
@@ -386,14 +531,59 @@ private:
      * @param n 
      */
     uint8_t readInt(uint8_t n);
+    /**
+     * @brief Gets the received bytes that can be read without wrapping, leaving them in the receive FIFO.
+     * @param n 
+     * @param[out] data Pointer to the first unread byte.
+     * @returns uint16_t Number of contiguous unread bytes.
+     */
+    uint16_t peekInt(uint8_t n, const uint8_t** data);
+    /**
+     * @brief Discards received bytes previously returned by peekInt().
+     * @param n 
+     * @param length Number of bytes to discard.
+     */
+    void consumeInt(uint8_t n, uint16_t length);
+    /**
+     * @brief Gets the number of received bytes dropped because the receive FIFO was full.
+     * @param n 
+     * @returns uint32_t Number of bytes dropped.
+     */
+    uint32_t droppedInt(uint8_t n);
+    /**
+     * @brief Gets the free running count of bytes written to the transmit FIFO.
+     * @param n 
+     * @returns uint16_t Number of bytes written (wraps).
+     */
+    uint16_t txWrittenInt(uint8_t n);
+    /**
+     * @brief Gets the free running count of bytes the UART has taken from the transmit FIFO.
+     * @param n 
+     * @returns uint16_t Number of bytes sent (wraps).
+     */
+    uint16_t txSentInt(uint8_t n);
     /**
      * @brief 
      * @param n
      * @param[in] data 
      * @param length
      * @param flush 
+     * @returns uint16_t Number of bytes accepted by the transmit FIFO.
+     */
+    uint16_t writeInt(uint8_t n, const uint8_t* data, uint16_t length, bool flush = false);
+    /**
+     * @brief Writes a frame header followed by its payload spans, without assembling the frame first.
+     * 
+     * The frame is written whole or not at all; if the transmit FIFO doesn't have space for all of it, its
+     * bytes are counted as dropped rather than a truncated frame being sent.
+     * @param n 
+     * @param[in] header Frame header.
+     * @param headerLength Length of frame header.
+     * @param[in] spans Payload spans.
+     * @param count Number of payload spans.
+     * @param flush 
      */
-    void writeInt(uint8_t n, const uint8_t* data, uint16_t length, bool flush = false);
+    void writeInt(uint8_t n, const uint8_t* header, uint8_t headerLength, const SerialSpan* spans, uint8_t count, bool flush = false);
 };
 
 #endif // __SERIAL_PORT_H__
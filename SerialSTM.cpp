@@ -188,7 +188,7 @@ void SerialPort::flashRead()
 
     ::memcpy(reply + 3U, (void*)STM32_CNF_PAGE, 246U);
 
-    writeInt(1U, reply, 249U);
+    writeInt(1U, reply, 249U, NULL, 0U);
 }
 
 /* Writes data to the modem flash partition. */
@@ -262,7 +262,7 @@ int SerialPort::availableInt(uint8_t n)
     case 1U:
         return m_USART1.available();
     case 3U:
-        m_USART2.available();
+        return m_USART2.available();
     default:
         return 0;
     }
@@ -297,24 +297,99 @@ uint8_t SerialPort::readInt(uint8_t n)
 }
 
 
+/* Gets the received bytes that can be read without wrapping, leaving them in the receive FIFO. */
+
+uint16_t SerialPort::peekInt(uint8_t n, const uint8_t** data)
+{
+    switch (n) {
+    case 1U:
+        return m_USART1.peek(data);
+    case 3U:
+        return m_USART2.peek(data);
+    default:
+        return 0U;
+    }
+}
+
+/* Discards received bytes previously returned by peekInt(). */
+
+void SerialPort::consumeInt(uint8_t n, uint16_t length)
+{
+    switch (n) {
+    case 1U:
+        m_USART1.consume(length);
+        break;
+    case 3U:
+        m_USART2.consume(length);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Gets the number of received bytes dropped because the receive FIFO was full. */
+
+uint32_t SerialPort::droppedInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        return m_USART1.getRXDropped();
+    case 3U:
+        return m_USART2.getRXDropped();
+    default:
+        return 0U;
+    }
+}
+
+/* Gets the free running count of bytes written to the transmit FIFO. */
+
+uint16_t SerialPort::txWrittenInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        return m_USART1.getTXWritten();
+    case 3U:
+        return m_USART2.getTXWritten();
+    default:
+        return 0U;
+    }
+}
+
+/* Gets the free running count of bytes the UART has taken from the transmit FIFO. */
+
+uint16_t SerialPort::txSentInt(uint8_t n)
+{
+    switch (n) {
+    case 1U:
+        return m_USART1.getTXSent();
+    case 3U:
+        return m_USART2.getTXSent();
+    default:
+        return 0U;
+    }
+}
+
 /* */
 
-void SerialPort::writeInt(uint8_t n, const uint8_t* data, uint16_t length, bool flush)
+uint16_t SerialPort::writeInt(uint8_t n, const uint8_t* data, uint16_t length, bool flush)
 {
+    uint16_t written = 0U;
     switch (n) {
     case 1U:
-        m_USART1.write(data, length);
+        written = m_USART1.write(data, length);
         if (flush)
             m_USART1.flush();
         break;
     case 3U:
-        m_USART2.write(data, length);
+        written = m_USART2.write(data, length);
         if (flush)
             m_USART2.flush();
         break;
     default:
         break;
     }
+
+    return written;
 }
 
 #endif
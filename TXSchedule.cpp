@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "TXSchedule.h"
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the TXSchedule class. */
+
+TXSchedule::TXSchedule(uint8_t cmd) :
+    m_cmd(cmd),
+    m_launch(),
+    m_frame(),
+    m_head(0U),
+    m_count(0U),
+    m_in(0U),
+    m_out(0U),
+    m_late(0U)
+{
+    /* stub */
+}
+
+/* Helper to take the launch time from the front of a data command, if it has one. */
+
+bool TXSchedule::getLaunch(const uint8_t*& data, uint16_t& length, uint32_t& launch)
+{
+    if (length < 5U || (data[0U] & DVM_TX_LAUNCH) != DVM_TX_LAUNCH)
+        return false;
+
+    launch = (uint32_t(data[1U]) << 24) | (uint32_t(data[2U]) << 16) | (uint32_t(data[3U]) << 8) | data[4U];
+
+    // the frame follows the launch time, as it otherwise follows the control/flags byte
+    data += 4U;
+    length -= 4U;
+    return true;
+}
+
+/* Helper to reset the schedule, when the FIFO is reset. */
+
+void TXSchedule::reset()
+{
+    m_head = 0U;
+    m_count = 0U;
+    m_in = 0U;
+    m_out = 0U;
+}
+
+/* Counts a frame queued in the FIFO. */
+
+void TXSchedule::put(bool timed, uint32_t launch)
+{
+    if (timed && m_count < TX_SCHEDULE_LEN) {
+        uint8_t n = (m_head + m_count) % TX_SCHEDULE_LEN;
+        m_launch[n] = launch;
+        m_frame[n] = m_in;
+        m_count++;
+    }
+
+    m_in++;
+}
+
+/* Flag indicating the next frame launches further away than the given lead. */
+
+bool TXSchedule::isWaiting(uint32_t lead) const
+{
+    uint32_t launch = 0U;
+    if (!peek(launch))
+        return false;
+
+    return int32_t(launch - io.getTXClock()) > int32_t(lead + TX_LAUNCH_MARGIN);
+}
+
+/* Holds the next frame until its launch time, writing fill to the air interface. */
+
+bool TXSchedule::hold(uint8_t pattern, uint32_t hang)
+{
+    uint32_t launch = 0U;
+    if (!peek(launch))
+        return false;
+
+    // the fill is whole symbols (dibits), so the frame starts on a symbol boundary, up to a bit early
+    int32_t wait = int32_t(launch - io.getTXClock());
+    if (wait < 2)
+        return false;
+
+    // a frame launching beyond the hang isn't held keyed; with nothing written the transmitter runs out and
+    // unkeys, to key up again once isWaiting() clears
+    if (wait > int32_t(hang + TX_LAUNCH_MARGIN))
+        return true;
+
+    uint16_t space = io.getSpace();
+    if (space <= 8U)
+        return true;
+
+    uint32_t bits = uint32_t(wait) & ~0x01U;
+    if (bits > space - 1U)
+        bits = (space - 1U) & ~0x07U;  // keep the fill pattern in phase for the next pass
+
+    uint32_t fill = pattern * 0x01010101U;
+    while (bits > 0U) {
+        uint8_t n = (bits > 32U) ? 32U : uint8_t(bits);
+        io.writeBits(fill >> (32U - n), n);
+        bits -= n;
+    }
+
+    return true;
+}
+
+/* Counts the next frame taken from the FIFO, reporting it if it is late. */
+
+void TXSchedule::take()
+{
+    uint32_t launch = 0U;
+    if (peek(launch)) {
+        m_head = (m_head + 1U) % TX_SCHEDULE_LEN;
+        m_count--;
+
+        // a frame starting a whole symbol or more after its launch time is late
+        uint32_t start = io.getTXClock();
+        if (int32_t(start - launch) >= 2) {
+            m_late++;
+            serial.writeTXLate(m_cmd, launch, start);
+        }
+    }
+
+    m_out++;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to get the launch time of the next frame taken from the FIFO, if it has one. */
+
+bool TXSchedule::peek(uint32_t& launch) const
+{
+    if (m_count == 0U || m_frame[m_head] != m_out)
+        return false;
+
+    launch = m_launch[m_head];
+    return true;
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file TXSchedule.h
+ * @ingroup hotspot_fw
+ * @file TXSchedule.cpp
+ * @ingroup hotspot_fw
+ */
+#if !defined(__TX_SCHEDULE_H__)
+#define __TX_SCHEDULE_H__
+
+#include "Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/** @brief Number of frames with a launch time a transmitter may have queued at once. */
+const uint8_t TX_SCHEDULE_LEN = 8U;
+/** @brief Bit periods a transmitter keys up ahead of its preamble, so the preamble is done before the launch time. */
+const uint16_t TX_LAUNCH_MARGIN = 32U;
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements the launch times of the frames queued in a transmitter FIFO.
+ *
+ *  The launch time is the bit clock (see IO::getClock()) the first bit of the frame goes out on the air
+ *  interface at. Frames are counted in and out of the FIFO, so only the frames with a launch time take an
+ *  entry. A frame starts within one symbol of its launch time; frames that can't are sent as soon as they
+ *  can be, and reported to the host as late. A transmitter isn't kept keyed for a frame launching beyond
+ *  its TX hang; the hang runs out, and the transmitter keys up again ahead of the frame.
+ * @ingroup hotspot_fw
+ */
+class DSP_FW_API TXSchedule {
+public:
+    /**
+     * @brief Initializes a new instance of the TXSchedule class.
+     * @param cmd Data command of the transmitter, reported with late frames.
+     */
+    TXSchedule(uint8_t cmd);
+
+    /**
+     * @brief Helper to take the launch time from the front of a data command, if it has one.
+     * @param[in,out] data Data command (after the frame header); moved past the launch time.
+     * @param[in,out] length Length of the data command; less the launch time.
+     * @param[out] launch Launch time.
+     * @returns bool True, if the data command has a launch time.
+     */
+    static bool getLaunch(const uint8_t*& data, uint16_t& length, uint32_t& launch);
+
+    /**
+     * @brief Helper to reset the schedule, when the FIFO is reset.
+     */
+    void reset();
+
+    /**
+     * @brief Flag indicating there is room for another launch time.
+     * @returns bool True, if a frame with a launch time may be queued.
+     */
+    bool hasSpace() const { return m_count < TX_SCHEDULE_LEN; }
+    /**
+     * @brief Counts a frame queued in the FIFO.
+     * @param timed Flag indicating the frame has a launch time.
+     * @param launch Launch time.
+     */
+    void put(bool timed, uint32_t launch);
+
+    /**
+     * @brief Flag indicating the next frame launches further away than the given lead, so the transmitter
+     *  isn't to key up yet.
+     * @param lead Bit periods the transmitter sends (preamble) before the frame once keyed up.
+     * @returns bool True, if the transmitter is to stay unkeyed.
+     */
+    bool isWaiting(uint32_t lead) const;
+    /**
+     * @brief Holds the next frame until its launch time, writing fill to the air interface.
+     * @details Fill is only written once the frame launches within the given hang; until then the frame
+     *  is held with nothing written, so the transmitter unkeys.
+     * @param pattern Fill byte.
+     * @param hang Bit periods the transmitter may stay keyed ahead of the frame (what is left of the TX
+     *  hang, and the lead to key up again).
+     * @returns bool True, if the next frame is held; false, if it is to be sent now.
+     */
+    bool hold(uint8_t pattern, uint32_t hang);
+    /**
+     * @brief Counts the next frame taken from the FIFO, reporting it if it is late.
+     */
+    void take();
+
+    /**
+     * @brief Gets the number of frames sent late.
+     * @returns uint32_t Number of frames sent late.
+     */
+    uint32_t getLate() const { return m_late; }
+
+private:
+    uint8_t m_cmd;
+
+    uint32_t m_launch[TX_SCHEDULE_LEN];
+    uint16_t m_frame[TX_SCHEDULE_LEN];
+    uint8_t m_head;
+    uint8_t m_count;
+
+    uint16_t m_in;
+    uint16_t m_out;
+
+    uint32_t m_late;
+
+    /**
+     * @brief Helper to get the launch time of the next frame taken from the FIFO, if it has one.
+     * @param[out] launch Launch time.
+     * @returns bool True, if the next frame has a launch time.
+     */
+    bool peek(uint32_t& launch) const;
+};
+
+#endif // __TX_SCHEDULE_H__
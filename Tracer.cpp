@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "Tracer.h"
+
+#if defined(ENABLE_TRACER)
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the Tracer class. */
+
+Tracer::Tracer() :
+    m_interval(TRACER_DEFAULT_INTERVAL),
+    m_syncs(0U),
+    m_state(TRACE_IDLE),
+    m_capture(0U),
+    m_sync(0U),
+    m_queued(0U),
+    m_written(0U),
+    m_abandoned(0U),
+    m_count(),
+    m_min(),
+    m_max(),
+    m_total(),
+    m_histogram()
+{
+    reset();
+}
+
+/* Resets the statistics of all stages, and abandons the traced frame. */
+
+void Tracer::reset()
+{
+    for (uint8_t i = 0U; i < TRACE_STAGE_COUNT; i++)
+        reset(TRACER_STAGE(i));
+
+    m_state = TRACE_IDLE;
+    m_syncs = 0U;
+    m_abandoned = 0U;
+}
+
+/* Resets the statistics of the given stage. */
+
+void Tracer::reset(TRACER_STAGE stage)
+{
+    m_count[stage] = 0U;
+    m_min[stage] = 0xFFFFFFFFU;
+    m_max[stage] = 0U;
+    m_total[stage] = 0U;
+    ::memset(m_histogram[stage], 0x00U, sizeof(m_histogram[stage]));
+}
+
+/* Sets the number of syncs detected per frame traced. */
+
+void Tracer::setInterval(uint8_t interval)
+{
+    m_interval = interval;
+    m_syncs = 0U;
+
+    if (m_interval == 0U)
+        m_state = TRACE_IDLE;
+}
+
+/* Tags the frame whose sync was just detected, if it is sampled. */
+
+void Tracer::sync()
+{
+    // a sync found again within the search window (or the sync of a frame that was never written) moves
+    // the tag along, so the tag stays on the frame written next
+    if (m_state == TRACE_SYNCED) {
+        m_capture = io.getRXClock();
+        m_sync = io.getClock();
+        return;
+    }
+
+    if (m_state != TRACE_IDLE || m_interval == 0U)
+        return;
+
+    if (++m_syncs < m_interval)
+        return;
+
+    m_syncs = 0U;
+    m_capture = io.getRXClock();
+    m_sync = io.getClock();
+    m_state = TRACE_SYNCED;
+}
+
+/* Marks the frame being written to the host as the tagged frame. */
+
+void Tracer::frame()
+{
+    if (m_state == TRACE_SYNCED)
+        m_state = TRACE_FRAMED;
+}
+
+/* Marks the tagged frame as written to the UART transmit FIFO. */
+
+void Tracer::queued(uint16_t written)
+{
+    if (m_state != TRACE_FRAMED)
+        return;
+
+    m_queued = io.getClock();
+    m_written = written;
+    m_state = TRACE_QUEUED;
+}
+
+/* Abandons the tagged frame, as it was dropped for want of space in the transmit FIFO. */
+
+void Tracer::dropped()
+{
+    if (m_state != TRACE_FRAMED)
+        return;
+
+    m_abandoned++;
+    m_state = TRACE_IDLE;
+}
+
+/* Follows the tagged frame; completes it once the UART has taken its last byte. */
+
+void Tracer::process(uint16_t sent)
+{
+    if (m_state == TRACE_IDLE)
+        return;
+
+    uint32_t clock = io.getClock();
+    if (m_state == TRACE_QUEUED) {
+        // the counts are free running, and the FIFO is much smaller than their range
+        if (int16_t(sent - m_written) < 0)
+            return;
+
+        record(TRACE_STAGE_RING, m_sync - m_capture);
+        record(TRACE_STAGE_FRAME, m_queued - m_sync);
+        record(TRACE_STAGE_UART, clock - m_queued);
+        record(TRACE_STAGE_TOTAL, clock - m_capture);
+
+        m_state = TRACE_IDLE;
+        return;
+    }
+
+    if ((clock - m_sync) > io.getClockRate()) {
+        m_abandoned++;
+        m_state = TRACE_IDLE;
+    }
+}
+
+/* Gets the mean latency traced for the given stage. */
+
+uint32_t Tracer::getMean(TRACER_STAGE stage) const
+{
+    if (m_count[stage] == 0U)
+        return 0U;
+
+    return uint32_t(m_total[stage] / m_count[stage]);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Records a latency for the given stage. */
+
+void Tracer::record(TRACER_STAGE stage, uint32_t bits)
+{
+    m_count[stage]++;
+    m_total[stage] += bits;
+
+    if (bits < m_min[stage])
+        m_min[stage] = bits;
+    if (bits > m_max[stage])
+        m_max[stage] = bits;
+
+    // log2 bin; bin n holds 2^(n - 1) <= bits < 2^n
+    uint8_t bin = (bits == 0U) ? 0U : uint8_t(32 - __builtin_clz(bits));
+    if (bin >= TRACER_HISTOGRAM_BINS)
+        bin = TRACER_HISTOGRAM_BINS - 1U;
+
+    if (m_histogram[stage][bin] < 0xFFFFU)
+        m_histogram[stage][bin]++;
+}
+
+#endif // ENABLE_TRACER
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file Tracer.h
+ * @ingroup hotspot_fw
+ * @file Tracer.cpp
+ * @ingroup hotspot_fw
+ */
+#if !defined(__TRACER_H__)
+#define __TRACER_H__
+
+#include "Defines.h"
+
+#if defined(ENABLE_TRACER)
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup hotspot_fw
+ * @{
+ */
+
+/**
+ * @brief Received frame latency stages.
+ */
+enum TRACER_STAGE {
+    TRACE_STAGE_RING = 0U,              //! Bit Capture (IO::interrupt1()) to Sync Detection
+    TRACE_STAGE_FRAME,                  //! Sync Detection to Serial Enqueue (SerialPort::writeInt())
+    TRACE_STAGE_UART,                   //! Serial Enqueue to Last Byte Sent (UART TX FIFO)
+    TRACE_STAGE_TOTAL,                  //! Bit Capture to Last Byte Sent
+
+    TRACE_STAGE_COUNT
+};
+
+/**
+ * @brief Progress of the traced frame.
+ */
+enum TRACER_STATE {
+    TRACE_IDLE = 0U,                    //! No Frame Traced
+    TRACE_SYNCED,                       //! Sync Detected
+    TRACE_FRAMED,                       //! Frame Written (and maybe Batched)
+    TRACE_QUEUED                        //! Frame in the UART TX FIFO
+};
+
+/** @brief Number of log2 histogram bins kept per stage. */
+const uint8_t   TRACER_HISTOGRAM_BINS = 16U;
+/** @brief Number of syncs detected per frame traced, unless set by the host. */
+const uint8_t   TRACER_DEFAULT_INTERVAL = 8U;
+/** @} */
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a received frame latency tracer, keeping min/max/mean and a log2 histogram of
+ *  the time a sampled frame spends in each stage between the air interface and the host.
+ * @details A frame is tagged when its sync is detected; the bit clock the last sync bit was counted
+ *  at by IO::interrupt1() is its capture time. It is then followed until it is written to the UART
+ *  transmit FIFO (after any batching) and until the UART has taken its last byte from the FIFO. All
+ *  times are in bit periods of the air interface bit clock (see IO::getClock()). Only one frame is
+ *  traced at a time; a frame dropped, or not written within a second of its sync, is abandoned.
+ * @ingroup hotspot_fw
+ */
+class DSP_FW_API Tracer {
+public:
+    /**
+     * @brief Initializes a new instance of the Tracer class.
+     */
+    Tracer();
+
+    /**
+     * @brief Resets the statistics of all stages, and abandons the traced frame.
+     */
+    void reset();
+    /**
+     * @brief Resets the statistics of the given stage.
+     * @param stage Latency stage.
+     */
+    void reset(TRACER_STAGE stage);
+
+    /**
+     * @brief Sets the number of syncs detected per frame traced.
+     * @param interval Number of syncs per frame traced (0 stops tracing).
+     */
+    void setInterval(uint8_t interval);
+    /**
+     * @brief Gets the number of syncs detected per frame traced.
+     * @returns uint8_t Number of syncs per frame traced.
+     */
+    uint8_t getInterval() const { return m_interval; }
+
+    /**
+     * @brief Tags the frame whose sync was just detected, if it is sampled.
+     */
+    void sync();
+    /**
+     * @brief Marks the frame being written to the host as the tagged frame.
+     */
+    void frame();
+    /**
+     * @brief Marks the tagged frame as written to the UART transmit FIFO.
+     * @param written Free running count of bytes written to the transmit FIFO, up to the frame's last byte.
+     */
+    void queued(uint16_t written);
+    /**
+     * @brief Abandons the tagged frame, as it was dropped for want of space in the transmit FIFO.
+     */
+    void dropped();
+    /**
+     * @brief Follows the tagged frame; completes it once the UART has taken its last byte.
+     * @param sent Free running count of bytes the UART has taken from the transmit FIFO.
+     */
+    void process(uint16_t sent);
+
+    /**
+     * @brief Gets the number of frames traced through the given stage.
+     * @param stage Latency stage.
+     * @returns uint32_t Number of frames traced.
+     */
+    uint32_t getCount(TRACER_STAGE stage) const { return m_count[stage]; }
+    /**
+     * @brief Gets the shortest latency traced for the given stage.
+     * @param stage Latency stage.
+     * @returns uint32_t Shortest latency in bit periods.
+     */
+    uint32_t getMin(TRACER_STAGE stage) const { return (m_count[stage] > 0U) ? m_min[stage] : 0U; }
+    /**
+     * @brief Gets the longest latency traced for the given stage.
+     * @param stage Latency stage.
+     * @returns uint32_t Longest latency in bit periods.
+     */
+    uint32_t getMax(TRACER_STAGE stage) const { return m_max[stage]; }
+    /**
+     * @brief Gets the mean latency traced for the given stage.
+     * @param stage Latency stage.
+     * @returns uint32_t Mean latency in bit periods.
+     */
+    uint32_t getMean(TRACER_STAGE stage) const;
+    /**
+     * @brief Gets the number of latencies traced in the given histogram bin of the given stage.
+     * @details Bin 0 counts latencies of 0 bit periods, bin n counts latencies of 2^(n - 1) to
+     *  2^n - 1 bit periods; the last bin also counts all longer latencies.
+     * @param stage Latency stage.
+     * @param bin Histogram bin.
+     * @returns uint16_t Number of latencies traced in the histogram bin (saturates).
+     */
+    uint16_t getBin(TRACER_STAGE stage, uint8_t bin) const { return m_histogram[stage][bin]; }
+
+    /**
+     * @brief Gets the number of tagged frames abandoned before they were sent.
+     * @returns uint32_t Number of frames abandoned.
+     */
+    uint32_t getAbandoned() const { return m_abandoned; }
+
+private:
+    uint8_t m_interval;
+    uint8_t m_syncs;
+
+    TRACER_STATE m_state;
+    uint32_t m_capture;
+    uint32_t m_sync;
+    uint32_t m_queued;
+    uint16_t m_written;
+
+    uint32_t m_abandoned;
+
+    uint32_t m_count[TRACE_STAGE_COUNT];
+    uint32_t m_min[TRACE_STAGE_COUNT];
+    uint32_t m_max[TRACE_STAGE_COUNT];
+    ulong64_t m_total[TRACE_STAGE_COUNT];
+    uint16_t m_histogram[TRACE_STAGE_COUNT][TRACER_HISTOGRAM_BINS];
+
+    /**
+     * @brief Records a latency for the given stage.
+     * @param stage Latency stage.
+     * @param bits Latency in bit periods.
+     */
+    void record(TRACER_STAGE stage, uint32_t bits);
+};
+
+#endif // ENABLE_TRACER
+#endif // __TRACER_H__
@@ -6,69 +6,97 @@
  *
  *  Copyright (C) 2015,2020 Jonathan Naylor, G4KLX
  *  Copyright (C) 2017 Andy Uribe, CA6JAU
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Utils.h"
 
+#include <string.h>
+
+#if defined(COUNT_BITS_TABLE)
+
 // ---------------------------------------------------------------------------
 //  Constants/Macros
 // ---------------------------------------------------------------------------
 
-const uint8_t BITS_TABLE[] = {
+const uint8_t BITS_TABLE[256U] = {
 #   define B2(n) n,     n+1,     n+1,     n+2
 #   define B4(n) B2(n), B2(n+1), B2(n+1), B2(n+2)
 #   define B6(n) B4(n), B4(n+1), B4(n+1), B4(n+2)
     B6(0), B6(1), B6(1), B6(2)
 };
 
+#endif // COUNT_BITS_TABLE
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
 
-/* Returns the count of bits in the passed 8 byte value. */
+/* Copies bytes out of a circular bit buffer. */
 
-uint8_t countBits8(uint8_t bits)
+void ringBitsToBytes(const uint8_t* ring, uint16_t length, uint16_t start, uint8_t count, uint8_t* buffer)
 {
-    return BITS_TABLE[bits];
-}
+    uint16_t bytes = length / 8U;
+    uint16_t pos = start >> 3;
+    uint8_t shift = start & 0x07U;
 
-/* Returns the count of bits in the passed 16 byte value. */
+    // byte aligned; copy up to the end of the buffer and then from its start
+    if (shift == 0U) {
+        uint16_t run = bytes - pos;
+        if (run > count)
+            run = count;
 
-uint8_t countBits16(uint16_t bits)
-{
-    uint8_t* p = (uint8_t*)&bits;
-    uint8_t n = 0U;
-    n += BITS_TABLE[p[0U]];
-    n += BITS_TABLE[p[1U]];
-    return n;
+        ::memcpy(buffer, ring + pos, run);
+        ::memcpy(buffer + run, ring, count - run);
+        return;
+    }
+
+    // unaligned; each byte is merged from two, so the byte straddling the end of the buffer is the only
+    // one to wrap
+    uint8_t rshift = 8U - shift;
+    uint16_t run = bytes - pos - 1U;
+    if (run > count)
+        run = count;
+
+    const uint8_t* p = ring + pos;
+    uint8_t i = 0U;
+    for (; i < run; i++, p++)
+        buffer[i] = uint8_t(p[0U] << shift) | (p[1U] >> rshift);
+
+    if (i == count)
+        return;
+
+    buffer[i++] = uint8_t(ring[bytes - 1U] << shift) | (ring[0U] >> rshift);
+
+    p = ring;
+    for (; i < count; i++, p++)
+        buffer[i] = uint8_t(p[0U] << shift) | (p[1U] >> rshift);
 }
 
-/* Returns the count of bits in the passed 32 byte value. */
+/* Steps the PRNG that scrambles the AMBE and IMBE vocoder vectors protected by the first, getting the mask of
+   one vector. */
 
-uint8_t countBits32(uint32_t bits)
+uint32_t vocoderPRNG(uint16_t& p, uint8_t count)
 {
-    uint8_t* p = (uint8_t*)&bits;
-    uint8_t n = 0U;
-    n += BITS_TABLE[p[0U]];
-    n += BITS_TABLE[p[1U]];
-    n += BITS_TABLE[p[2U]];
-    n += BITS_TABLE[p[3U]];
-    return n;
+    uint32_t mask = 0U;
+    for (uint8_t i = 0U; i < count; i++) {
+        p = uint16_t(173U * p + 13849U);
+        mask = (mask << 1) | (p >> 15);
+    }
+
+    return mask;
 }
 
-/* Returns the count of bits in the passed 64 byte value. */
+/* Gets the inverted CRC-CCITT (x^16 + x^12 + x^5 + 1) of a block. */
 
-uint8_t countBits64(uint64_t bits)
+uint16_t crcCCITT162(const uint8_t* in, uint8_t length)
 {
-    uint8_t* p = (uint8_t*)&bits;
-    uint8_t n = 0U;
-    n += BITS_TABLE[p[0U]];
-    n += BITS_TABLE[p[1U]];
-    n += BITS_TABLE[p[2U]];
-    n += BITS_TABLE[p[3U]];
-    n += BITS_TABLE[p[4U]];
-    n += BITS_TABLE[p[5U]];
-    n += BITS_TABLE[p[6U]];
-    n += BITS_TABLE[p[7U]];
-    return n;
+    uint16_t crc = 0x0000U;
+    for (uint8_t i = 0U; i < length; i++) {
+        crc ^= uint16_t(in[i]) << 8;
+        for (uint8_t j = 0U; j < 8U; j++)
+            crc = (crc & 0x8000U) ? uint16_t((crc << 1) ^ 0x1021U) : uint16_t(crc << 1);
+    }
+
+    return uint16_t(~crc);
 }
@@ -6,6 +6,7 @@
  *
  *  Copyright (C) 2015,2016,2020 Jonathan Naylor, G4KLX
  *  Copyright (C) 2017 Andy Uribe, CA6JAU
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -27,33 +28,142 @@
 
 #include "Defines.h"
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#if defined(__POPCNT__)
+/** @brief The target has a population count instruction; use it through the compiler builtins. */
+#define COUNT_BITS_BUILTIN
+#elif !defined(COUNT_BITS_SWAR)
+/** @brief Count bits with the byte lookup table. */
+#define COUNT_BITS_TABLE
+#endif
+
+#if defined(COUNT_BITS_TABLE)
+/** @brief Count of bits set in each byte value. */
+extern const uint8_t BITS_TABLE[256U];
+#endif
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
 
+// The bit counts are used once per received bit by every sync correlator, so they are inlined. Cortex-M3/M4
+// have no population count instruction (the builtins would call the libgcc table routine), so by default
+// they look up each byte in a table; COUNT_BITS_SWAR selects branchless SWAR counts instead.
+
 /**
  * @brief Returns the count of bits in the passed 8 byte value.
  * @param bits uint8_t to count bits for.
  * @returns uint8_t Count of bits in passed value.
  */
-DSP_FW_API uint8_t countBits8(uint8_t bits);
+inline uint8_t countBits8(uint8_t bits)
+{
+#if defined(COUNT_BITS_TABLE)
+    return BITS_TABLE[bits];
+#elif defined(COUNT_BITS_BUILTIN)
+    return uint8_t(__builtin_popcount(bits));
+#else
+    uint32_t n = bits;
+    n = n - ((n >> 1) & 0x55U);
+    n = (n & 0x33U) + ((n >> 2) & 0x33U);
+    return uint8_t((n + (n >> 4)) & 0x0FU);
+#endif
+}
 /**
  * @brief Returns the count of bits in the passed 16 byte value.
  * @param bits uint16_t to count bits for.
  * @returns uint8_t Count of bits in passed value.
  */
-DSP_FW_API uint8_t countBits16(uint16_t bits);
+inline uint8_t countBits16(uint16_t bits)
+{
+#if defined(COUNT_BITS_TABLE)
+    return BITS_TABLE[bits & 0xFFU] + BITS_TABLE[bits >> 8];
+#elif defined(COUNT_BITS_BUILTIN)
+    return uint8_t(__builtin_popcount(bits));
+#else
+    uint32_t n = bits;
+    n = n - ((n >> 1) & 0x5555U);
+    n = (n & 0x3333U) + ((n >> 2) & 0x3333U);
+    n = (n + (n >> 4)) & 0x0F0FU;
+    return uint8_t((n + (n >> 8)) & 0x1FU);
+#endif
+}
 /**
  * @brief Returns the count of bits in the passed 32 byte value.
  * @param bits uint32_t to count bits for.
  * @returns uint8_t Count of bits in passed value.
  */
-DSP_FW_API uint8_t countBits32(uint32_t bits);
+inline uint8_t countBits32(uint32_t bits)
+{
+#if defined(COUNT_BITS_TABLE)
+    return BITS_TABLE[bits & 0xFFU] + BITS_TABLE[(bits >> 8) & 0xFFU] +
+        BITS_TABLE[(bits >> 16) & 0xFFU] + BITS_TABLE[bits >> 24];
+#elif defined(COUNT_BITS_BUILTIN)
+    return uint8_t(__builtin_popcount(bits));
+#else
+    bits = bits - ((bits >> 1) & 0x55555555U);
+    bits = (bits & 0x33333333U) + ((bits >> 2) & 0x33333333U);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0FU;
+    return uint8_t((bits * 0x01010101U) >> 24);
+#endif
+}
 /**
  * @brief Returns the count of bits in the passed 64 byte value.
  * @param bits ulong64_t to count bits for.
  * @returns uint8_t Count of bits in passed value.
  */
-DSP_FW_API uint8_t countBits64(ulong64_t bits);
+inline uint8_t countBits64(ulong64_t bits)
+{
+#if defined(COUNT_BITS_TABLE)
+    return countBits32(uint32_t(bits)) + countBits32(uint32_t(bits >> 32));
+#elif defined(COUNT_BITS_BUILTIN)
+    return uint8_t(__builtin_popcountll(bits));
+#else
+    uint32_t lo = uint32_t(bits);
+    uint32_t hi = uint32_t(bits >> 32);
+    lo = lo - ((lo >> 1) & 0x55555555U);
+    hi = hi - ((hi >> 1) & 0x55555555U);
+    lo = (lo & 0x33333333U) + ((lo >> 2) & 0x33333333U);
+    hi = (hi & 0x33333333U) + ((hi >> 2) & 0x33333333U);
+
+    // each byte of either half counts at most 8 bits, so the halves can be summed before the multiply
+    uint32_t n = ((lo + (lo >> 4)) & 0x0F0F0F0FU) + ((hi + (hi >> 4)) & 0x0F0F0F0FU);
+    return uint8_t((n * 0x01010101U) >> 24);
+#endif
+}
+
+/**
+ * @brief Copies bytes out of a circular bit buffer.
+ * @details Byte aligned runs are copied directly and unaligned runs are shift merged a byte at a time; the
+ *  wraparound of the circular buffer is handled once per call rather than per bit.
+ * @param[in] ring Circular bit buffer (packed, MSB first).
+ * @param length Length of the circular bit buffer in bits (a multiple of 8).
+ * @param start Bit position of the first bit to copy.
+ * @param count Number of bytes to copy (less than length / 8).
+ * @param[out] buffer Buffer to copy the bytes to.
+ */
+DSP_FW_API void ringBitsToBytes(const uint8_t* ring, uint16_t length, uint16_t start, uint8_t count, uint8_t* buffer);
+
+/**
+ * @brief Steps the PRNG that scrambles the AMBE and IMBE vocoder vectors protected by the first, getting the
+ *  mask of one vector.
+ * @details p(n + 1) = (173 * p(n) + 13849) mod 65536, seeded with p(0) = 16 * the 12 data bits of the first
+ *  vector (the AMBE A vector, or IMBE u0); each step gives one mask bit, the top bit of p(n + 1). The vectors
+ *  scrambled follow on from each other in the one sequence.
+ * @param[in,out] p PRNG state.
+ * @param count Number of mask bits (up to 32).
+ * @returns uint32_t Mask, first bit in the most significant bit.
+ */
+DSP_FW_API uint32_t vocoderPRNG(uint16_t& p, uint8_t count);
+
+/**
+ * @brief Gets the inverted CRC-CCITT (x^16 + x^12 + x^5 + 1) of a block.
+ * @param[in] in Block to get the CRC of.
+ * @param length Length of the block in bytes.
+ * @returns uint16_t CRC, sent most significant byte first.
+ */
+DSP_FW_API uint16_t crcCCITT162(const uint8_t* in, uint8_t length);
 
 #endif // __UTILS_H__
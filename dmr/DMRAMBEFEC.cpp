@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "dmr/DMRAMBEFEC.h"
+#include "Golay24128.h"
+#include "Utils.h"
+
+using namespace dmr;
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t AMBE_FRAMES = 3U;
+const uint8_t AMBE_A_LENGTH_BITS = 24U;
+const uint8_t AMBE_B_LENGTH_BITS = 23U;
+
+// the second frame straddles the sync (or embedded signalling); its first 36 bits end the first half of the
+// burst and its last 36 bits start the second half
+const uint8_t AMBE_SPLIT_POS = 36U;
+const uint16_t AMBE_FRAME_OFFSETS[AMBE_FRAMES][2U] = { { 0U, 0U }, { 72U, 120U }, { 192U, 192U } };
+
+// bit positions of the A and B vectors within a 72 bit AMBE frame (MSB first)
+const uint8_t AMBE_A_TABLE[] = {
+    0U, 4U, 8U, 12U, 16U, 20U, 24U, 28U, 32U, 36U, 40U, 44U, 48U, 52U, 56U, 60U, 64U, 68U,
+    1U, 5U, 9U, 13U, 17U, 21U };
+const uint8_t AMBE_B_TABLE[] = {
+    25U, 29U, 33U, 37U, 41U, 45U, 49U, 53U, 57U, 61U, 65U, 69U,
+    2U, 6U, 10U, 14U, 18U, 22U, 26U, 30U, 34U, 38U, 42U };
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the DMRAMBEFEC class. */
+
+DMRAMBEFEC::DMRAMBEFEC()
+{
+    /* stub */
+}
+
+/* Gets the count of bits corrected in the A and B vectors of the AMBE frames of a voice burst. */
+
+uint8_t DMRAMBEFEC::getErrors(const uint8_t* frame) const
+{
+    uint8_t errors = 0U;
+    for (uint8_t n = 0U; n < AMBE_FRAMES; n++) {
+        const uint16_t* offsets = AMBE_FRAME_OFFSETS[n];
+
+        uint32_t a = 0U;
+        for (uint8_t i = 0U; i < AMBE_A_LENGTH_BITS; i++) {
+            uint8_t pos = AMBE_A_TABLE[i];
+            a = (a << 1) | _READ_BIT(frame, pos + offsets[pos < AMBE_SPLIT_POS ? 0U : 1U]);
+        }
+
+        uint32_t b = 0U;
+        for (uint8_t i = 0U; i < AMBE_B_LENGTH_BITS; i++) {
+            uint8_t pos = AMBE_B_TABLE[i];
+            b = (b << 1) | _READ_BIT(frame, pos + offsets[pos < AMBE_SPLIT_POS ? 0U : 1U]);
+        }
+
+        uint8_t errs = 0U;
+        uint32_t data = Golay24128::decode24128(a, errs);
+        errors += errs;
+
+        // the B vector is scrambled by the A vector data; an uncorrectable A vector shows up as B errors too
+        uint16_t p = uint16_t(data << 4);
+        Golay24128::decode23127(b ^ vocoderPRNG(p, AMBE_B_LENGTH_BITS), errs);
+        errors += errs;
+    }
+
+    return errors;
+}
+
+#if defined(HOST_SIM)
+/* Regenerates the A and B vectors of the AMBE frames of a voice burst from their data bits. */
+
+void DMRAMBEFEC::encode(uint8_t* frame) const
+{
+    for (uint8_t n = 0U; n < AMBE_FRAMES; n++) {
+        const uint16_t* offsets = AMBE_FRAME_OFFSETS[n];
+
+        uint32_t a = 0U;
+        for (uint8_t i = 0U; i < AMBE_A_LENGTH_BITS; i++) {
+            uint8_t pos = AMBE_A_TABLE[i];
+            a = (a << 1) | _READ_BIT(frame, pos + offsets[pos < AMBE_SPLIT_POS ? 0U : 1U]);
+        }
+
+        uint32_t b = 0U;
+        for (uint8_t i = 0U; i < AMBE_B_LENGTH_BITS; i++) {
+            uint8_t pos = AMBE_B_TABLE[i];
+            b = (b << 1) | _READ_BIT(frame, pos + offsets[pos < AMBE_SPLIT_POS ? 0U : 1U]);
+        }
+
+        // keep the data bits as they are, and replace the parity
+        uint32_t dataA = (a >> 12) & 0xFFFU;
+        uint16_t p = uint16_t(dataA << 4);
+        a = Golay24128::encode24128(dataA);
+        b = Golay24128::encode23127((b >> 11) & 0xFFFU) ^ vocoderPRNG(p, AMBE_B_LENGTH_BITS);
+
+        for (uint8_t i = 0U; i < AMBE_A_LENGTH_BITS; i++) {
+            uint8_t pos = AMBE_A_TABLE[i];
+            bool set = ((a >> (AMBE_A_LENGTH_BITS - 1U - i)) & 0x01U) != 0U;
+            _WRITE_BIT(frame, pos + offsets[pos < AMBE_SPLIT_POS ? 0U : 1U], set);
+        }
+
+        for (uint8_t i = 0U; i < AMBE_B_LENGTH_BITS; i++) {
+            uint8_t pos = AMBE_B_TABLE[i];
+            bool set = ((b >> (AMBE_B_LENGTH_BITS - 1U - i)) & 0x01U) != 0U;
+            _WRITE_BIT(frame, pos + offsets[pos < AMBE_SPLIT_POS ? 0U : 1U], set);
+        }
+    }
+}
+#endif
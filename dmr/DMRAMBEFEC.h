@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file DMRAMBEFEC.h
+ * @ingroup dmr_hfw
+ * @file DMRAMBEFEC.cpp
+ * @ingroup dmr_hfw
+ */
+#if !defined(__DMR_AMBE_FEC_H__)
+#define __DMR_AMBE_FEC_H__
+
+#include "Defines.h"
+#include "dmr/DMRDefines.h"
+
+namespace dmr
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the FEC check of the three AMBE+2 (3600x2450) vocoder frames carried by a DMR voice
+     *  burst; each frame protects its A vector with Golay (24,12) and its PRNG scrambled B vector with
+     *  Golay (23,12), the C vector is unprotected.
+     * @ingroup dmr_hfw
+     */
+    class DSP_FW_API DMRAMBEFEC {
+    public:
+        /**
+         * @brief Initializes a new instance of the DMRAMBEFEC class.
+         */
+        DMRAMBEFEC();
+
+        /**
+         * @brief Gets the count of bits corrected in the A and B vectors of the AMBE frames of a voice burst.
+         * @param[in] frame DMR burst.
+         * @returns uint8_t Count of bits corrected, of the 141 FEC protected bits (at most 21).
+         */
+        uint8_t getErrors(const uint8_t* frame) const;
+#if defined(HOST_SIM)
+        /**
+         * @brief Regenerates the A and B vectors of the AMBE frames of a voice burst from their data bits.
+         * @param[in,out] frame DMR burst.
+         */
+        void encode(uint8_t* frame) const;
+#endif
+    };
+} // namespace dmr
+
+#endif // __DMR_AMBE_FEC_H__
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "dmr/DMRBPTC.h"
+#include "Utils.h"
+
+using namespace dmr;
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t BPTC_ROWS = 13U;
+const uint8_t BPTC_DATA_ROWS = 9U;
+const uint16_t BPTC_LENGTH_BITS = 196U;
+const uint16_t BPTC_HALF_LENGTH_BITS = BPTC_LENGTH_BITS / 2U;
+
+// the second half of the payload follows the slot type, sync and slot type (68 bits)
+const uint16_t BPTC_SECOND_HALF_OFFSET = DMR_FRAME_LENGTH_BITS - BPTC_LENGTH_BITS;
+
+// interleaving; bit n of the matrix is sent as bit (n * 181) % 196 of the payload
+const uint16_t BPTC_INTERLEAVE_STEP = 181U;
+
+const uint8_t BPTC_MAX_PASSES = 5U;
+
+// Hamming (15,11) row checks (column 0 in bit 14; each mask includes its check bit), and the bit corrected
+// for each syndrome
+const uint16_t ROW_CHECK_MASKS[] = { 0x7AC8U, 0x3D64U, 0x1EB2U, 0x7591U };
+const uint16_t ROW_CORRECTION[] = {
+    0x0000U, 0x0008U, 0x0004U, 0x0040U, 0x0002U, 0x0200U, 0x0020U, 0x0800U, 0x0001U, 0x4000U, 0x0100U, 0x2000U,
+    0x0010U, 0x0080U, 0x0400U, 0x1000U };
+
+// Hamming (13,9) column checks; the row corrected for each syndrome (0xFF for none)
+const uint8_t COLUMN_CORRECTION[] = {
+    0xFFU, 0x09U, 0x0AU, 0x06U, 0x0BU, 0x03U, 0x07U, 0x01U, 0x0CU, 0xFFU, 0x04U, 0xFFU, 0x08U, 0x05U, 0x02U, 0x00U };
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the DMRBPTC class. */
+
+DMRBPTC::DMRBPTC()
+{
+    /* stub */
+}
+
+/* Decodes the BPTC (196,96) payload of a burst. */
+
+void DMRBPTC::decode(const uint8_t* frame, uint8_t* data) const
+{
+    // deinterleave into the matrix (bit 0 of the payload is unused)
+    uint16_t rows[BPTC_ROWS];
+    ::memset(rows, 0x00U, sizeof(rows));
+
+    uint16_t n = 0U;
+    for (uint8_t r = 0U; r < BPTC_ROWS; r++) {
+        for (uint16_t bit = 0x4000U; bit != 0U; bit >>= 1) {
+            n += BPTC_INTERLEAVE_STEP;
+            if (n >= BPTC_LENGTH_BITS)
+                n -= BPTC_LENGTH_BITS;
+
+            uint16_t pos = (n < BPTC_HALF_LENGTH_BITS) ? n : (n + BPTC_SECOND_HALF_OFFSET);
+            if (_READ_BIT(frame, pos))
+                rows[r] |= bit;
+        }
+    }
+
+    errorCheck(rows);
+
+    // the payload is in columns 3 - 10 of row 0 and 0 - 10 of rows 1 - 8
+    uint32_t acc = (rows[0U] >> 4) & 0xFFU;
+    uint8_t bits = 8U;
+    uint8_t pos = 0U;
+    for (uint8_t r = 1U; r < BPTC_DATA_ROWS; r++) {
+        acc = (acc << 11) | ((rows[r] >> 4) & 0x7FFU);
+        bits += 11U;
+
+        while (bits >= 8U) {
+            bits -= 8U;
+            data[pos++] = uint8_t(acc >> bits);
+        }
+    }
+}
+
+/* Decodes the BPTC (196,96) payload of a burst and checks its CRC. */
+
+bool DMRBPTC::validate(const uint8_t* frame, uint8_t dataType) const
+{
+    uint16_t mask;
+    switch (dataType) {
+    case DT_CSBK:
+        mask = DMR_CSBK_CRC_MASK;
+        break;
+    case DT_DATA_HEADER:
+        mask = DMR_DATA_HEADER_CRC_MASK;
+        break;
+    default:
+        return true;
+    }
+
+    uint8_t data[DMR_BPTC_DATA_LENGTH_BYTES];
+    decode(frame, data);
+
+    uint16_t crc = crcCCITT162(data, DMR_BPTC_DATA_LENGTH_BYTES - 2U) ^ mask;
+    return data[10U] == uint8_t(crc >> 8) && data[11U] == uint8_t(crc & 0xFFU);
+}
+
+#if defined(HOST_SIM)
+/* Encodes the BPTC (196,96) payload of a burst. */
+
+void DMRBPTC::encode(const uint8_t* data, uint8_t* frame) const
+{
+    uint16_t rows[BPTC_ROWS];
+    ::memset(rows, 0x00U, sizeof(rows));
+
+    // payload, then the row checks of the data rows
+    uint32_t acc = data[0U];
+    uint8_t bits = 0U;
+    uint8_t pos = 1U;
+    rows[0U] = uint16_t(data[0U]) << 4;
+    for (uint8_t r = 1U; r < BPTC_DATA_ROWS; r++) {
+        while (bits < 11U) {
+            acc = (acc << 8) | data[pos++];
+            bits += 8U;
+        }
+
+        bits -= 11U;
+        rows[r] = uint16_t(((acc >> bits) & 0x7FFU) << 4);
+    }
+
+    for (uint8_t r = 0U; r < BPTC_DATA_ROWS; r++) {
+        for (uint8_t k = 0U; k < 4U; k++) {
+            if (countBits16(rows[r] & ROW_CHECK_MASKS[k]) & 0x01U)
+                rows[r] |= 0x08U >> k;
+        }
+    }
+
+    // column checks, for all 15 columns at once
+    rows[9U] = rows[0U] ^ rows[1U] ^ rows[3U] ^ rows[5U] ^ rows[6U];
+    rows[10U] = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[4U] ^ rows[6U] ^ rows[7U];
+    rows[11U] = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[5U] ^ rows[7U] ^ rows[8U];
+    rows[12U] = rows[0U] ^ rows[2U] ^ rows[4U] ^ rows[5U] ^ rows[8U];
+
+    // interleave
+    _WRITE_BIT(frame, 0U, false);
+
+    uint16_t n = 0U;
+    for (uint8_t r = 0U; r < BPTC_ROWS; r++) {
+        for (uint16_t bit = 0x4000U; bit != 0U; bit >>= 1) {
+            n += BPTC_INTERLEAVE_STEP;
+            if (n >= BPTC_LENGTH_BITS)
+                n -= BPTC_LENGTH_BITS;
+
+            uint16_t pos = (n < BPTC_HALF_LENGTH_BITS) ? n : (n + BPTC_SECOND_HALF_OFFSET);
+            _WRITE_BIT(frame, pos, (rows[r] & bit) != 0U);
+        }
+    }
+}
+#endif
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Corrects the matrix; alternating column and row passes, until a pass corrects nothing. */
+
+void DMRBPTC::errorCheck(uint16_t* rows) const
+{
+    for (uint8_t pass = 0U; pass < BPTC_MAX_PASSES; pass++) {
+        bool fixing = false;
+
+        // column syndromes, for all 15 columns at once
+        uint16_t s0 = rows[0U] ^ rows[1U] ^ rows[3U] ^ rows[5U] ^ rows[6U] ^ rows[9U];
+        uint16_t s1 = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[4U] ^ rows[6U] ^ rows[7U] ^ rows[10U];
+        uint16_t s2 = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[5U] ^ rows[7U] ^ rows[8U] ^ rows[11U];
+        uint16_t s3 = rows[0U] ^ rows[2U] ^ rows[4U] ^ rows[5U] ^ rows[8U] ^ rows[12U];
+
+        uint16_t errs = s0 | s1 | s2 | s3;
+        for (uint16_t bit = 0x4000U; errs != 0U; bit >>= 1) {
+            if (!(errs & bit))
+                continue;
+
+            errs &= ~bit;
+
+            uint8_t syndrome = ((s0 & bit) ? 0x01U : 0x00U) | ((s1 & bit) ? 0x02U : 0x00U) |
+                ((s2 & bit) ? 0x04U : 0x00U) | ((s3 & bit) ? 0x08U : 0x00U);
+            uint8_t r = COLUMN_CORRECTION[syndrome];
+            if (r != 0xFFU) {
+                rows[r] ^= bit;
+                fixing = true;
+            }
+        }
+
+        // rows carrying the payload
+        for (uint8_t r = 0U; r < BPTC_DATA_ROWS; r++) {
+            uint8_t syndrome = 0U;
+            for (uint8_t k = 0U; k < 4U; k++)
+                syndrome |= uint8_t((countBits16(rows[r] & ROW_CHECK_MASKS[k]) & 0x01U) << k);
+
+            if (syndrome != 0U) {
+                rows[r] ^= ROW_CORRECTION[syndrome];
+                fixing = true;
+            }
+        }
+
+        if (!fixing)
+            break;
+    }
+}
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file DMRBPTC.h
+ * @ingroup dmr_hfw
+ * @file DMRBPTC.cpp
+ * @ingroup dmr_hfw
+ */
+#if !defined(__DMR_BPTC_H__)
+#define __DMR_BPTC_H__
+
+#include "Defines.h"
+#include "dmr/DMRDefines.h"
+
+namespace dmr
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the DMR BPTC (196,96) block product turbo code; a 13 x 15 matrix of Hamming (15,11)
+     *  rows and Hamming (13,9) columns, interleaved around the slot type and sync of a burst.
+     * @ingroup dmr_hfw
+     */
+    class DSP_FW_API DMRBPTC {
+    public:
+        /**
+         * @brief Initializes a new instance of the DMRBPTC class.
+         */
+        DMRBPTC();
+
+        /**
+         * @brief Decodes the BPTC (196,96) payload of a burst.
+         * @param[in] frame DMR burst.
+         * @param[out] data 12 byte payload.
+         */
+        void decode(const uint8_t* frame, uint8_t* data) const;
+        /**
+         * @brief Decodes the BPTC (196,96) payload of a burst and checks its CRC, for the data types that
+         *  carry a CRC checked payload (CSBKs and data headers).
+         * @param[in] frame DMR burst.
+         * @param dataType Data type of the burst (from the slot type).
+         * @returns bool True, if the payload CRC is valid (or the data type isn't checked), otherwise false.
+         */
+        bool validate(const uint8_t* frame, uint8_t dataType) const;
+#if defined(HOST_SIM)
+        /**
+         * @brief Encodes the BPTC (196,96) payload of a burst.
+         * @param[in] data 12 byte payload.
+         * @param[out] frame DMR burst; the slot type and sync are left as they are.
+         */
+        void encode(const uint8_t* data, uint8_t* frame) const;
+#endif
+
+    private:
+        /**
+         * @brief Corrects the matrix; alternating column and row passes, until a pass corrects nothing (or
+         *  after at most 5 passes).
+         * @param[in,out] rows Matrix rows (column 0 in bit 14).
+         */
+        void errorCheck(uint16_t* rows) const;
+    };
+} // namespace dmr
+
+#endif // __DMR_BPTC_H__
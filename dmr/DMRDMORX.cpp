@@ -11,7 +11,10 @@
  */
 #include "Globals.h"
 #include "dmr/DMRDMORX.h"
+#include "dmr/DMRAMBEFEC.h"
+#include "dmr/DMRBPTC.h"
 #include "dmr/DMRSlotType.h"
+#include "dmr/DMRSync.h"
 #include "Utils.h"
 
 using namespace dmr;
@@ -29,6 +32,7 @@ const uint16_t NOENDPTR = 9999U;
 const uint8_t CONTROL_NONE  = 0x00U;
 const uint8_t CONTROL_VOICE = 0x20U;
 const uint8_t CONTROL_DATA  = 0x40U;
+const uint8_t CONTROL_REJECT = 0x80U;
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -43,12 +47,16 @@ DMRDMORX::DMRDMORX() :
     m_syncPtr(0U),
     m_startPtr(0U),
     m_endPtr(NOENDPTR),
+    m_slotTypePtr(NOENDPTR),
     m_control(CONTROL_NONE),
     m_syncCount(0U),
-    m_colorCode(0U),
+    m_colorCodes(0x0001U),
+    m_dataType(0U),
     m_state(DMORXS_NONE),
     m_n(0U),
-    m_type(0U)
+    m_type(0U),
+    m_filtered(0U),
+    m_rejected(0U)
 {
     /* stub */
 }
@@ -63,12 +71,15 @@ void DMRDMORX::reset()
     m_state = DMORXS_NONE;
     m_startPtr = 0U;
     m_endPtr = NOENDPTR;
+    m_slotTypePtr = NOENDPTR;
 }
 
 /* Sample DMR bits from the air interface. */
 
 void DMRDMORX::databit(bool bit)
 {
+    PROFILE_SCOPE(PROBE_DMR_DMO_RX_DATABIT);
+
     _WRITE_BIT(m_buffer, m_dataPtr, bit);
 
     m_bitBuffer <<= 1;
@@ -97,65 +108,97 @@ void DMRDMORX::databit(bool bit)
         }
     }
 
+    // the colour code is checked as soon as the slot type is in, so bursts for other systems aren't buffered
+    if (m_dataPtr == m_slotTypePtr) {
+        m_slotTypePtr = NOENDPTR;
+
+        uint8_t colorCode;
+        DMRSlotType slotType;
+        slotType.decode(m_buffer, DMO_BUFFER_LENGTH_BITS, m_startPtr, colorCode, m_dataType);
+
+        if (((m_colorCodes >> colorCode) & 0x01U) == 0x00U) {
+            m_rejected++;
+            DEBUG3("DMRDMORX::databit() colour code rejected, cc/count", colorCode, m_rejected);
+
+            if (m_state == DMORXS_NONE) {
+                // go straight back to hunting
+                m_control = CONTROL_NONE;
+                m_endPtr = NOENDPTR;
+            }
+            else {
+                // the burst is skipped, a single bad slot type shouldn't drop the call
+                m_control = CONTROL_REJECT;
+            }
+        }
+    }
+
     if (m_dataPtr == m_endPtr) {
         frame[0U] = m_control;
 
-        bitsToBytes(m_startPtr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
+        ringBitsToBytes(m_buffer, DMO_BUFFER_LENGTH_BITS, m_startPtr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
 
         if (m_control == CONTROL_DATA) {
-            // Data sync
-            uint8_t colorCode;
-            uint8_t dataType;
-            DMRSlotType slotType;
-            slotType.decode(frame + 1U, colorCode, dataType);
+            // Data sync; the slot type was decoded (and the colour code checked) once it was received
+            uint8_t dataType = m_dataType;
 
-            if (colorCode == m_colorCode) {
-                m_syncCount = 0U;
-                m_n = 0U;
+            m_syncCount = 0U;
+            m_n = 0U;
 
-                frame[0U] |= dataType;
+            frame[0U] |= dataType;
 
-                switch (dataType) {
-                case DT_DATA_HEADER:
-                    DEBUG2("DMRDMORX::databit() data header found pos", m_syncPtr);
+            // CSBKs and data headers failing their CRC aren't passed to the host (but still change state)
+            bool valid = true;
+#if defined(DMR_VALIDATE_DATA)
+            DMRBPTC bptc;
+            valid = bptc.validate(frame + 1U, dataType);
+            if (!valid) {
+                m_filtered++;
+                DEBUG2("DMRDMORX::databit() payload CRC failed, filtered count", m_filtered);
+            }
+#endif
+
+            switch (dataType) {
+            case DT_DATA_HEADER:
+                DEBUG2("DMRDMORX::databit() data header found pos", m_syncPtr);
+                if (valid)
                     writeRSSIData(frame);
-                    m_state = DMORXS_DATA;
-                    m_type = 0x00U;
-                    break;
-                case DT_RATE_12_DATA:
-                case DT_RATE_34_DATA:
-                case DT_RATE_1_DATA:
-                    if (m_state == DMORXS_DATA) {
-                        DEBUG2("DMRDMORX::databit() data payload found pos", m_syncPtr);
-                        writeRSSIData(frame);
-                        m_type = dataType;
-                    }
-                    break;
-                case DT_VOICE_LC_HEADER:
-                    DEBUG2("DMRDMORX::databit() voice header found pos", m_syncPtr);
+                m_state = DMORXS_DATA;
+                m_type = 0x00U;
+                break;
+            case DT_RATE_12_DATA:
+            case DT_RATE_34_DATA:
+            case DT_RATE_1_DATA:
+                if (m_state == DMORXS_DATA) {
+                    DEBUG2("DMRDMORX::databit() data payload found pos", m_syncPtr);
                     writeRSSIData(frame);
-                    m_state = DMORXS_VOICE;
-                    break;
-                case DT_VOICE_PI_HEADER:
-                    if (m_state == DMORXS_VOICE) {
-                        DEBUG2("DMRDMORX::databit() voice pi header found pos", m_syncPtr);
-                        writeRSSIData(frame);
-                    }
-                    m_state = DMORXS_VOICE;
-                    break;
-                case DT_TERMINATOR_WITH_LC:
-                    if (m_state == DMORXS_VOICE) {
-                        DEBUG2("DMRDMORX::databit() voice terminator found pos", m_syncPtr);
-                        writeRSSIData(frame);
-                        reset();
-                    }
-                    break;
-                default:    // DT_CSBK
-                    DEBUG2("DMRDMORX::databit() csbk found pos", m_syncPtr);
+                    m_type = dataType;
+                }
+                break;
+            case DT_VOICE_LC_HEADER:
+                DEBUG2("DMRDMORX::databit() voice header found pos", m_syncPtr);
+                writeRSSIData(frame);
+                m_state = DMORXS_VOICE;
+                break;
+            case DT_VOICE_PI_HEADER:
+                if (m_state == DMORXS_VOICE) {
+                    DEBUG2("DMRDMORX::databit() voice pi header found pos", m_syncPtr);
+                    writeRSSIData(frame);
+                }
+                m_state = DMORXS_VOICE;
+                break;
+            case DT_TERMINATOR_WITH_LC:
+                if (m_state == DMORXS_VOICE) {
+                    DEBUG2("DMRDMORX::databit() voice terminator found pos", m_syncPtr);
                     writeRSSIData(frame);
                     reset();
-                    break;
                 }
+                break;
+            default:    // DT_CSBK
+                DEBUG2("DMRDMORX::databit() csbk found pos", m_syncPtr);
+                if (valid)
+                    writeRSSIData(frame);
+                reset();
+                break;
             }
         }
         else if (m_control == CONTROL_VOICE) {
@@ -167,7 +210,7 @@ void DMRDMORX::databit(bool bit)
             m_syncCount = 0U;
             m_n = 0U;
         }
-        else {
+        else if (m_control == CONTROL_NONE) {
             if (m_state != DMORXS_NONE) {
                 m_syncCount++;
                 if (m_syncCount >= MAX_SYNC_LOST_FRAMES) {
@@ -185,7 +228,17 @@ void DMRDMORX::databit(bool bit)
                 else {
                     frame[0U] = ++m_n;
                 }
-                serial.writeDMRData(true, frame, DMR_FRAME_LENGTH_BYTES + 1U);
+                uint8_t length = DMR_FRAME_LENGTH_BYTES + 1U;
+#if defined(SEND_BER_DATA)
+                DMRAMBEFEC ambeFEC;
+                frame[length++] = ambeFEC.getErrors(frame + 1U);
+#endif
+#if defined(SEND_RX_TIMESTAMP)
+                io.getRXTimestamp(DMR_FRAME_LENGTH_BITS, frame + length);
+                length += 4U;
+#endif
+
+                serial.writeDMRData(true, frame, length);
             }
             else if (m_state == DMORXS_DATA) {
                 if (m_type != 0x00U) {
@@ -211,7 +264,14 @@ void DMRDMORX::databit(bool bit)
 
 void DMRDMORX::setColorCode(uint8_t colorCode)
 {
-    m_colorCode = colorCode;
+    m_colorCodes = 1U << colorCode;
+}
+
+/* Sets the DMR color codes allowed. */
+
+void DMRDMORX::setColorCodes(uint16_t colorCodes)
+{
+    m_colorCodes = colorCodes;
 }
 
 // ---------------------------------------------------------------------------
@@ -222,127 +282,76 @@ void DMRDMORX::setColorCode(uint8_t colorCode)
 
 void DMRDMORX::correlateSync()
 {
-    // unpack sync bytes
-    uint8_t sync[DMR_SYNC_BYTES_LENGTH];
-    sync[0U] = (uint8_t)((m_bitBuffer >> 48) & 0xFFU);
-    sync[1U] = (uint8_t)((m_bitBuffer >> 40) & 0xFFU);
-    sync[2U] = (uint8_t)((m_bitBuffer >> 32) & 0xFFU);
-    sync[3U] = (uint8_t)((m_bitBuffer >> 24) & 0xFFU);
-    sync[4U] = (uint8_t)((m_bitBuffer >> 16) & 0xFFU);
-    sync[5U] = (uint8_t)((m_bitBuffer >> 8) & 0xFFU);
-    sync[6U] = (uint8_t)((m_bitBuffer >> 0) & 0xFFU);
-
-    if ((countBits64((m_bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || 
-        (countBits64((m_bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_S2_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS)) {
-        uint8_t errs = 0U;
-        for (uint8_t i = 0U; i < DMR_SYNC_BYTES_LENGTH; i++)
-            errs += countBits8((sync[i] & DMR_SYNC_BYTES_MASK[i]) ^ DMR_MS_DATA_SYNC_BYTES[i]);
-
-        DEBUG2("DMRDMORX::correlateSync() sync errs", errs);
-
-        DEBUG4("DMRDMORX::correlateSync() sync [b0 - b2]", sync[0], sync[1], sync[2]);
-        DEBUG4("DMRDMORX::correlateSync() sync [b3 - b5]", sync[3], sync[4], sync[5]);
-        DEBUG2("DMRDMORX::correlateSync() sync [b6]", sync[6]);
-
-        m_control = CONTROL_DATA;
-        m_syncPtr = m_dataPtr;
-
-        m_startPtr = m_dataPtr + DMO_BUFFER_LENGTH_BITS - DMR_SLOT_TYPE_LENGTH_BITS / 2U - DMR_INFO_LENGTH_BITS / 2U - DMR_SYNC_LENGTH_BITS + 1;
-        if (m_startPtr >= DMO_BUFFER_LENGTH_BITS)
-            m_startPtr -= DMO_BUFFER_LENGTH_BITS;
-
-        m_endPtr = m_dataPtr + DMR_SLOT_TYPE_LENGTH_BITS / 2U + DMR_INFO_LENGTH_BITS / 2U;
-        if (m_endPtr >= DMO_BUFFER_LENGTH_BITS)
-            m_endPtr -= DMO_BUFFER_LENGTH_BITS;
-
-        DEBUG4("DMRDMORX::correlateSync() dataPtr/startPtr/endPtr", m_dataPtr, m_startPtr, m_endPtr);
-    } else if ((countBits64((m_bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || 
-        (countBits64((m_bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_S2_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS)) {
-        uint8_t errs = 0U;
-        for (uint8_t i = 0U; i < DMR_SYNC_BYTES_LENGTH; i++)
-            errs += countBits8((sync[i] & DMR_SYNC_BYTES_MASK[i]) ^ DMR_MS_VOICE_SYNC_BYTES[i]);
-
-        DEBUG2("DMRDMORX::correlateSync() correlateSync errs", errs);
-
-        DEBUG4("DMRDMORX::correlateSync() sync [b0 - b2]", sync[0], sync[1], sync[2]);
-        DEBUG4("DMRDMORX::correlateSync() sync [b3 - b5]", sync[3], sync[4], sync[5]);
-        DEBUG2("DMRDMORX::correlateSync() sync [b6]", sync[6]);
-
-        m_control  = CONTROL_VOICE;
-        m_syncPtr  = m_dataPtr;
-
-        m_startPtr = m_dataPtr + DMO_BUFFER_LENGTH_BITS - DMR_SLOT_TYPE_LENGTH_BITS / 2U - DMR_INFO_LENGTH_BITS / 2U - DMR_SYNC_LENGTH_BITS + 1;
-        if (m_startPtr >= DMO_BUFFER_LENGTH_BITS)
-            m_startPtr -= DMO_BUFFER_LENGTH_BITS;
-
-        m_endPtr   = m_dataPtr + DMR_SLOT_TYPE_LENGTH_BITS / 2U + DMR_INFO_LENGTH_BITS / 2U;
-        if (m_endPtr >= DMO_BUFFER_LENGTH_BITS)
-            m_endPtr -= DMO_BUFFER_LENGTH_BITS;
-
-        DEBUG4("DMRDMORX::correlateSync() dataPtr/startPtr/endPtr", m_dataPtr, m_startPtr, m_endPtr);
-    }    
-}
+    PROFILE_SCOPE(PROBE_DMR_DMO_RX_SYNC);
 
-/* */
+    uint8_t errs = 0U;
+    uint8_t sync = DMRSync::correlate(m_bitBuffer, DMR_SYNC_MS | DMR_SYNC_S2, MAX_SYNC_BYTES_ERRS, errs);
+    if (sync == DMR_SYNC_NONE)
+        return;
 
-void DMRDMORX::bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer)
-{
-    for (uint8_t i = 0U; i < count; i++) {
-        buffer[i] = 0U;
-        buffer[i] |= _READ_BIT(m_buffer, start) << 7;
-        start++;
-        if (start >= DMO_BUFFER_LENGTH_BITS)
-            start -= DMO_BUFFER_LENGTH_BITS;
-        
-        buffer[i] |= _READ_BIT(m_buffer, start) << 6;
-        start++;
-        if (start >= DMO_BUFFER_LENGTH_BITS)
-            start -= DMO_BUFFER_LENGTH_BITS;
-        
-        buffer[i] |= _READ_BIT(m_buffer, start) << 5;
-        start++;
-        if (start >= DMO_BUFFER_LENGTH_BITS)
-            start -= DMO_BUFFER_LENGTH_BITS;
-        
-        buffer[i] |= _READ_BIT(m_buffer, start) << 4;
-        start++;
-        if (start >= DMO_BUFFER_LENGTH_BITS)
-            start -= DMO_BUFFER_LENGTH_BITS;
-        
-        buffer[i] |= _READ_BIT(m_buffer, start) << 3;
-        start++;
-        if (start >= DMO_BUFFER_LENGTH_BITS)
-            start -= DMO_BUFFER_LENGTH_BITS;
-        
-        buffer[i] |= _READ_BIT(m_buffer, start) << 2;
-        start++;
-        if (start >= DMO_BUFFER_LENGTH_BITS)
-            start -= DMO_BUFFER_LENGTH_BITS;
-        
-        buffer[i] |= _READ_BIT(m_buffer, start) << 1;
-        start++;
-        if (start >= DMO_BUFFER_LENGTH_BITS)
-            start -= DMO_BUFFER_LENGTH_BITS;
-
-        buffer[i] |= _READ_BIT(m_buffer, start) << 0;
-        start++;
-        if (start >= DMO_BUFFER_LENGTH_BITS)
-            start -= DMO_BUFFER_LENGTH_BITS;
+    // unpack sync bytes
+    uint8_t bytes[DMR_SYNC_BYTES_LENGTH];
+    bytes[0U] = (uint8_t)((m_bitBuffer >> 48) & 0xFFU);
+    bytes[1U] = (uint8_t)((m_bitBuffer >> 40) & 0xFFU);
+    bytes[2U] = (uint8_t)((m_bitBuffer >> 32) & 0xFFU);
+    bytes[3U] = (uint8_t)((m_bitBuffer >> 24) & 0xFFU);
+    bytes[4U] = (uint8_t)((m_bitBuffer >> 16) & 0xFFU);
+    bytes[5U] = (uint8_t)((m_bitBuffer >> 8) & 0xFFU);
+    bytes[6U] = (uint8_t)((m_bitBuffer >> 0) & 0xFFU);
+
+    DEBUG2("DMRDMORX::correlateSync() sync errs", errs);
+
+    DEBUG4("DMRDMORX::correlateSync() sync [b0 - b2]", bytes[0], bytes[1], bytes[2]);
+    DEBUG4("DMRDMORX::correlateSync() sync [b3 - b5]", bytes[3], bytes[4], bytes[5]);
+    DEBUG2("DMRDMORX::correlateSync() sync [b6]", bytes[6]);
+
+    m_control = (sync == DMR_SYNC_DATA) ? CONTROL_DATA : CONTROL_VOICE;
+    m_syncPtr = m_dataPtr;
+    TRACE_SYNC();
+
+    m_startPtr = m_dataPtr + DMO_BUFFER_LENGTH_BITS - DMR_SLOT_TYPE_LENGTH_BITS / 2U - DMR_INFO_LENGTH_BITS / 2U - DMR_SYNC_LENGTH_BITS + 1;
+    if (m_startPtr >= DMO_BUFFER_LENGTH_BITS)
+        m_startPtr -= DMO_BUFFER_LENGTH_BITS;
+
+    m_endPtr = m_dataPtr + DMR_SLOT_TYPE_LENGTH_BITS / 2U + DMR_INFO_LENGTH_BITS / 2U;
+    if (m_endPtr >= DMO_BUFFER_LENGTH_BITS)
+        m_endPtr -= DMO_BUFFER_LENGTH_BITS;
+
+    // the second half of the slot type follows the sync
+    m_slotTypePtr = NOENDPTR;
+    if (m_control == CONTROL_DATA) {
+        m_slotTypePtr = m_dataPtr + DMR_SLOT_TYPE_LENGTH_BITS / 2U;
+        if (m_slotTypePtr >= DMO_BUFFER_LENGTH_BITS)
+            m_slotTypePtr -= DMO_BUFFER_LENGTH_BITS;
     }
+
+    DEBUG4("DMRDMORX::correlateSync() dataPtr/startPtr/endPtr", m_dataPtr, m_startPtr, m_endPtr);
 }
 
+
 /* */
 
 void DMRDMORX::writeRSSIData(uint8_t* frame)
 {
+    uint8_t length = DMR_FRAME_LENGTH_BYTES + 1U;
 #if defined(SEND_RSSI_DATA)
     uint16_t rssi = io.readRSSI();
 
-    frame[34U] = (rssi >> 8) & 0xFFU;
-    frame[35U] = (rssi >> 0) & 0xFFU;
-
-    serial.writeDMRData(true, frame, DMR_FRAME_LENGTH_BYTES + 3U);
-#else
-    serial.writeDMRData(true, frame, DMR_FRAME_LENGTH_BYTES + 1U);
+    frame[length++] = (rssi >> 8) & 0xFFU;
+    frame[length++] = (rssi >> 0) & 0xFFU;
 #endif
+#if defined(SEND_BER_DATA)
+    // voice bursts end with the count of bits corrected in their AMBE frames
+    if ((frame[0U] & CONTROL_DATA) == 0U) {
+        DMRAMBEFEC ambeFEC;
+        frame[length++] = ambeFEC.getErrors(frame + 1U);
+    }
+#endif
+#if defined(SEND_RX_TIMESTAMP)
+    // the burst is written as its last bit is received
+    io.getRXTimestamp(DMR_FRAME_LENGTH_BITS, frame + length);
+    length += 4U;
+#endif
+
+    serial.writeDMRData(true, frame, length);
 }
@@ -70,22 +70,40 @@ namespace dmr
          * @param colorCode 
          */
         void setColorCode(uint8_t colorCode);
+        /**
+         * @brief Sets the DMR color codes allowed.
+         * @param colorCodes Bitmask of the allowed color codes (bit n set allows color code n).
+         */
+        void setColorCodes(uint16_t colorCodes);
+
+        /**
+         * @brief Gets the number of CSBKs and data headers dropped as their payload failed its CRC.
+         * @returns uint32_t Number of bursts dropped.
+         */
+        uint32_t getFiltered() const { return m_filtered; }
+        /**
+         * @brief Gets the number of data bursts rejected as their color code isn't allowed.
+         * @returns uint32_t Number of bursts rejected.
+         */
+        uint32_t getRejected() const { return m_rejected; }
 
     private:
         uint64_t m_bitBuffer;
         uint8_t m_buffer[DMO_BUFFER_LENGTH_BITS / 8U];  // 72 bytes
 
-        uint8_t frame[DMR_FRAME_LENGTH_BYTES + 3U];
+        uint8_t frame[DMR_FRAME_LENGTH_BYTES + 8U];
 
         uint16_t m_dataPtr;
         uint16_t m_syncPtr;
         uint16_t m_startPtr;
         uint16_t m_endPtr;
+        uint16_t m_slotTypePtr;
 
         uint8_t m_control;
         uint8_t m_syncCount;
 
-        uint8_t m_colorCode;
+        uint16_t m_colorCodes;
+        uint8_t m_dataType;
 
         DMORX_STATE m_state;
 
@@ -93,20 +111,16 @@ namespace dmr
 
         uint8_t m_type;
 
+        uint32_t m_filtered;
+        uint32_t m_rejected;
+
         /**
          * @brief Frame synchronization correlator.
          */
         void correlateSync();
         
         /**
-         * @brief 
-         * @param start 
-         * @param count
-         * @param buffer
-         */
-        void bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer);
-        /**
-         * @brief 
+         * @brief Writes a frame to the host, followed by the optional RSSI and voice BER trailing bytes.
          * @param frame 
          */
         void writeRSSIData(uint8_t* frame);
@@ -37,7 +37,8 @@ DMRDMOTX::DMRDMOTX() :
     m_poBuffer(),
     m_poLen(0U),
     m_poPtr(0U),
-    m_preambleCnt(DMRDMO_FIXED_DELAY)
+    m_preambleCnt(DMRDMO_FIXED_DELAY),
+    m_schedule(CMD_DMR_DATA2)
 {
     /* stub */
 }
@@ -46,7 +47,17 @@ DMRDMOTX::DMRDMOTX() :
 
 void DMRDMOTX::process()
 {
+    PROFILE_SCOPE(PROBE_DMR_DMO_TX_PROCESS);
+
     if (m_poLen == 0U && m_fifo.getData() > 0U) {
+        // a frame with a launch time is held, unkeyed until its preamble is due and then with the
+        // preamble pattern, until it goes out (there is no TX hang, so the transmitter isn't kept keyed
+        // any longer than the preamble)
+        if (!m_tx && m_schedule.isWaiting(m_preambleCnt * 8U))
+            return;
+        if (m_tx && m_schedule.hold(DMR_START_SYNC, m_preambleCnt * 8U))
+            return;
+
         if (!m_tx) {
             for (uint16_t i = 0U; i < m_preambleCnt; i++)
                 m_poBuffer[i] = DMR_START_SYNC;
@@ -54,6 +65,7 @@ void DMRDMOTX::process()
             m_poLen = m_preambleCnt;
         }
         else {
+            m_schedule.take();
             for (unsigned int i = 0U; i < DMR_FRAME_LENGTH_BYTES; i++)
                     m_poBuffer[i] = m_fifo.get();
 
@@ -68,19 +80,20 @@ void DMRDMOTX::process()
 
     if (m_poLen > 0U) {
         uint16_t space = io.getSpace();
+        if (space <= 8U)
+            return;
 
-        while (space > 8U) {
-            uint8_t c = m_poBuffer[m_poPtr++];
-
-            writeByte(c);
+        // write as many whole bytes as fit in one go
+        uint16_t count = (space - 1U) / 8U;
+        if (count > m_poLen - m_poPtr)
+            count = m_poLen - m_poPtr;
 
-            space -= 8U;
+        io.writeBytes(m_poBuffer + m_poPtr, count);
+        m_poPtr += count;
 
-            if (m_poPtr >= m_poLen) {
-                m_poPtr = 0U;
-                m_poLen = 0U;
-                return;
-            }
+        if (m_poPtr >= m_poLen) {
+            m_poPtr = 0U;
+            m_poLen = 0U;
         }
     }
 }
@@ -89,17 +102,22 @@ void DMRDMOTX::process()
 
 uint8_t DMRDMOTX::writeData(const uint8_t* data, uint8_t length)
 {
-    if (length != (DMR_FRAME_LENGTH_BYTES + 1U))
+    uint16_t frameLength = length;
+    uint32_t launch = 0U;
+    bool timed = TXSchedule::getLaunch(data, frameLength, launch);
+    if (frameLength != (DMR_FRAME_LENGTH_BYTES + 1U))
         return RSN_ILLEGAL_LENGTH;
 
     uint16_t space = m_fifo.getSpace();
     DEBUG3("DMRDMOTX::writeData() dataLength/fifoLength", length, space);
-    if (space < DMR_FRAME_LENGTH_BYTES)
+    if (space < DMR_FRAME_LENGTH_BYTES || (timed && !m_schedule.hasSpace()))
         return RSN_RINGBUFF_FULL;
 
     for (uint8_t i = 0U; i < DMR_FRAME_LENGTH_BYTES; i++)
         m_fifo.put(data[i + 1U]);
 
+    m_schedule.put(timed, launch);
+
     return RSN_OK;
 }
 
@@ -121,6 +139,7 @@ void DMRDMOTX::resizeBuffer(uint16_t size)
 {
     m_fifo.reset();
     m_fifo.reinitialize(size);
+    m_schedule.reset();
 }
 
 /* Helper to get how much space the ring buffer has for samples. */
@@ -130,23 +149,11 @@ uint16_t DMRDMOTX::getSpace() const
     return m_fifo.getSpace() / (DMR_FRAME_LENGTH_BYTES + 2U);
 }
 
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
-/* Helper to write a raw byte to the DAC. */
+/* Helper to get how long the queued frames, and the rest of the frame being sent, take to go out. */
 
-void DMRDMOTX::writeByte(uint8_t c)
+uint16_t DMRDMOTX::getQueuedMs() const
 {
-    uint8_t bit;
-    uint8_t mask = 0x80U;
-
-    for (uint8_t i = 0U; i < 8U; i++, c <<= 1) {
-        if ((c & mask) == mask)
-            bit = 1U;
-        else
-            bit = 0U;
-
-        io.write(&bit, 1);
-    }
+    // each queued burst goes out padded to a whole 60ms frame; the output buffer is sent at 9600 bps
+    uint32_t frames = (m_fifo.getData() + DMR_FRAME_LENGTH_BYTES - 1U) / DMR_FRAME_LENGTH_BYTES;
+    return (uint16_t)(frames * 60U + (uint32_t(m_poLen - m_poPtr) * 8000U) / 9600U);
 }
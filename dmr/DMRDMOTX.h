@@ -22,6 +22,7 @@
 #include "Defines.h"
 #include "dmr/DMRDefines.h"
 #include "SerialBuffer.h"
+#include "TXSchedule.h"
 
 namespace dmr
 {
@@ -77,6 +78,16 @@ namespace dmr
          * @returns uint8_t Amount of space in ring buffer for samples. 
          */
         uint16_t getSpace() const;
+        /**
+         * @brief Helper to get how many bytes are free in the ring buffer.
+         * @returns uint16_t Free space in the ring buffer, in bytes.
+         */
+        uint16_t getFreeBytes() const { return m_fifo.getSpace(); }
+        /**
+         * @brief Helper to get how long the queued frames, and the rest of the frame being sent, take to go out.
+         * @returns uint16_t Queued airtime, in milliseconds.
+         */
+        uint16_t getQueuedMs() const;
 
     private:
         SerialBuffer m_fifo;
@@ -87,11 +98,7 @@ namespace dmr
 
         uint32_t m_preambleCnt;
 
-        /**
-         * @brief Helper to write a raw byte to the DAC.
-         * @param c Byte.
-         */
-        void writeByte(uint8_t c);
+        TXSchedule m_schedule;
     };
 } // namespace dmr
 
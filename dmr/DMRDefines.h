@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2009-2016 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -94,6 +95,9 @@ namespace dmr
     const uint64_t  DMR_S2_VOICE_SYNC_BITS = 0x00007DFFD5F55D5FU;
 
     const uint64_t  DMR_SYNC_BITS_MASK = 0x0000FFFFFFFFFFFFU;
+    // every sync symbol is +3 or -3; the sync words only differ in the first (sign) bit of each dibit
+    const uint64_t  DMR_SYNC_SIGN_BITS_MASK = 0x0000AAAAAAAAAAAAU;
+    const uint64_t  DMR_SYNC_MAG_BITS_MASK = 0x0000555555555555U;
 
     const uint32_t  DMR_MS_DATA_SYNC_SYMBOLS = 0x0076286EU;
     const uint32_t  DMR_MS_VOICE_SYNC_SYMBOLS = 0x0089D791U;
@@ -133,6 +137,12 @@ namespace dmr
     const uint8_t   DT_IDLE = 9U;
     const uint8_t   DT_RATE_1_DATA = 10U;
 
+    // BPTC (196,96) payload; 10 bytes and a 16 bit CRC-CCITT, masked by the data type
+    const uint8_t   DMR_BPTC_DATA_LENGTH_BYTES = 12U;
+
+    const uint16_t  DMR_CSBK_CRC_MASK = 0xA5A5U;
+    const uint16_t  DMR_DATA_HEADER_CRC_MASK = 0xCCCCU;
+
     /** @} */
 } // namespace dmr
 
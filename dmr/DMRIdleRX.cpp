@@ -6,11 +6,14 @@
  *
  *  Copyright (C) 2009-2017 Jonathan Naylor, G4KLX
  *  Copyright (C) 2017,2018 Andy Uribe, CA6JAU
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Globals.h"
 #include "dmr/DMRIdleRX.h"
+#include "dmr/DMRBPTC.h"
 #include "dmr/DMRSlotType.h"
+#include "dmr/DMRSync.h"
 #include "Utils.h"
 
 using namespace dmr;
@@ -39,7 +42,10 @@ DMRIdleRX::DMRIdleRX() :
     m_buffer(),
     m_dataPtr(0U),
     m_endPtr(NOENDPTR),
-    m_colorCode(0U)
+    m_slotTypePtr(NOENDPTR),
+    m_colorCodes(0x0001U),
+    m_filtered(0U),
+    m_rejected(0U)
 {
     /* stub */
 }
@@ -50,42 +56,87 @@ void DMRIdleRX::reset()
 {
     m_dataPtr = 0U;
     m_endPtr = NOENDPTR;
+    m_slotTypePtr = NOENDPTR;
 }
 
 /* Sample DMR bits from the air interface. */
 
 void DMRIdleRX::databit(bool bit)
 {
+    PROFILE_SCOPE(PROBE_DMR_IDLE_RX_DATABIT);
+
     _WRITE_BIT(m_buffer, m_dataPtr, bit);
 
     m_bitBuffer <<= 1;
     if (bit)
         m_bitBuffer |= 0x01U;
 
-    if (countBits64((m_bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
+    // CSBKs are data bursts; either an MS or a BS may be the source
+    uint8_t errs = 0U;
+    if (DMRSync::correlate(m_bitBuffer, DMR_SYNC_MS | DMR_SYNC_BS, MAX_SYNC_BYTES_ERRS, errs) == DMR_SYNC_DATA) {
         m_endPtr = m_dataPtr + DMR_SLOT_TYPE_LENGTH_BITS / 2U + DMR_INFO_LENGTH_BITS / 2U;
         if (m_endPtr >= DMR_IDLE_LENGTH_BITS)
             m_endPtr -= DMR_IDLE_LENGTH_BITS;
 
+        // the second half of the slot type follows the sync
+        m_slotTypePtr = m_dataPtr + DMR_SLOT_TYPE_LENGTH_BITS / 2U;
+        if (m_slotTypePtr >= DMR_IDLE_LENGTH_BITS)
+            m_slotTypePtr -= DMR_IDLE_LENGTH_BITS;
+
+        TRACE_SYNC();
         DEBUG3("DMRIdleRx::databit() dataPtr/endPtr", m_dataPtr, m_endPtr);
     }
 
-    if (m_dataPtr == m_endPtr) {
-        uint16_t ptr = m_endPtr + DMR_IDLE_LENGTH_BITS - DMR_FRAME_LENGTH_BITS + 1;
+    // anything but a CSBK for an allowed colour code is dropped as soon as the slot type is in
+    if (m_dataPtr == m_slotTypePtr) {
+        uint16_t ptr = m_slotTypePtr + DMR_IDLE_LENGTH_BITS - DMR_SLOT_TYPE_LENGTH_BITS - DMR_INFO_LENGTH_BITS / 2U - DMR_SYNC_LENGTH_BITS + 1;
         if (ptr >= DMR_IDLE_LENGTH_BITS)
             ptr -= DMR_IDLE_LENGTH_BITS;
 
-        uint8_t frame[DMR_FRAME_LENGTH_BYTES + 1U];
-        bitsToBytes(ptr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
-
         uint8_t colorCode;
         uint8_t dataType;
         DMRSlotType slotType;
-        slotType.decode(frame + 1U, colorCode, dataType);
+        slotType.decode(m_buffer, DMR_IDLE_LENGTH_BITS, ptr, colorCode, dataType);
 
-        if (colorCode == m_colorCode && dataType == DT_CSBK) {
+        if (((m_colorCodes >> colorCode) & 0x01U) == 0x00U) {
+            m_rejected++;
+            DEBUG3("DMRIdleRX::databit() colour code rejected, cc/count", colorCode, m_rejected);
+            m_endPtr = NOENDPTR;
+        }
+        else if (dataType != DT_CSBK) {
+            m_endPtr = NOENDPTR;
+        }
+
+        m_slotTypePtr = NOENDPTR;
+    }
+
+    if (m_dataPtr == m_endPtr) {
+        uint16_t ptr = m_endPtr + DMR_IDLE_LENGTH_BITS - DMR_FRAME_LENGTH_BITS + 1;
+        if (ptr >= DMR_IDLE_LENGTH_BITS)
+            ptr -= DMR_IDLE_LENGTH_BITS;
+
+        uint8_t frame[DMR_FRAME_LENGTH_BYTES + 5U];
+        ringBitsToBytes(m_buffer, DMR_IDLE_LENGTH_BITS, ptr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
+
+        // the slot type was decoded (and the colour code checked) once it was received
+        bool valid = true;
+#if defined(DMR_VALIDATE_DATA)
+        DMRBPTC bptc;
+        valid = bptc.validate(frame + 1U, DT_CSBK);
+#endif
+        if (valid) {
             frame[0U] = CONTROL_IDLE | CONTROL_DATA | DT_CSBK;
-            serial.writeDMRData(false, frame, DMR_FRAME_LENGTH_BYTES + 1U);
+
+            uint8_t length = DMR_FRAME_LENGTH_BYTES + 1U;
+#if defined(SEND_RX_TIMESTAMP)
+            io.getRXTimestamp(DMR_FRAME_LENGTH_BITS, frame + length);
+            length += 4U;
+#endif
+            serial.writeDMRData(false, frame, length);
+        }
+        else {
+            m_filtered++;
+            DEBUG2("DMRIdleRX::databit() payload CRC failed, filtered count", m_filtered);
         }
 
         m_endPtr = NOENDPTR;
@@ -100,59 +151,14 @@ void DMRIdleRX::databit(bool bit)
 
 void DMRIdleRX::setColorCode(uint8_t colorCode)
 {
-    m_colorCode = colorCode;
+    m_colorCodes = 1U << colorCode;
 }
 
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
-/* */
+/* Sets the DMR color codes allowed. */
 
-void DMRIdleRX::bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer)
+void DMRIdleRX::setColorCodes(uint16_t colorCodes)
 {
-  for (uint8_t i = 0U; i < count; i++) {
-    buffer[i]  = 0U;
-    buffer[i] |= _READ_BIT(m_buffer, start) << 7;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-
-    buffer[i] |= _READ_BIT(m_buffer, start) << 6;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-
-    buffer[i] |= _READ_BIT(m_buffer, start) << 5;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-
-    buffer[i] |= _READ_BIT(m_buffer, start) << 4;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-
-    buffer[i] |= _READ_BIT(m_buffer, start) << 3;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-
-    buffer[i] |= _READ_BIT(m_buffer, start) << 2;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-
-    buffer[i] |= _READ_BIT(m_buffer, start) << 1;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-
-    buffer[i] |= _READ_BIT(m_buffer, start) << 0;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-  }
+    m_colorCodes = colorCodes;
 }
 
 #endif // DUPLEX
@@ -6,6 +6,7 @@
  *
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
  *  Copyright (C) 2017,2018 Andy Uribe, CA6JAU
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -61,6 +62,22 @@ namespace dmr
          * @param colorCode 
          */
         void setColorCode(uint8_t colorCode);
+        /**
+         * @brief Sets the DMR color codes allowed.
+         * @param colorCodes Bitmask of the allowed color codes (bit n set allows color code n).
+         */
+        void setColorCodes(uint16_t colorCodes);
+
+        /**
+         * @brief Gets the number of CSBKs and data headers dropped as their payload failed its CRC.
+         * @returns uint32_t Number of bursts dropped.
+         */
+        uint32_t getFiltered() const { return m_filtered; }
+        /**
+         * @brief Gets the number of data bursts rejected as their color code isn't allowed.
+         * @returns uint32_t Number of bursts rejected.
+         */
+        uint32_t getRejected() const { return m_rejected; }
 
     private:
         uint64_t m_bitBuffer;
@@ -68,16 +85,12 @@ namespace dmr
         
         uint16_t m_dataPtr;
         uint16_t m_endPtr;
+        uint16_t m_slotTypePtr;
         
-        uint8_t m_colorCode;
+        uint16_t m_colorCodes;
 
-        /**
-         * @brief 
-         * @param start 
-         * @param count
-         * @param buffer
-         */
-        void bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer);
+        uint32_t m_filtered;
+        uint32_t m_rejected;
     };
 } // namespace dmr
 
@@ -42,6 +42,8 @@ void DMRRX::reset()
 
 void DMRRX::databit(bool bit, const uint8_t control)
 {
+    PROFILE_SCOPE(PROBE_DMR_RX_DATABIT);
+
     bool dcd1 = false;
     bool dcd2 = false;
    
@@ -70,6 +72,14 @@ void DMRRX::setColorCode(uint8_t colorCode)
     m_slot2RX.setColorCode(colorCode);
 }
 
+/* Sets the DMR color codes allowed. */
+
+void DMRRX::setColorCodes(uint16_t colorCodes)
+{
+    m_slot1RX.setColorCodes(colorCodes);
+    m_slot2RX.setColorCodes(colorCodes);
+}
+
 /* Sets the number of samples to delay before processing. */
 
 void DMRRX::setRxDelay(uint8_t delay)
@@ -57,12 +57,28 @@ namespace dmr
          * @param colorCode 
          */
         void setColorCode(uint8_t colorCode);
+        /**
+         * @brief Sets the DMR color codes allowed.
+         * @param colorCodes Bitmask of the allowed color codes (bit n set allows color code n).
+         */
+        void setColorCodes(uint16_t colorCodes);
         /**
          * @brief Sets the number of samples to delay before processing.
          * @param delay 
          */
         void setRxDelay(uint8_t delay);
 
+        /**
+         * @brief Gets the number of CSBKs and data headers dropped as their payload failed its CRC.
+         * @returns uint32_t Number of bursts dropped, over both slots.
+         */
+        uint32_t getFiltered() const { return m_slot1RX.getFiltered() + m_slot2RX.getFiltered(); }
+        /**
+         * @brief Gets the number of data bursts rejected as their color code isn't allowed.
+         * @returns uint32_t Number of bursts rejected, over both slots.
+         */
+        uint32_t getRejected() const { return m_slot1RX.getRejected() + m_slot2RX.getRejected(); }
+
     private:
         DMRSlotRX m_slot1RX;
         DMRSlotRX m_slot2RX;
@@ -77,12 +77,28 @@ namespace dmr
          * @param colorCode 
          */
         void setColorCode(uint8_t colorCode);
+        /**
+         * @brief Sets the DMR color codes allowed.
+         * @param colorCodes Bitmask of the allowed color codes (bit n set allows color code n).
+         */
+        void setColorCodes(uint16_t colorCodes);
         /**
          * @brief Sets the number of samples to delay before processing.
          * @param delay 
          */
         void setRxDelay(uint8_t delay);
 
+        /**
+         * @brief Gets the number of CSBKs and data headers dropped as their payload failed its CRC.
+         * @returns uint32_t Number of bursts dropped.
+         */
+        uint32_t getFiltered() const { return m_filtered; }
+        /**
+         * @brief Gets the number of data bursts rejected as their color code isn't allowed.
+         * @returns uint32_t Number of bursts rejected.
+         */
+        uint32_t getRejected() const { return m_rejected; }
+
 
     private:
         bool m_slot;
@@ -94,12 +110,14 @@ namespace dmr
         uint16_t m_syncPtr;
         uint16_t m_startPtr;
         uint16_t m_endPtr;
+        uint16_t m_slotTypePtr;
         uint16_t m_delayPtr;
 
         uint8_t m_control;
         uint8_t m_syncCount;
 
-        uint8_t m_colorCode;
+        uint16_t m_colorCodes;
+        uint8_t m_dataType;
 
         uint16_t m_delay;
 
@@ -109,6 +127,9 @@ namespace dmr
 
         uint8_t m_type;
 
+        uint32_t m_filtered;
+        uint32_t m_rejected;
+
         /**
          * @brief Frame synchronization correlator.
          */
@@ -119,14 +140,7 @@ namespace dmr
         void resetSlot();
 
         /**
-         * @brief 
-         * @param start 
-         * @param count
-         * @param buffer
-         */
-        void bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer);
-        /**
-         * @brief 
+         * @brief Writes a frame to the host, followed by the optional RSSI and voice BER trailing bytes.
          * @param frame 
          */
         void writeRSSIData(uint8_t* frame);
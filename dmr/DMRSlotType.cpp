@@ -5,10 +5,12 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Globals.h"
 #include "dmr/DMRSlotType.h"
+#include "Utils.h"
 
 using namespace dmr;
 
@@ -16,6 +18,9 @@ using namespace dmr;
 //  Constants
 // ---------------------------------------------------------------------------
 
+const uint8_t SLOT_TYPE_START_BYTE = 12U;
+const uint8_t SLOT_TYPE_BYTES = 9U;
+
 const uint16_t ENCODING_TABLE_2087[] = {
     0x0000U, 0xB08EU, 0xE093U, 0x501DU, 0x70A9U, 0xC027U, 0x903AU, 0x20B4U, 0x60DCU, 0xD052U, 0x804FU, 0x30C1U,
     0x1075U, 0xA0FBU, 0xF0E6U, 0x4068U, 0x7036U, 0xC0B8U, 0x90A5U, 0x202BU, 0x009FU, 0xB011U, 0xE00CU, 0x5082U,
@@ -200,10 +205,34 @@ const uint32_t DECODING_TABLE_1987[] = {
     0x20120U, 0x40600U, 0x20122U, 0x40602U, 0x11009U, 0x11008U, 0x22800U, 0x04110U, 0x1100DU, 0x1100CU, 0x22804U, 0x04114U, 0x11001U,
     0x11000U, 0x11003U, 0x11002U, 0x11005U, 0x11004U, 0x28081U, 0x28080U };
 
-#define X18             0x00040000   /* vector representation of X^{18} */
-#define X11             0x00000800   /* vector representation of X^{11} */
-#define MASK8           0xfffff800   /* auxiliary vector for testing */
-#define GENPOL          0x00000c75   /* generator polinomial, g(x) */
+// The syndrome of a 19 bit pattern is its remainder modulo the generator polynomial g(x) = 0xC75; as the
+// remainder is linear it is the XOR of the remainders of the pattern's bytes (the low byte is its own).
+const uint16_t SYNDROME_TABLE_1987_HI[] = {
+    0x000U, 0x366U, 0x6CCU, 0x5AAU, 0x1EDU, 0x28BU, 0x721U, 0x447U };
+
+const uint16_t SYNDROME_TABLE_1987_MID[] = {
+    0x000U, 0x100U, 0x200U, 0x300U, 0x400U, 0x500U, 0x600U, 0x700U, 0x475U, 0x575U, 0x675U, 0x775U,
+    0x075U, 0x175U, 0x275U, 0x375U, 0x49FU, 0x59FU, 0x69FU, 0x79FU, 0x09FU, 0x19FU, 0x29FU, 0x39FU,
+    0x0EAU, 0x1EAU, 0x2EAU, 0x3EAU, 0x4EAU, 0x5EAU, 0x6EAU, 0x7EAU, 0x54BU, 0x44BU, 0x74BU, 0x64BU,
+    0x14BU, 0x04BU, 0x34BU, 0x24BU, 0x13EU, 0x03EU, 0x33EU, 0x23EU, 0x53EU, 0x43EU, 0x73EU, 0x63EU,
+    0x1D4U, 0x0D4U, 0x3D4U, 0x2D4U, 0x5D4U, 0x4D4U, 0x7D4U, 0x6D4U, 0x5A1U, 0x4A1U, 0x7A1U, 0x6A1U,
+    0x1A1U, 0x0A1U, 0x3A1U, 0x2A1U, 0x6E3U, 0x7E3U, 0x4E3U, 0x5E3U, 0x2E3U, 0x3E3U, 0x0E3U, 0x1E3U,
+    0x296U, 0x396U, 0x096U, 0x196U, 0x696U, 0x796U, 0x496U, 0x596U, 0x27CU, 0x37CU, 0x07CU, 0x17CU,
+    0x67CU, 0x77CU, 0x47CU, 0x57CU, 0x609U, 0x709U, 0x409U, 0x509U, 0x209U, 0x309U, 0x009U, 0x109U,
+    0x3A8U, 0x2A8U, 0x1A8U, 0x0A8U, 0x7A8U, 0x6A8U, 0x5A8U, 0x4A8U, 0x7DDU, 0x6DDU, 0x5DDU, 0x4DDU,
+    0x3DDU, 0x2DDU, 0x1DDU, 0x0DDU, 0x737U, 0x637U, 0x537U, 0x437U, 0x337U, 0x237U, 0x137U, 0x037U,
+    0x342U, 0x242U, 0x142U, 0x042U, 0x742U, 0x642U, 0x542U, 0x442U, 0x1B3U, 0x0B3U, 0x3B3U, 0x2B3U,
+    0x5B3U, 0x4B3U, 0x7B3U, 0x6B3U, 0x5C6U, 0x4C6U, 0x7C6U, 0x6C6U, 0x1C6U, 0x0C6U, 0x3C6U, 0x2C6U,
+    0x52CU, 0x42CU, 0x72CU, 0x62CU, 0x12CU, 0x02CU, 0x32CU, 0x22CU, 0x159U, 0x059U, 0x359U, 0x259U,
+    0x559U, 0x459U, 0x759U, 0x659U, 0x4F8U, 0x5F8U, 0x6F8U, 0x7F8U, 0x0F8U, 0x1F8U, 0x2F8U, 0x3F8U,
+    0x08DU, 0x18DU, 0x28DU, 0x38DU, 0x48DU, 0x58DU, 0x68DU, 0x78DU, 0x067U, 0x167U, 0x267U, 0x367U,
+    0x467U, 0x567U, 0x667U, 0x767U, 0x412U, 0x512U, 0x612U, 0x712U, 0x012U, 0x112U, 0x212U, 0x312U,
+    0x750U, 0x650U, 0x550U, 0x450U, 0x350U, 0x250U, 0x150U, 0x050U, 0x325U, 0x225U, 0x125U, 0x025U,
+    0x725U, 0x625U, 0x525U, 0x425U, 0x3CFU, 0x2CFU, 0x1CFU, 0x0CFU, 0x7CFU, 0x6CFU, 0x5CFU, 0x4CFU,
+    0x7BAU, 0x6BAU, 0x5BAU, 0x4BAU, 0x3BAU, 0x2BAU, 0x1BAU, 0x0BAU, 0x21BU, 0x31BU, 0x01BU, 0x11BU,
+    0x61BU, 0x71BU, 0x41BU, 0x51BU, 0x66EU, 0x76EU, 0x46EU, 0x56EU, 0x26EU, 0x36EU, 0x06EU, 0x16EU,
+    0x684U, 0x784U, 0x484U, 0x584U, 0x284U, 0x384U, 0x084U, 0x184U, 0x2F1U, 0x3F1U, 0x0F1U, 0x1F1U,
+    0x6F1U, 0x7F1U, 0x4F1U, 0x5F1U };
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -236,6 +265,37 @@ void DMRSlotType::decode(const uint8_t* frame, uint8_t& colorCode, uint8_t& data
     dataType = (code >> 0) & 0x0FU;
 }
 
+/* Decodes DMR slot type straight from a receiver's circular bit buffer. */
+
+void DMRSlotType::decode(const uint8_t* ring, uint16_t length, uint16_t start, uint8_t& colorCode, uint8_t& dataType) const
+{
+    // only bytes 12 - 20 of the burst carry the slot type, the rest of the frame is left unread
+    uint16_t ptr = start + SLOT_TYPE_START_BYTE * 8U;
+    if (ptr >= length)
+        ptr -= length;
+
+    uint8_t frame[DMR_FRAME_LENGTH_BYTES];
+    ringBitsToBytes(ring, length, ptr, SLOT_TYPE_BYTES, frame + SLOT_TYPE_START_BYTE);
+
+    decode(frame, colorCode, dataType);
+}
+
+#if defined(HOST_SIM)
+/* Helper to get the syndrome of a (19,8) pattern. */
+
+uint32_t DMRSlotType::syndrome1987(uint32_t pattern) const
+{
+    return getSyndrome1987(pattern);
+}
+
+/* Helper to get the error pattern corrected for a (19,8) syndrome. */
+
+uint32_t DMRSlotType::errorPattern1987(uint32_t syndrome) const
+{
+    return DECODING_TABLE_1987[syndrome & 0x7FFU];
+}
+#endif
+
 /* Encodes DMR slot type. */
 
 void DMRSlotType::encode(uint8_t colorCode, uint8_t dataType, uint8_t* frame) const
@@ -273,20 +333,9 @@ uint8_t DMRSlotType::decode2087(const uint8_t* data) const
     return code >> 11;
 }
 
-/* */
+/* Gets the syndrome of a (19,8) pattern, from the byte-wise remainder tables. */
 
 uint32_t DMRSlotType::getSyndrome1987(uint32_t pattern) const
 {
-    unsigned int aux = X18;
-
-    if (pattern >= X11) {
-        while (pattern & MASK8) {
-            while (!(aux & pattern))
-                aux = aux >> 1;
-
-            pattern ^= (aux / X11) * GENPOL;
-        }
-    }
-
-    return pattern;
+    return SYNDROME_TABLE_1987_HI[(pattern >> 16) & 0x07U] ^ SYNDROME_TABLE_1987_MID[(pattern >> 8) & 0xFFU] ^ (pattern & 0xFFU);
 }
@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -42,6 +43,29 @@ namespace dmr
          * @param[out] dataType 
          */
         void decode(const uint8_t* frame, uint8_t& colorCode, uint8_t& dataType) const;
+        /**
+         * @brief Decodes DMR slot type straight from a receiver's circular bit buffer.
+         * @param[in] ring Circular bit buffer.
+         * @param length Length of the circular bit buffer in bits.
+         * @param start Bit position of the start of the burst.
+         * @param[out] colorCode 
+         * @param[out] dataType 
+         */
+        void decode(const uint8_t* ring, uint16_t length, uint16_t start, uint8_t& colorCode, uint8_t& dataType) const;
+#if defined(HOST_SIM)
+        /**
+         * @brief Helper to get the syndrome of a (19,8) pattern.
+         * @param pattern Received 19 bit pattern.
+         * @returns uint32_t 11 bit syndrome.
+         */
+        uint32_t syndrome1987(uint32_t pattern) const;
+        /**
+         * @brief Helper to get the error pattern corrected for a (19,8) syndrome.
+         * @param syndrome 11 bit syndrome.
+         * @returns uint32_t Error pattern, or 0 if the syndrome isn't corrected.
+         */
+        uint32_t errorPattern1987(uint32_t syndrome) const;
+#endif
         /**
          * @brief Encodes DMR slot type.
          * @param colorCode 
@@ -58,9 +82,9 @@ namespace dmr
          */
         uint8_t decode2087(const uint8_t* data) const;
         /**
-         * @brief 
-         * @param pattern 
-         * @returns uint32_t 
+         * @brief Gets the syndrome of a (19,8) pattern, from the byte-wise remainder tables.
+         * @param pattern Received 19 bit pattern.
+         * @returns uint32_t 11 bit syndrome.
          */
         uint32_t getSyndrome1987(uint32_t pattern) const;
     };
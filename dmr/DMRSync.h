@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file DMRSync.h
+ * @ingroup dmr_hfw
+ */
+#if !defined(__DMR_SYNC_H__)
+#define __DMR_SYNC_H__
+
+#include "Defines.h"
+#include "dmr/DMRDefines.h"
+#include "Utils.h"
+
+namespace dmr
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @addtogroup dmr_hfw
+     * @{
+     */
+
+    /** @brief Sync word sources (each tests both the data and the voice sync). */
+    const uint8_t   DMR_SYNC_MS = 0x01U;
+    const uint8_t   DMR_SYNC_BS = 0x02U;
+    const uint8_t   DMR_SYNC_S1 = 0x04U;
+    const uint8_t   DMR_SYNC_S2 = 0x08U;
+
+    /** @brief Sync correlation results. */
+    const uint8_t   DMR_SYNC_NONE = 0x00U;
+    const uint8_t   DMR_SYNC_DATA = 0x01U;
+    const uint8_t   DMR_SYNC_VOICE = 0x02U;
+
+    /** @} */
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a single pass correlator of the DMR sync words.
+     * @details Every sync symbol is +3 or -3, so the second (magnitude) bit of every dibit is set in all
+     *  of the sync words. The magnitude bit errors are counted once and reject the bit buffer for every
+     *  candidate sync word when there are too many, which they almost always are while hunting; only
+     *  then are the sign bit errors counted for each candidate source. The voice sync of a source is its
+     *  data sync with every sign inverted, so one count gives the errors against both.
+     *
+     *  The sync words of different sources are at least 10 bits apart, so at most one candidate can
+     *  match for the error limits used.
+     * @ingroup dmr_hfw
+     */
+    class DSP_FW_API DMRSync {
+    public:
+        /**
+         * @brief Correlates the bit buffer against the candidate sync words.
+         * @param bits Bit buffer; the most recent 48 bits received.
+         * @param sources Sync word sources to test (DMR_SYNC_MS, DMR_SYNC_BS, DMR_SYNC_S1 and/or DMR_SYNC_S2).
+         * @param maxErrs Maximum number of bit errors of a match.
+         * @param[out] errs Number of bit errors of the match.
+         * @returns uint8_t DMR_SYNC_DATA or DMR_SYNC_VOICE on a match, otherwise DMR_SYNC_NONE.
+         */
+        static uint8_t correlate(uint64_t bits, uint8_t sources, uint8_t maxErrs, uint8_t& errs)
+        {
+            // the targets are 32-bit; work on the halves of the 48 bits
+            uint32_t lo = uint32_t(bits);
+            uint32_t hi = uint32_t(bits >> 32) & 0xFFFFU;
+
+            uint8_t mag = countBits32(~lo & uint32_t(DMR_SYNC_MAG_BITS_MASK)) +
+                countBits16(uint16_t(~hi & uint32_t(DMR_SYNC_MAG_BITS_MASK >> 32)));
+            if (mag > maxErrs)
+                return DMR_SYNC_NONE;
+
+            uint8_t ret = DMR_SYNC_NONE;
+            if ((sources & DMR_SYNC_MS) != 0U && (ret = matchSign(lo, hi, DMR_MS_DATA_SYNC_BITS, mag, maxErrs, errs)) != DMR_SYNC_NONE)
+                return ret;
+            if ((sources & DMR_SYNC_BS) != 0U && (ret = matchSign(lo, hi, DMR_BS_DATA_SYNC_BITS, mag, maxErrs, errs)) != DMR_SYNC_NONE)
+                return ret;
+            if ((sources & DMR_SYNC_S1) != 0U && (ret = matchSign(lo, hi, DMR_S1_DATA_SYNC_BITS, mag, maxErrs, errs)) != DMR_SYNC_NONE)
+                return ret;
+            if ((sources & DMR_SYNC_S2) != 0U && (ret = matchSign(lo, hi, DMR_S2_DATA_SYNC_BITS, mag, maxErrs, errs)) != DMR_SYNC_NONE)
+                return ret;
+
+            return DMR_SYNC_NONE;
+        }
+
+    private:
+        /**
+         * @brief Helper to count the sign bit errors against the data (and so the voice) sync of a source.
+         * @param lo Low 32 bits of the bit buffer.
+         * @param hi High 16 bits of the bit buffer.
+         * @param dataSync Data sync word of the source.
+         * @param mag Number of magnitude bit errors.
+         * @param maxErrs Maximum number of bit errors of a match.
+         * @param[out] errs Number of bit errors of the match.
+         * @returns uint8_t DMR_SYNC_DATA or DMR_SYNC_VOICE on a match, otherwise DMR_SYNC_NONE.
+         */
+        static uint8_t matchSign(uint32_t lo, uint32_t hi, uint64_t dataSync, uint8_t mag, uint8_t maxErrs, uint8_t& errs)
+        {
+            uint8_t sign = countBits32((lo ^ uint32_t(dataSync)) & uint32_t(DMR_SYNC_SIGN_BITS_MASK)) +
+                countBits16(uint16_t((hi ^ uint32_t(dataSync >> 32)) & uint32_t(DMR_SYNC_SIGN_BITS_MASK >> 32)));
+
+            // the 24 sign bits are inverted in the voice sync
+            if (mag + sign <= maxErrs) {
+                errs = mag + sign;
+                return DMR_SYNC_DATA;
+            }
+            if (mag + (24U - sign) <= maxErrs) {
+                errs = mag + (24U - sign);
+                return DMR_SYNC_VOICE;
+            }
+
+            return DMR_SYNC_NONE;
+        }
+    };
+} // namespace dmr
+
+#endif // __DMR_SYNC_H__
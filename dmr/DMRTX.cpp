@@ -60,8 +60,7 @@ DMRTX::DMRTX() :
     m_frameCount(0U),
     m_abortCount(),
     m_abort(),
-    m_cachATControl(0U),
-    m_controlPrev(MARK_NONE)
+    m_cachATControl(0U)
 {
     m_fifo[0U].reinitialize(DMR_TX_BUFFER_LEN);
     m_fifo[1U].reinitialize(DMR_TX_BUFFER_LEN);
@@ -80,6 +79,8 @@ DMRTX::DMRTX() :
 
 void DMRTX::process()
 {
+    PROFILE_SCOPE(PROBE_DMR_TX_PROCESS);
+
     if (m_state == DMRTXSTATE_IDLE)
         return;
 
@@ -113,21 +114,20 @@ void DMRTX::process()
 
     if (m_poLen > 0U) {
         uint16_t space = io.getSpace();
+        if (space <= 8U)
+            return;
 
-        while (space > 8U) {
-            uint8_t c = m_poBuffer[m_poPtr];
-            uint8_t m = m_markBuffer[m_poPtr];
-            m_poPtr++;
-
-            writeByte(c, m);
+        // write as many whole bytes as fit in one go
+        uint16_t count = (space - 1U) / 8U;
+        if (count > m_poLen - m_poPtr)
+            count = m_poLen - m_poPtr;
 
-            space -= 8U;
+        io.writeBytes(m_poBuffer + m_poPtr, count, m_markBuffer + m_poPtr);
+        m_poPtr += count;
 
-            if (m_poPtr >= m_poLen) {
-                m_poPtr = 0U;
-                m_poLen = 0U;
-                return;
-            }
+        if (m_poPtr >= m_poLen) {
+            m_poPtr = 0U;
+            m_poLen = 0U;
         }
     }
 }
@@ -262,6 +262,22 @@ uint8_t DMRTX::getSpace2() const
     return m_fifo[1U].getSpace() / (DMR_FRAME_LENGTH_BYTES + 2U);
 }
 
+/* Helper to get how long the frames queued for slot 1 take to go out. */
+
+uint16_t DMRTX::getQueuedMs1() const
+{
+    // each slot gets one burst every 60ms TDMA frame
+    return ((m_fifo[0U].getData() + DMR_FRAME_LENGTH_BYTES - 1U) / DMR_FRAME_LENGTH_BYTES) * 60U;
+}
+
+/* Helper to get how long the frames queued for slot 2 take to go out. */
+
+uint16_t DMRTX::getQueuedMs2() const
+{
+    // each slot gets one burst every 60ms TDMA frame
+    return ((m_fifo[1U].getData() + DMR_FRAME_LENGTH_BYTES - 1U) / DMR_FRAME_LENGTH_BYTES) * 60U;
+}
+
 /* Sets the ignore flags for setting the CACH Access Type bit. */
 
 void DMRTX::setIgnoreCACH_AT(uint8_t slot)
@@ -442,29 +458,3 @@ void DMRTX::createCal()
     m_poPtr = 0U;
 }
 
-/* Helper to write a raw byte to the DAC. */
-
-void DMRTX::writeByte(uint8_t c, uint8_t control)
-{
-    uint8_t bit;
-    uint8_t mask = 0x80U;
-    uint8_t controlToWrite = m_controlPrev;
-
-    for (uint8_t i = 0U; i < 8U; i++, c <<= 1) {
-        if ((c & mask) == mask)
-            bit = 1U;
-        else
-            bit = 0U;
-
-        if (i == 7U) {
-            if (control == MARK_SLOT2)
-                controlToWrite = true;
-            else if (control == MARK_SLOT1)
-                controlToWrite = false;
-
-            m_controlPrev = controlToWrite;
-        }
-
-        io.write(&bit, 1, &controlToWrite);
-    }
-}
@@ -113,6 +113,26 @@ namespace dmr
          * @returns uint8_t Amount of space in the slot 2 ring buffer.
          */
         uint8_t getSpace2() const;
+        /**
+         * @brief Helper to get how many bytes are free in the slot 1 ring buffer.
+         * @returns uint16_t Free space in the slot 1 ring buffer, in bytes.
+         */
+        uint16_t getFreeBytes1() const { return m_fifo[0U].getSpace(); }
+        /**
+         * @brief Helper to get how many bytes are free in the slot 2 ring buffer.
+         * @returns uint16_t Free space in the slot 2 ring buffer, in bytes.
+         */
+        uint16_t getFreeBytes2() const { return m_fifo[1U].getSpace(); }
+        /**
+         * @brief Helper to get how long the frames queued for slot 1 take to go out.
+         * @returns uint16_t Queued airtime, in milliseconds.
+         */
+        uint16_t getQueuedMs1() const;
+        /**
+         * @brief Helper to get how long the frames queued for slot 2 take to go out.
+         * @returns uint16_t Queued airtime, in milliseconds.
+         */
+        uint16_t getQueuedMs2() const;
 
         /**
          * @brief Sets the ignore flags for setting the CACH Access Type bit.
@@ -170,8 +190,6 @@ namespace dmr
 
         uint8_t m_cachATControl;
 
-        uint8_t m_controlPrev;
-
         /**
          * @brief Helper to generate data.
          * @param slotIndex 
@@ -187,13 +205,6 @@ namespace dmr
          * @brief Helper to generate calibration data.
          */
         void createCal();
-
-        /**
-         * @brief Helper to write a raw byte to the DAC.
-         * @param c Byte.
-         * @param control 
-         */
-        void writeByte(uint8_t c, uint8_t control);
     };
 } // namespace dmr
 
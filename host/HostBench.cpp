@@ -0,0 +1,2090 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "BitBuffer.h"
+#include "Utils.h"
+#include "Golay24128.h"
+#include "dmr/DMRAMBEFEC.h"
+#include "dmr/DMRBPTC.h"
+#include "dmr/DMRSlotType.h"
+#include "dmr/DMRSync.h"
+#include "p25/P25IMBEFEC.h"
+#include "p25/P25NID.h"
+#include "host/HostBench.h"
+#include "host/HostSim.h"
+
+#if defined(HOST_SIM)
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/** @brief Length of the ring buffers benchmarked (as used by IO). */
+const uint16_t BENCH_RING_LENGTH = 1024U;
+/** @brief Number of bits put into the ring buffer before they are got back. */
+const uint32_t BENCH_RING_BURST = 512U;
+/** @brief Number of bits between control level changes in the SPSC stress test. */
+const uint32_t BENCH_MARK_PERIOD = 97U;
+/** @brief FNV-1a parameters of the hashes the benchmarks compare implementations by. */
+const uint32_t BENCH_FNV_BASIS = 0x811C9DC5U;
+const uint32_t BENCH_FNV_PRIME = 0x01000193U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get a monotonic timestamp in nanoseconds. */
+
+static uint64_t now()
+{
+    struct timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+}
+
+/* Helper to fill a buffer with pseudo-random words. */
+
+static void fill(uint32_t* data, uint32_t length)
+{
+    uint32_t seed = 0x12345678U;
+    for (uint32_t i = 0U; i < length; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        data[i] = seed;
+    }
+}
+
+/* Helper to step the pseudo-random sequence the FEC benchmarks draw their frames and errors from. */
+
+static uint32_t nextRandom(uint32_t& seed)
+{
+    seed = seed * 1664525U + 1013904223U;
+    return seed;
+}
+
+/* Helper to fill a buffer with pseudo-random bytes. */
+
+static void randomBytes(uint8_t* data, uint32_t length, uint32_t& seed)
+{
+    for (uint32_t i = 0U; i < length; i++)
+        data[i] = uint8_t(nextRandom(seed) >> 24);
+}
+
+/* Helper to flip n (up to 16) distinct bits of a frame, drawn from the given bit positions. */
+
+static void injectErrors(uint8_t* frame, const uint16_t* positions, uint16_t count, uint8_t n, uint32_t& seed)
+{
+    uint16_t flipped[16U];
+    for (uint8_t i = 0U; i < n; ) {
+        uint16_t pos = positions[(nextRandom(seed) >> 16) % count];
+
+        bool again = false;
+        for (uint8_t j = 0U; j < i; j++)
+            again |= (flipped[j] == pos);
+        if (again)
+            continue;
+
+        flipped[i++] = pos;
+        _WRITE_BIT(frame, pos, !_READ_BIT(frame, pos));
+    }
+}
+
+/* Helper to display how often a check held for each number of bit errors injected (the entry after the
+   last counts noise, if given). */
+
+static void reportRates(const char* bench, const char* unit, const char* outcome, const uint32_t* total,
+    const uint32_t* held, uint8_t maxErrors, bool noise)
+{
+    for (uint8_t n = 0U; n <= maxErrors + (noise ? 1U : 0U); n++) {
+        char variant[32U];
+        if (n <= maxErrors)
+            ::snprintf(variant, sizeof(variant), "%u bit errors", n);
+        else
+            ::snprintf(variant, sizeof(variant), "noise");
+
+        ::fprintf(stdout, "%-12s %-30s %8u %s %8u %s (%.2f%%)\n", bench, variant, total[n], unit, held[n], outcome,
+            (total[n] > 0U) ? 100.0 * double(held[n]) / double(total[n]) : 0.0);
+    }
+}
+
+/* Helper to check the Golay (23,12) and (24,12) encoders and the vocoder PRNG against reference vectors. */
+
+static bool checkVocoderVectors(const char* bench)
+{
+    // parity of each data bit of the Golay (23,12) generator matrix (as tabulated by mbelib), data bit 11 first;
+    // the code is linear, so these determine every codeword
+    static const uint16_t GOLAY_23127_PARITY[] = {
+        0x63AU, 0x31DU, 0x7B4U, 0x3DAU, 0x1EDU, 0x6CCU, 0x366U, 0x1B3U, 0x6E3U, 0x54BU, 0x49FU, 0x475U };
+
+    for (uint8_t i = 0U; i < 12U; i++) {
+        uint32_t data = 0x800U >> i;
+        uint32_t code = (data << 11) | GOLAY_23127_PARITY[i];
+        if (Golay24128::encode23127(data) != code) {
+            ::fprintf(stderr, "%s: Golay (23,12) codeword of %03X is %06X, expected %06X\n", bench, data,
+                Golay24128::encode23127(data), code);
+            return false;
+        }
+
+        // the (24,12) codeword appends an even parity bit
+        code = (code << 1) | (countBits32(code) & 0x01U);
+        if (Golay24128::encode24128(data) != code) {
+            ::fprintf(stderr, "%s: Golay (24,12) codeword of %03X is %06X, expected %06X\n", bench, data,
+                Golay24128::encode24128(data), code);
+            return false;
+        }
+    }
+
+    // masks of the five vectors u1 - u5 scrambled by the 12 data bits of u0 (the AMBE B vector is u1), from
+    // an independent implementation of the mbelib PRNG
+    static const uint8_t PRNG_LENGTHS[] = { 23U, 23U, 23U, 15U, 15U, 15U };
+    static const struct {
+        uint16_t data;
+        uint32_t masks[6U];
+    } PRNG_VECTORS[] = {
+        { 0x000U, { 0x216623U, 0x44B656U, 0x569FAAU, 0x000E87U, 0x002FE4U, 0x006287U } },
+        { 0xFFFU, { 0x059F84U, 0x6B6F01U, 0x5A93BDU, 0x0014A7U, 0x004F43U, 0x0013B0U } },
+        { 0x5A5U, { 0x1FFCBBU, 0x2868BFU, 0x7277B8U, 0x006911U, 0x004D51U, 0x007B18U } } };
+
+    for (uint8_t i = 0U; i < 3U; i++) {
+        uint16_t p = uint16_t(PRNG_VECTORS[i].data << 4);
+        for (uint8_t j = 0U; j < 6U; j++) {
+            uint32_t mask = vocoderPRNG(p, PRNG_LENGTHS[j]);
+            if (mask != PRNG_VECTORS[i].masks[j]) {
+                ::fprintf(stderr, "%s: PRNG mask %u of %03X is %06X, expected %06X\n", bench, j, PRNG_VECTORS[i].data,
+                    mask, PRNG_VECTORS[i].masks[j]);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Deterministic pseudo-random bit stream, regenerated by the consumer of the SPSC stress test
+ *  to check the bits the producer put.
+ */
+struct BenchStream {
+    uint32_t seed;
+    uint32_t word;
+    uint8_t left;
+
+    /* Gets the next n (1 to 32) bits of the stream. */
+    uint32_t next(uint8_t n)
+    {
+        uint32_t bits = 0U;
+        for (uint8_t i = 0U; i < n; i++) {
+            if (left == 0U) {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                word = seed;
+                left = 32U;
+            }
+
+            bits = (bits << 1) | (word >> 31);
+            word <<= 1;
+            left--;
+        }
+
+        return bits;
+    }
+};
+
+/* Helper to get the control level of a bit in the SPSC stress test stream. */
+
+static uint8_t level(uint32_t n)
+{
+    return uint8_t((n / BENCH_MARK_PERIOD) & 0x01U);
+}
+
+/**
+ * @brief Shared state of the SPSC stress test threads.
+ */
+struct BenchSPSC {
+    BitBuffer* buffer;
+    uint32_t bits;
+
+    uint32_t failed;                    // bits the producer had to retry as the ring buffer was full
+    uint32_t marksFailed;               // control marks the producer had to retry as the mark queue was full
+    uint32_t errors;                    // bits (or control levels) the consumer got wrong
+    uint32_t got;                       // bits the consumer got
+};
+
+/* Producer side of the SPSC stress test; puts the stream in random sized chunks. */
+
+static void* spscProducer(void* arg)
+{
+    BenchSPSC* spsc = (BenchSPSC*)arg;
+    BenchStream data = { 0x12345678U, 0U, 0U };
+    BenchStream width = { 0x0BADF00DU, 0U, 0U };
+
+    uint32_t n = 0U;
+    while (n < spsc->bits) {
+        uint8_t w = uint8_t(width.next(5U)) + 1U;
+        if (w > spsc->bits - n)
+            w = uint8_t(spsc->bits - n);
+
+        uint32_t bits = data.next(w);
+
+        // a chunk holds at most one control level change; queue it ahead of the bits
+        if (w > 1U) {
+            for (uint8_t i = 0U; i < w; i++) {
+                if ((n + i) % BENCH_MARK_PERIOD == 0U) {
+                    while (!spsc->buffer->putMark(level(n + i), i)) {
+                        spsc->marksFailed++;
+                        sched_yield();
+                    }
+                }
+            }
+        }
+
+        for (;;) {
+            bool ok = (w == 1U) ? spsc->buffer->put(uint8_t(bits), level(n)) : spsc->buffer->putBits(bits, w);
+            if (ok)
+                break;
+
+            spsc->failed += w;
+            sched_yield();
+        }
+
+        n += w;
+    }
+
+    return NULL;
+}
+
+/* Consumer side of the SPSC stress test; gets random sized chunks and checks them against the stream. */
+
+static void* spscConsumer(void* arg)
+{
+    BenchSPSC* spsc = (BenchSPSC*)arg;
+    BenchStream data = { 0x12345678U, 0U, 0U };
+    BenchStream width = { 0xDEADBEEFU, 0U, 0U };
+
+    while (spsc->got < spsc->bits) {
+        uint8_t w = uint8_t(width.next(5U)) + 1U;
+        if (w > spsc->bits - spsc->got)
+            w = uint8_t(spsc->bits - spsc->got);
+
+        uint32_t bits = 0U, control = 0U;
+        for (;;) {
+            bool ok;
+            if (w == 1U) {
+                uint8_t bit = 0U, mark = 0U;
+                ok = spsc->buffer->get(bit, mark);
+                bits = bit;
+                control = mark;
+            }
+            else
+                ok = spsc->buffer->getBits(bits, control, w);
+
+            if (ok)
+                break;
+
+            sched_yield();
+        }
+
+        uint32_t expected = data.next(w);
+        uint32_t levels = 0U;
+        for (uint8_t i = 0U; i < w; i++)
+            levels = (levels << 1) | level(spsc->got + i);
+
+        if (bits != expected || control != levels)
+            spsc->errors += w;
+
+        spsc->got += w;
+    }
+
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Byte packed bit ring buffer, with separate bit and control arrays, compare based wraparound
+ *  and a shared full flag, as BitBuffer was implemented before it was word packed. Kept as the
+ *  baseline of the BitBuffer benchmark.
+ * @ingroup host_sim
+ */
+class LegacyBitBuffer {
+public:
+    /**
+     * @brief Initializes a new instance of the LegacyBitBuffer class.
+     * @param length Length of buffer.
+     */
+    LegacyBitBuffer(uint16_t length) :
+        m_length(length),
+        m_bits(NULL),
+        m_control(NULL),
+        m_head(0U),
+        m_tail(0U),
+        m_full(false),
+        m_overflow(false)
+    {
+        m_bits = new uint8_t[length / 8U];
+        m_control = new uint8_t[length / 8U];
+    }
+    /**
+     * @brief Finalizes a instance of the LegacyBitBuffer class.
+     */
+    ~LegacyBitBuffer()
+    {
+        delete[] m_bits;
+        delete[] m_control;
+    }
+
+    /**
+     * @brief Puts a bit into the ring buffer.
+     * @param bit Bit value.
+     * @param control Control mark for the bit.
+     * @returns bool True, if the bit was put, otherwise false if the ring buffer is full.
+     */
+    bool put(uint8_t bit, uint8_t control)
+    {
+        if (m_full) {
+            m_overflow = true;
+            return false;
+        }
+
+        _WRITE_BIT(m_bits, m_head, bit);
+        _WRITE_BIT(m_control, m_head, control);
+
+        m_head++;
+        if (m_head >= m_length)
+            m_head = 0U;
+
+        if (m_head == m_tail)
+            m_full = true;
+
+        return true;
+    }
+
+    /**
+     * @brief Gets a bit from the ring buffer.
+     * @param[out] bit Bit value.
+     * @param[out] control Control mark for the bit.
+     * @returns bool True, if a bit was got, otherwise false if the ring buffer is empty.
+     */
+    bool get(uint8_t& bit, uint8_t& control)
+    {
+        if (m_head == m_tail && !m_full)
+            return false;
+
+        bit = _READ_BIT(m_bits, m_tail);
+        control = _READ_BIT(m_control, m_tail);
+
+        m_full = false;
+
+        m_tail++;
+        if (m_tail >= m_length)
+            m_tail = 0U;
+
+        return true;
+    }
+
+private:
+    uint16_t m_length;
+    volatile uint8_t* m_bits;
+    volatile uint8_t* m_control;
+
+    volatile uint16_t m_head;
+    volatile uint16_t m_tail;
+
+    volatile bool m_full;
+
+    bool m_overflow;
+};
+
+/* Helper to pass bits one at a time through a bit ring buffer. */
+
+template <class T>
+static void bitwise(T& buffer, const uint32_t* in, uint32_t* out, uint32_t bits)
+{
+    for (uint32_t n = 0U; n < bits; n += BENCH_RING_BURST) {
+        for (uint32_t i = n; i < n + BENCH_RING_BURST; i++)
+            buffer.put((in[i >> 5] >> (31U - (i & 0x1FU))) & 0x01U, 0U);
+
+        uint32_t acc = 0U;
+        for (uint32_t i = n; i < n + BENCH_RING_BURST; i++) {
+            uint8_t bit = 0U, control = 0U;
+            buffer.get(bit, control);
+
+            acc = (acc << 1) | bit;
+            if ((i & 0x1FU) == 0x1FU)
+                out[i >> 5] = acc;
+        }
+    }
+}
+
+/* Helper to pass bits n at a time through the word packed bit ring buffer. */
+
+static void bulk(BitBuffer& buffer, const uint32_t* in, uint32_t* out, uint32_t bits, uint8_t n)
+{
+    uint32_t mask = (n == 32U) ? 0xFFFFFFFFU : ((1U << n) - 1U);
+
+    for (uint32_t j = 0U; j < bits; j += BENCH_RING_BURST) {
+        for (uint32_t i = j; i < j + BENCH_RING_BURST; i += n)
+            buffer.putBits((in[i >> 5] >> (32U - n - (i & 0x1FU))) & mask, n);
+
+        uint32_t acc = 0U;
+        for (uint32_t i = j; i < j + BENCH_RING_BURST; i += n) {
+            uint32_t value = 0U;
+            buffer.getBits(value, n);
+
+            acc = (n == 32U) ? value : ((acc << n) | value);
+            if (((i + n) & 0x1FU) == 0U)
+                out[i >> 5] = acc;
+        }
+    }
+}
+
+/** @brief Count of bits set in each byte value, as used by the byte table bit counts. */
+static const uint8_t LEGACY_BITS_TABLE[] = {
+#   define B2(n) n,     n+1,     n+1,     n+2
+#   define B4(n) B2(n), B2(n+1), B2(n+1), B2(n+2)
+#   define B6(n) B4(n), B4(n+1), B4(n+1), B4(n+2)
+    B6(0), B6(1), B6(1), B6(2)
+};
+
+/* Byte table 64-bit bit count, as countBits64() was implemented before it was inlined. Kept as the
+   baseline of the popcount benchmark. */
+
+static uint8_t __attribute__((noinline)) legacyCountBits64(ulong64_t bits)
+{
+    uint8_t* p = (uint8_t*)&bits;
+    uint8_t n = 0U;
+    n += LEGACY_BITS_TABLE[p[0U]];
+    n += LEGACY_BITS_TABLE[p[1U]];
+    n += LEGACY_BITS_TABLE[p[2U]];
+    n += LEGACY_BITS_TABLE[p[3U]];
+    n += LEGACY_BITS_TABLE[p[4U]];
+    n += LEGACY_BITS_TABLE[p[5U]];
+    n += LEGACY_BITS_TABLE[p[6U]];
+    n += LEGACY_BITS_TABLE[p[7U]];
+    return n;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/* Population count instruction 64-bit bit count, for comparison on hosts that have one. */
+
+static uint8_t __attribute__((target("popcnt"))) hwCountBits64(ulong64_t bits)
+{
+    return uint8_t(__builtin_popcountll(bits));
+}
+#endif
+
+/* Helper to sum the bit counts of a sliding 64-bit window, as the sync correlators use them. */
+
+template <typename F>
+static uint32_t correlate(F count, const uint32_t* in, uint32_t words)
+{
+    uint32_t total = 0U;
+    ulong64_t window = 0U;
+    for (uint32_t i = 0U; i < words; i++) {
+        for (uint8_t j = 0U; j < 32U; j++) {
+            window = (window << 1) | ((in[i] >> (31U - j)) & 0x01U);
+            total += count(window);
+        }
+    }
+
+    return total;
+}
+
+/* Multiple pass DMR sync correlator, as DMRDMORX::correlateSync() was implemented before the single pass
+   correlator (the sync bytes are unpacked on every call and only used for the debug output). Kept as the
+   baseline of the dmrsync benchmark. */
+
+static uint8_t __attribute__((noinline)) legacyCorrelateSync(uint64_t bitBuffer, uint8_t maxErrs, uint8_t& errs)
+{
+    using namespace dmr;
+
+    // unpack sync bytes
+    volatile uint8_t sync[DMR_SYNC_BYTES_LENGTH];
+    sync[0U] = (uint8_t)((bitBuffer >> 48) & 0xFFU);
+    sync[1U] = (uint8_t)((bitBuffer >> 40) & 0xFFU);
+    sync[2U] = (uint8_t)((bitBuffer >> 32) & 0xFFU);
+    sync[3U] = (uint8_t)((bitBuffer >> 24) & 0xFFU);
+    sync[4U] = (uint8_t)((bitBuffer >> 16) & 0xFFU);
+    sync[5U] = (uint8_t)((bitBuffer >> 8) & 0xFFU);
+    sync[6U] = (uint8_t)((bitBuffer >> 0) & 0xFFU);
+
+    if ((legacyCountBits64((bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_DATA_SYNC_BITS) <= maxErrs) ||
+        (legacyCountBits64((bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_S2_DATA_SYNC_BITS) <= maxErrs)) {
+        errs = 0U;
+        for (uint8_t i = 0U; i < DMR_SYNC_BYTES_LENGTH; i++)
+            errs += LEGACY_BITS_TABLE[(sync[i] & DMR_SYNC_BYTES_MASK[i]) ^ DMR_MS_DATA_SYNC_BYTES[i]];
+        return DMR_SYNC_DATA;
+    } else if ((legacyCountBits64((bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_VOICE_SYNC_BITS) <= maxErrs) ||
+        (legacyCountBits64((bitBuffer & DMR_SYNC_BITS_MASK) ^ DMR_S2_VOICE_SYNC_BITS) <= maxErrs)) {
+        errs = 0U;
+        for (uint8_t i = 0U; i < DMR_SYNC_BYTES_LENGTH; i++)
+            errs += LEGACY_BITS_TABLE[(sync[i] & DMR_SYNC_BYTES_MASK[i]) ^ DMR_MS_VOICE_SYNC_BYTES[i]];
+        return DMR_SYNC_VOICE;
+    }
+
+    return DMR_SYNC_NONE;
+}
+
+/* Single pass DMR sync correlator, for the dmrsync benchmark. */
+
+static uint8_t __attribute__((noinline)) correlateSync(uint64_t bitBuffer, uint8_t maxErrs, uint8_t& errs)
+{
+    return dmr::DMRSync::correlate(bitBuffer, dmr::DMR_SYNC_MS | dmr::DMR_SYNC_S2, maxErrs, errs);
+}
+
+/* Helper to run a DMR sync correlator over a stream, as the receivers do while hunting; returns a hash
+   of where the stream matched and as what. */
+
+template <typename F>
+static uint32_t hunt(F correlate, const uint32_t* in, uint32_t words, uint32_t& hits)
+{
+    uint32_t hash = BENCH_FNV_BASIS;
+    uint64_t window = 0U;
+    for (uint32_t i = 0U; i < words; i++) {
+        for (uint8_t j = 0U; j < 32U; j++) {
+            window = (window << 1) | ((in[i] >> (31U - j)) & 0x01U);
+
+            uint8_t errs = 0U;
+            uint8_t sync = correlate(window, 3U, errs);
+            if (sync != dmr::DMR_SYNC_NONE) {
+                hash = (hash ^ (i * 32U + j)) * BENCH_FNV_PRIME;
+                hash = (hash ^ sync) * BENCH_FNV_PRIME;
+                hits++;
+            }
+        }
+    }
+
+    return hash;
+}
+
+/* Bit at a time circular bit buffer copy, as the DMR receivers' bitsToBytes() were implemented before
+   ringBitsToBytes(). Kept as the baseline of the extract benchmark. */
+
+static void __attribute__((noinline)) legacyBitsToBytes(const uint8_t* ring, uint16_t length, uint16_t start, uint8_t count, uint8_t* buffer)
+{
+    for (uint8_t i = 0U; i < count; i++) {
+        buffer[i] = 0U;
+        for (uint8_t j = 0U; j < 8U; j++) {
+            buffer[i] |= _READ_BIT(ring, start) << (7U - j);
+            start++;
+            if (start >= length)
+                start -= length;
+        }
+    }
+}
+
+/* Polynomial long division (19,8) syndrome, as DMRSlotType::getSyndrome1987() was implemented before the
+   byte-wise tables. Kept as the baseline of the golay benchmark. */
+
+static uint32_t __attribute__((noinline)) legacySyndrome1987(uint32_t pattern)
+{
+    uint32_t aux = 0x00040000U;                 // X^18
+
+    if (pattern >= 0x00000800U) {               // X^11
+        while (pattern & 0xFFFFF800U) {
+            while (!(aux & pattern))
+                aux = aux >> 1;
+
+            pattern ^= (aux / 0x00000800U) * 0x00000C75U;
+        }
+    }
+
+    return pattern;
+}
+
+/* P25 frame write as P25RX and SerialPort::writeP25Data() were implemented before the scatter/gather
+   serial writer; the frame is copied from the receive buffer to the stack, and again into a cleared
+   reply. Kept as the baseline of the serial benchmark. */
+
+static void __attribute__((noinline)) legacyWriteP25Data(uint8_t flags, const uint8_t* buffer, uint16_t bytes)
+{
+    using namespace p25;
+
+    uint8_t frame[P25_PDU_FRAME_LENGTH_BYTES + 1U];
+    ::memcpy(frame + 1U, buffer, bytes);
+    frame[0U] = flags;
+
+    uint16_t length = bytes + 1U;
+
+    uint8_t reply[520U];
+    ::memset(reply, 0x00U, 520U);
+
+    if (length < 252U) {
+        reply[0U] = DVM_SHORT_FRAME_START;
+        reply[1U] = length + 3U;
+        reply[2U] = CMD_P25_DATA;
+        ::memcpy(reply + 3U, frame, length);
+
+        hostSim.getModemTX().write(reply, length + 3U);
+    }
+    else {
+        reply[0U] = DVM_LONG_FRAME_START;
+        reply[1U] = ((length + 4U) >> 8U) & 0xFFU;
+        reply[2U] = ((length + 4U) & 0xFFU);
+        reply[3U] = CMD_P25_DATA;
+        ::memcpy(reply + 4U, frame, length);
+
+        hostSim.getModemTX().write(reply, length + 4U);
+    }
+}
+
+/* Helper to read the packets written to the host into a buffer, skipping replies to the host's own commands. */
+
+static uint32_t readPackets(uint8_t* wire, uint16_t* packets, uint32_t& count)
+{
+    uint32_t length = 0U;
+    count = 0U;
+
+    uint16_t packetLength = SERIAL_FB_LEN;
+    while (hostSim.hostReadFrame(wire + length, packetLength)) {
+        if (wire[length] != DVM_SHORT_FRAME_START || wire[length + 2U] != CMD_ACK) {
+            packets[count++] = packetLength;
+            length += packetLength;
+        }
+
+        packetLength = SERIAL_FB_LEN;
+    }
+
+    return length;
+}
+
+/* Helper to dispatch a packet read by the host, unpacking a batch of frames; the dispatch sums each frame's command
+   and length into the sink. Returns the number of frames. */
+
+static uint32_t dispatch(const uint8_t* packet, uint16_t length, uint32_t& sink)
+{
+    if (packet[0U] != DVM_LONG_FRAME_START || packet[3U] != CMD_BATCH) {
+        sink += packet[2U] + length;
+        return 1U;
+    }
+
+    uint32_t frames = 0U;
+    for (uint16_t offset = SERIAL_BATCH_HEADER_LEN; offset + 3U <= length; frames++) {
+        const uint8_t* frame = packet + offset;
+        uint16_t frameLength = frame[1U];
+        uint8_t cmd = frame[2U];
+        if (frame[0U] == DVM_LONG_FRAME_START) {
+            frameLength = (frame[1U] << 8) + frame[2U];
+            cmd = frame[3U];
+        }
+        if (frameLength < 3U)
+            break;
+
+        sink += cmd + frameLength;
+        offset += frameLength;
+    }
+
+    return frames;
+}
+
+/* Helper to read a frame written to the host, tallying its length and whether it is one of the given lengths. */
+
+static bool readWhole(uint8_t* frame, const uint32_t* frameBytes, uint32_t& read, uint32_t& truncated)
+{
+    uint16_t length = SERIAL_FB_LEN;
+    if (!hostSim.hostReadFrame(frame, length))
+        return false;
+
+    if (length != frameBytes[0U] && length != frameBytes[1U])
+        truncated++;
+    read += length;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the HostBench class. */
+
+HostBench::HostBench(uint32_t iterations) :
+    m_iterations(iterations)
+{
+    /* stub */
+}
+
+/* Runs the named benchmark. */
+
+bool HostBench::run(const char* name)
+{
+    bool all = ::strcmp(name, "all") == 0;
+    bool found = false;
+    bool ret = true;
+
+    if (all || ::strcmp(name, "bitbuffer") == 0) {
+        found = true;
+        ret &= bitBuffer();
+    }
+
+    if (all || ::strcmp(name, "spsc") == 0) {
+        found = true;
+        ret &= spsc();
+    }
+
+    if (all || ::strcmp(name, "popcount") == 0) {
+        found = true;
+        ret &= popcount();
+    }
+
+    if (all || ::strcmp(name, "dmrsync") == 0) {
+        found = true;
+        ret &= dmrSync();
+    }
+
+    if (all || ::strcmp(name, "extract") == 0) {
+        found = true;
+        ret &= extract();
+    }
+
+    if (all || ::strcmp(name, "golay") == 0) {
+        found = true;
+        ret &= golay();
+    }
+
+    if (all || ::strcmp(name, "nid") == 0) {
+        found = true;
+        ret &= nid();
+    }
+
+    if (all || ::strcmp(name, "bptc") == 0) {
+        found = true;
+        ret &= bptc();
+    }
+
+    if (all || ::strcmp(name, "ambe") == 0) {
+        found = true;
+        ret &= ambe();
+    }
+
+    if (all || ::strcmp(name, "imbe") == 0) {
+        found = true;
+        ret &= imbe();
+    }
+
+    if (all || ::strcmp(name, "serial") == 0) {
+        found = true;
+        ret &= serialWrite();
+    }
+
+    if (all || ::strcmp(name, "uart") == 0) {
+        found = true;
+        ret &= uart();
+    }
+
+    if (all || ::strcmp(name, "batch") == 0) {
+        found = true;
+        ret &= batch();
+    }
+
+    if (all || ::strcmp(name, "credits") == 0) {
+        found = true;
+        ret &= credits();
+    }
+
+#if defined(ENABLE_PROFILER)
+    if (all || ::strcmp(name, "profiler") == 0) {
+        found = true;
+        ret &= profile();
+    }
+#endif
+
+    if (!found) {
+        ::fprintf(stderr, "unknown benchmark %s\n", name);
+        list();
+        return false;
+    }
+
+    return ret;
+}
+
+/* Displays the names of the available benchmarks. */
+
+void HostBench::list()
+{
+    ::fprintf(stdout, "benchmarks: all, bitbuffer, spsc, popcount, dmrsync, extract, golay, nid, bptc, ambe, imbe, serial, uart, batch, credits"
+#if defined(ENABLE_PROFILER)
+        ", profiler"
+#endif
+        "\n");
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Benchmarks the RX/TX bit ring buffer. */
+
+bool HostBench::bitBuffer()
+{
+    uint32_t bits = (m_iterations + BENCH_RING_BURST - 1U) / BENCH_RING_BURST * BENCH_RING_BURST;
+    uint32_t words = bits / 32U;
+
+    uint32_t* in = new uint32_t[words];
+    uint32_t* out = new uint32_t[words];
+    fill(in, words);
+
+    bool ret = true;
+
+    // byte packed, one bit at a time
+    {
+        LegacyBitBuffer buffer(BENCH_RING_LENGTH);
+        ::memset(out, 0x00U, words * sizeof(uint32_t));
+
+        uint64_t start = now();
+        bitwise(buffer, in, out, bits);
+        report("bitbuffer", "legacy put()/get()", now() - start, bits, "bit");
+
+        ret &= ::memcmp(in, out, words * sizeof(uint32_t)) == 0;
+    }
+
+    // word packed, one bit at a time
+    {
+        BitBuffer buffer(BENCH_RING_LENGTH);
+        ::memset(out, 0x00U, words * sizeof(uint32_t));
+
+        uint64_t start = now();
+        bitwise(buffer, in, out, bits);
+        report("bitbuffer", "put()/get()", now() - start, bits, "bit");
+
+        ret &= ::memcmp(in, out, words * sizeof(uint32_t)) == 0;
+    }
+
+    // word packed, 8 and 32 bits at a time
+    const uint8_t widths[] = { 8U, 32U };
+    for (uint32_t i = 0U; i < sizeof(widths); i++) {
+        BitBuffer buffer(BENCH_RING_LENGTH);
+        ::memset(out, 0x00U, words * sizeof(uint32_t));
+
+        char variant[32U];
+        ::snprintf(variant, sizeof(variant), "putBits()/getBits(%u)", widths[i]);
+
+        uint64_t start = now();
+        bulk(buffer, in, out, bits, widths[i]);
+        report("bitbuffer", variant, now() - start, bits, "bit");
+
+        ret &= ::memcmp(in, out, words * sizeof(uint32_t)) == 0;
+    }
+
+    delete[] in;
+    delete[] out;
+
+    if (!ret)
+        ::fprintf(stderr, "bitbuffer: bits got don't match the bits put\n");
+
+    // the mark queue holds BIT_RB_MARKS level changes; the next is refused and counted, and the levels
+    // queued still apply to their bits
+    {
+        BitBuffer buffer(BENCH_RING_LENGTH);
+        for (uint8_t i = 0U; i <= BIT_RB_MARKS; i++) {
+            bool queued = buffer.putMark((i & 0x01U) ? 0U : 1U, i);
+            if (queued != (i < BIT_RB_MARKS)) {
+                ::fprintf(stderr, "bitbuffer: mark %u %s\n", i, queued ? "queued past a full mark queue" : "refused");
+                ret = false;
+            }
+        }
+
+        uint32_t bits = 0U, control = 0U;
+        buffer.putBits(0U, 32U);
+        buffer.getBits(bits, control, 32U);
+        if (buffer.getMarksDropped() != 1U || control != 0xAAAA0000U) {
+            ::fprintf(stderr, "bitbuffer: mark drop counter is %u, control levels %08X; expected 1, AAAA0000\n",
+                buffer.getMarksDropped(), control);
+            ret = false;
+        }
+    }
+
+    return ret;
+}
+
+/* Stress tests the bit ring buffer with the producer and consumer on two threads. */
+
+bool HostBench::spsc()
+{
+    BitBuffer buffer(BENCH_RING_LENGTH);
+
+    BenchSPSC spsc;
+    ::memset(&spsc, 0x00U, sizeof(BenchSPSC));
+    spsc.buffer = &buffer;
+    spsc.bits = m_iterations;
+
+    uint64_t start = now();
+
+    pthread_t producer, consumer;
+    if (::pthread_create(&consumer, NULL, spscConsumer, &spsc) != 0) {
+        ::fprintf(stderr, "spsc: failed to start the consumer thread\n");
+        return false;
+    }
+    if (::pthread_create(&producer, NULL, spscProducer, &spsc) != 0) {
+        ::fprintf(stderr, "spsc: failed to start the producer thread\n");
+        ::pthread_cancel(consumer);
+        return false;
+    }
+
+    ::pthread_join(producer, NULL);
+    ::pthread_join(consumer, NULL);
+
+    report("spsc", "put()/putBits() | get()/getBits()", now() - start, spsc.bits, "bit");
+
+    // every bit the producer had to retry must be accounted for by the drop counter, and every bit
+    // must come out of the ring exactly once and in order
+    bool ret = true;
+    if (spsc.errors > 0U || buffer.getData() != 0U) {
+        ::fprintf(stderr, "spsc: %u bits lost, duplicated or reordered, %u bits left over\n", spsc.errors, buffer.getData());
+        ret = false;
+    }
+    if (buffer.getDropped() != spsc.failed) {
+        ::fprintf(stderr, "spsc: drop counter is %u, the producer was refused %u bits\n", buffer.getDropped(), spsc.failed);
+        ret = false;
+    }
+    if (buffer.getMarksDropped() != spsc.marksFailed) {
+        ::fprintf(stderr, "spsc: mark drop counter is %u, the producer was refused %u marks\n", buffer.getMarksDropped(), spsc.marksFailed);
+        ret = false;
+    }
+
+    ::fprintf(stdout, "%-12s %u bits passed, %u errors, %u bits refused while full (drop counter %u), %u marks refused\n", "spsc",
+        spsc.got, spsc.errors, spsc.failed, buffer.getDropped(), spsc.marksFailed);
+
+    return ret;
+}
+
+/* Benchmarks the bit counts used by the sync correlators. */
+
+bool HostBench::popcount()
+{
+    bool ret = true;
+
+    // the counts must agree with the byte table for every 8 and 16-bit value
+    for (uint32_t i = 0U; i < 0x10000U; i++) {
+        if (countBits8(uint8_t(i)) != LEGACY_BITS_TABLE[i & 0xFFU] ||
+            countBits16(uint16_t(i)) != LEGACY_BITS_TABLE[i & 0xFFU] + LEGACY_BITS_TABLE[i >> 8]) {
+            ::fprintf(stderr, "popcount: countBits8()/countBits16() disagree with the byte table at %04X\n", i);
+            ret = false;
+            break;
+        }
+    }
+
+    uint32_t words = (m_iterations + 31U) / 32U;
+    uint32_t* in = new uint32_t[words];
+    fill(in, words);
+
+    for (uint32_t i = 0U; i + 1U < words; i++) {
+        ulong64_t value = (ulong64_t(in[i]) << 32) | in[i + 1U];
+        if (countBits32(in[i]) != legacyCountBits64(in[i]) || countBits64(value) != legacyCountBits64(value)) {
+            ::fprintf(stderr, "popcount: countBits32()/countBits64() disagree with the byte table at word %u\n", i);
+            ret = false;
+            break;
+        }
+    }
+
+    uint32_t bits = words * 32U;
+
+    uint64_t start = now();
+    uint32_t legacy = correlate(legacyCountBits64, in, words);
+    report("popcount", "legacy table countBits64()", now() - start, bits, "bit");
+
+    start = now();
+    uint32_t current = correlate(countBits64, in, words);
+#if defined(COUNT_BITS_TABLE)
+    report("popcount", "table countBits64()", now() - start, bits, "bit");
+#elif defined(COUNT_BITS_BUILTIN)
+    report("popcount", "builtin countBits64()", now() - start, bits, "bit");
+#else
+    report("popcount", "SWAR countBits64()", now() - start, bits, "bit");
+#endif
+    ret &= current == legacy;
+
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt")) {
+        start = now();
+        uint32_t hw = correlate(hwCountBits64, in, words);
+        report("popcount", "popcnt instruction", now() - start, bits, "bit");
+        ret &= hw == legacy;
+    }
+#endif
+
+    delete[] in;
+
+    if (current != legacy)
+        ::fprintf(stderr, "popcount: correlation totals disagree (%u, legacy %u)\n", current, legacy);
+
+    return ret;
+}
+
+/* Benchmarks the DMR sync correlator while hunting. */
+
+bool HostBench::dmrSync()
+{
+    using namespace dmr;
+
+    uint32_t words = (m_iterations + 31U) / 32U;
+    uint32_t* in = new uint32_t[words];
+    fill(in, words);
+
+    // plant a sync word (of every source, so the ones not tested must not match) with 0 to 3 bit errors
+    // in every 9th word
+    const uint64_t SYNCS[] = { DMR_MS_DATA_SYNC_BITS, DMR_MS_VOICE_SYNC_BITS, DMR_S2_DATA_SYNC_BITS, DMR_S2_VOICE_SYNC_BITS,
+        DMR_BS_DATA_SYNC_BITS, DMR_BS_VOICE_SYNC_BITS, DMR_S1_DATA_SYNC_BITS, DMR_S1_VOICE_SYNC_BITS };
+    uint32_t planted = 0U;
+    for (uint32_t i = 0U; i + 2U < words; i += 9U, planted++) {
+        uint64_t sync = SYNCS[planted % 8U];
+        for (uint8_t n = 0U; n < (planted / 8U) % 4U; n++)
+            sync ^= 1ULL << (in[i + 2U] >> (n * 8U)) % 48U;
+
+        in[i] = (in[i] & 0xFFFF0000U) | uint32_t(sync >> 32);
+        in[i + 1U] = uint32_t(sync);
+    }
+
+    uint32_t bits = words * 32U;
+    uint32_t legacyHits = 0U, hits = 0U;
+
+    uint64_t start = now();
+    uint32_t legacy = hunt(legacyCorrelateSync, in, words, legacyHits);
+    report("dmrsync", "legacy correlateSync()", now() - start, bits, "bit");
+
+    start = now();
+    uint32_t current = hunt(correlateSync, in, words, hits);
+    report("dmrsync", "DMRSync::correlate()", now() - start, bits, "bit");
+
+    delete[] in;
+
+    ::fprintf(stdout, "%-12s %u sync words planted, %u matched (legacy %u)\n", "dmrsync", planted, hits, legacyHits);
+
+    if (current != legacy || hits != legacyHits) {
+        ::fprintf(stderr, "dmrsync: the correlators matched the stream differently\n");
+        return false;
+    }
+
+    return true;
+}
+
+/* Benchmarks the DMR burst extraction from the receivers' circular bit buffers. */
+
+bool HostBench::extract()
+{
+    using namespace dmr;
+
+    // the DMRDMORX/DMRSlotRX and DMRIdleRX buffer lengths
+    const uint16_t LENGTHS[] = { 576U, 320U };
+
+    uint32_t ring[576U / 32U];
+    fill(ring, 576U / 32U);
+    const uint8_t* bytes = (const uint8_t*)ring;
+
+    // every start position and count must copy the same bytes as the bit at a time copy
+    bool ret = true;
+    for (uint8_t l = 0U; l < 2U && ret; l++) {
+        for (uint16_t start = 0U; start < LENGTHS[l] && ret; start++) {
+            for (uint8_t count = 1U; count < LENGTHS[l] / 8U; count++) {
+                uint8_t expected[72U], got[72U];
+                legacyBitsToBytes(bytes, LENGTHS[l], start, count, expected);
+                ringBitsToBytes(bytes, LENGTHS[l], start, count, got);
+                if (::memcmp(expected, got, count) != 0) {
+                    ::fprintf(stderr, "extract: %u bytes from bit %u of a %u bit buffer don't match\n", count, start, LENGTHS[l]);
+                    ret = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    // time whole bursts from pseudo-random start positions
+    uint32_t bursts = m_iterations / DMR_FRAME_LENGTH_BITS;
+    uint16_t* starts = new uint16_t[bursts];
+    uint32_t seed = 0x0BADF00DU;
+    for (uint32_t i = 0U; i < bursts; i++) {
+        starts[i] = uint16_t((nextRandom(seed) >> 16) % 576U);
+    }
+
+    uint8_t frame[DMR_FRAME_LENGTH_BYTES];
+    uint32_t legacy = BENCH_FNV_BASIS, current = BENCH_FNV_BASIS;
+
+    uint64_t start = now();
+    for (uint32_t i = 0U; i < bursts; i++) {
+        legacyBitsToBytes(bytes, 576U, starts[i], DMR_FRAME_LENGTH_BYTES, frame);
+        legacy = (legacy ^ frame[i % DMR_FRAME_LENGTH_BYTES]) * BENCH_FNV_PRIME;
+    }
+    report("extract", "legacy bitsToBytes()", now() - start, bursts, "burst");
+
+    start = now();
+    for (uint32_t i = 0U; i < bursts; i++) {
+        ringBitsToBytes(bytes, 576U, starts[i], DMR_FRAME_LENGTH_BYTES, frame);
+        current = (current ^ frame[i % DMR_FRAME_LENGTH_BYTES]) * BENCH_FNV_PRIME;
+    }
+    report("extract", "ringBitsToBytes()", now() - start, bursts, "burst");
+
+    delete[] starts;
+
+    if (current != legacy) {
+        ::fprintf(stderr, "extract: the timed bursts don't match\n");
+        ret = false;
+    }
+
+    return ret;
+}
+
+/* Benchmarks the DMR slot type (19,8) syndrome and decoder. */
+
+bool HostBench::golay()
+{
+    using namespace dmr;
+
+    DMRSlotType slotType;
+    bool ret = true;
+
+    // every correction the decoding table makes must be for its syndrome
+    for (uint32_t syndrome = 0U; syndrome < 0x800U; syndrome++) {
+        uint32_t error = slotType.errorPattern1987(syndrome);
+        if (error != 0U && legacySyndrome1987(error) != syndrome) {
+            ::fprintf(stderr, "golay: decoding table entry %03X (%05X) isn't for its syndrome\n", syndrome, error);
+            ret = false;
+        }
+    }
+
+    // every 19 bit pattern must have the same syndrome
+    uint32_t legacy = 0U, current = 0U;
+
+    uint64_t start = now();
+    for (uint32_t pattern = 0U; pattern < 0x80000U; pattern++)
+        legacy = (legacy ^ legacySyndrome1987(pattern)) * BENCH_FNV_PRIME;
+    report("golay", "legacy getSyndrome1987()", now() - start, 0x80000U, "pattern");
+
+    start = now();
+    for (uint32_t pattern = 0U; pattern < 0x80000U; pattern++)
+        current = (current ^ slotType.syndrome1987(pattern)) * BENCH_FNV_PRIME;
+    report("golay", "table getSyndrome1987()", now() - start, 0x80000U, "pattern");
+
+    for (uint32_t pattern = 0U; pattern < 0x80000U && current != legacy; pattern++) {
+        if (slotType.syndrome1987(pattern) != legacySyndrome1987(pattern)) {
+            ::fprintf(stderr, "golay: syndrome of %05X is %03X, legacy %03X\n", pattern, slotType.syndrome1987(pattern),
+                legacySyndrome1987(pattern));
+            ret = false;
+            break;
+        }
+    }
+
+    // and every 20 bit slot type must decode as before
+    start = now();
+    for (uint32_t word = 0U; word < 0x100000U; word++) {
+        uint8_t frame[DMR_FRAME_LENGTH_BYTES];
+        ::memset(frame, 0x00U, DMR_FRAME_LENGTH_BYTES);
+        frame[12U] = (word >> 14) & 0x3FU;
+        frame[13U] = (word >> 6) & 0xF0U;
+        frame[19U] = (word >> 6) & 0x0FU;
+        frame[20U] = (word << 2) & 0xFCU;
+
+        uint8_t colorCode, dataType;
+        slotType.decode(frame, colorCode, dataType);
+
+        uint32_t code = word >> 1;
+        code ^= slotType.errorPattern1987(legacySyndrome1987(code));
+        if (colorCode != ((code >> 15) & 0x0FU) || dataType != ((code >> 11) & 0x0FU)) {
+            ::fprintf(stderr, "golay: slot type %05X decodes as %X/%X, legacy %X/%X\n", word, colorCode, dataType,
+                (code >> 15) & 0x0FU, (code >> 11) & 0x0FU);
+            ret = false;
+            break;
+        }
+    }
+    report("golay", "decode() (and legacy check)", now() - start, 0x100000U, "word");
+
+    return ret;
+}
+
+/* Benchmarks the P25 NID BCH (63,16) decoder. */
+
+bool HostBench::nid()
+{
+    using namespace p25;
+
+    // the 63 BCH bits (and the parity bit) follow the frame sync, around the status symbol at frame bits 70 - 71
+    const uint32_t NID_FRAME_LENGTH_BYTES = 15U;
+    uint16_t positions[P25_NID_FEC_LENGTH_BITS];
+    for (uint8_t bit = 0U; bit < P25_NID_FEC_LENGTH_BITS; bit++)
+        positions[bit] = (bit < 22U) ? (48U + bit) : (50U + bit);
+
+    // NIDs encoded from the BCH (63,16) generator of TIA-102.BAAA (octal 6331141367235453) by an independent
+    // implementation, with the parity bit clear
+    static const struct {
+        uint16_t nac;
+        uint8_t duid;
+        uint64_t nid;
+    } NID_VECTORS[] = {
+        { 0x293U, 0x05U, 0x293555EF2C653436U },
+        { 0x293U, 0x0AU, 0x293ABA93BEC26A2AU },
+        { 0xF7EU, 0x00U, 0xF7E0CA9A425D42F0U },
+        { 0x000U, 0x03U, 0x0003364C2F74ECACU } };
+
+    P25NID nid;
+    for (uint8_t i = 0U; i < 4U; i++) {
+        uint8_t frame[NID_FRAME_LENGTH_BYTES], expected[NID_FRAME_LENGTH_BYTES];
+        ::memset(frame, 0x00U, NID_FRAME_LENGTH_BYTES);
+        ::memset(expected, 0x00U, NID_FRAME_LENGTH_BYTES);
+        for (uint8_t bit = 0U; bit < P25_NID_FEC_LENGTH_BITS; bit++)
+            _WRITE_BIT(expected, positions[bit], (NID_VECTORS[i].nid >> (63U - bit)) & 0x01U);
+
+        nid.encode(NID_VECTORS[i].nac, NID_VECTORS[i].duid, frame);
+        if (::memcmp(frame, expected, NID_FRAME_LENGTH_BYTES) != 0) {
+            ::fprintf(stderr, "nid: NID of NAC %03X DUID %X isn't %016llX\n", NID_VECTORS[i].nac, NID_VECTORS[i].duid,
+                (unsigned long long)NID_VECTORS[i].nid);
+            return false;
+        }
+    }
+
+    // NIDs with 0 - 15 bit errors; the parity bit and the status symbol are randomized too, and must be left
+    // as they are
+    uint32_t count = m_iterations / P25_NID_FEC_LENGTH_BITS;
+    uint8_t* frames = new uint8_t[count * NID_FRAME_LENGTH_BYTES];
+    uint8_t* expected = new uint8_t[count * NID_FRAME_LENGTH_BYTES];
+
+    uint32_t seed = 0x0BADF00DU;
+    for (uint32_t i = 0U; i < count; i++) {
+        uint8_t* frame = frames + i * NID_FRAME_LENGTH_BYTES;
+        ::memset(frame, 0x00U, NID_FRAME_LENGTH_BYTES);
+
+        nextRandom(seed);
+        nid.encode((seed >> 8) & 0xFFFU, (seed >> 20) & 0x0FU, frame);
+        _WRITE_BIT(frame, 70U, (seed >> 1) & 0x01U);
+        _WRITE_BIT(frame, 71U, (seed >> 2) & 0x01U);
+        _WRITE_BIT(frame, 113U, (seed >> 3) & 0x01U);
+        ::memcpy(expected + i * NID_FRAME_LENGTH_BYTES, frame, NID_FRAME_LENGTH_BYTES);
+
+        injectErrors(frame, positions, P25_NID_FEC_LENGTH_BITS - 1U, uint8_t(i % 16U), seed);
+    }
+
+    uint16_t* nacs = new uint16_t[count];
+    uint8_t* duids = new uint8_t[count];
+    uint8_t* errs = new uint8_t[count];
+    bool* decoded = new bool[count];
+
+    uint64_t start = now();
+    for (uint32_t i = 0U; i < count; i++)
+        decoded[i] = nid.decode(frames + i * NID_FRAME_LENGTH_BYTES, nacs[i], duids[i], errs[i]);
+    report("nid", "BCH (63,16) decode()", now() - start, count, "NID");
+
+    // up to 11 errors must be corrected (and counted); beyond that the NID must be rejected or miscorrected
+    // to another codeword
+    bool ret = true;
+    uint32_t rejected = 0U, miscorrected = 0U, beyond = 0U;
+    for (uint32_t i = 0U; i < count; i++) {
+        const uint8_t* frame = frames + i * NID_FRAME_LENGTH_BYTES;
+        const uint8_t* original = expected + i * NID_FRAME_LENGTH_BYTES;
+        uint8_t n = uint8_t(i % 16U);
+        bool match = decoded[i] && ::memcmp(frame, original, NID_FRAME_LENGTH_BYTES) == 0;
+
+        if (n <= 11U) {
+            uint16_t nac = (original[6U] << 4) | (original[7U] >> 4);
+            if (!match || nacs[i] != nac || duids[i] != (original[7U] & 0x0FU) || errs[i] != n) {
+                ::fprintf(stderr, "nid: NID %u with %u errors wasn't corrected\n", i, n);
+                ret = false;
+                break;
+            }
+        }
+        else {
+            beyond++;
+            if (!decoded[i])
+                rejected++;
+            else if (match || errs[i] > 11U)
+                ret = false;
+            else
+                miscorrected++;
+        }
+    }
+
+    ::fprintf(stdout, "%-12s %u NIDs with 12 - 15 errors: %u rejected, %u miscorrected\n", "nid", beyond, rejected, miscorrected);
+
+    delete[] frames;
+    delete[] expected;
+    delete[] nacs;
+    delete[] duids;
+    delete[] errs;
+    delete[] decoded;
+
+    return ret;
+}
+
+/* Benchmarks the DMR BPTC (196,96) decoder and payload CRC check. */
+
+bool HostBench::bptc()
+{
+    using namespace dmr;
+
+    // the CRC is the inverted CRC-16/XMODEM, whose check value (the CRC of "123456789") is 31C3
+    const uint8_t CHECK[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    if (crcCCITT162(CHECK, 9U) != 0xCE3CU) {
+        ::fprintf(stderr, "bptc: CRC of the check string is %04X, expected CE3C\n", crcCCITT162(CHECK, 9U));
+        return false;
+    }
+
+    // the BPTC bits either side of the sync, but the first (frame bits 1 - 97, 166 - 263)
+    uint16_t positions[195U];
+    for (uint16_t bit = 0U; bit < 195U; bit++)
+        positions[bit] = (bit < 97U) ? (1U + bit) : (69U + bit);
+
+    // CSBKs with 0 - 7 bit errors among the 196 BPTC bits, and noise
+    const uint8_t MAX_ERRORS = 7U;
+    uint32_t count = m_iterations / DMR_FRAME_LENGTH_BITS;
+    uint8_t* frames = new uint8_t[count * DMR_FRAME_LENGTH_BYTES];
+    uint8_t* payloads = new uint8_t[count * DMR_BPTC_DATA_LENGTH_BYTES];
+
+    DMRBPTC bptc;
+    uint32_t seed = 0x0BADF00DU;
+    for (uint32_t i = 0U; i < count; i++) {
+        uint8_t* frame = frames + i * DMR_FRAME_LENGTH_BYTES;
+        uint8_t* data = payloads + i * DMR_BPTC_DATA_LENGTH_BYTES;
+        randomBytes(frame, DMR_FRAME_LENGTH_BYTES, seed);
+
+        if ((i % (MAX_ERRORS + 2U)) > MAX_ERRORS)
+            continue;
+
+        randomBytes(data, DMR_BPTC_DATA_LENGTH_BYTES - 2U, seed);
+
+        uint16_t crc = crcCCITT162(data, DMR_BPTC_DATA_LENGTH_BYTES - 2U) ^ DMR_CSBK_CRC_MASK;
+        data[10U] = uint8_t(crc >> 8);
+        data[11U] = uint8_t(crc & 0xFFU);
+        bptc.encode(data, frame);
+
+        injectErrors(frame, positions, 195U, uint8_t(i % (MAX_ERRORS + 2U)), seed);
+    }
+
+    bool* valid = new bool[count];
+
+    uint64_t start = now();
+    for (uint32_t i = 0U; i < count; i++)
+        valid[i] = bptc.validate(frames + i * DMR_FRAME_LENGTH_BYTES, DT_CSBK);
+    report("bptc", "BPTC (196,96) validate()", now() - start, count, "burst");
+
+    // up to 2 errors must always be corrected; beyond that, report how many are
+    bool ret = true;
+    uint32_t total[MAX_ERRORS + 2U], passed[MAX_ERRORS + 2U];
+    ::memset(total, 0x00U, sizeof(total));
+    ::memset(passed, 0x00U, sizeof(passed));
+    for (uint32_t i = 0U; i < count; i++) {
+        uint8_t n = uint8_t(i % (MAX_ERRORS + 2U));
+        total[n]++;
+        if (valid[i])
+            passed[n]++;
+
+        if (n <= 2U) {
+            uint8_t data[DMR_BPTC_DATA_LENGTH_BYTES];
+            bptc.decode(frames + i * DMR_FRAME_LENGTH_BYTES, data);
+            if (!valid[i] || ::memcmp(data, payloads + i * DMR_BPTC_DATA_LENGTH_BYTES, DMR_BPTC_DATA_LENGTH_BYTES) != 0) {
+                ::fprintf(stderr, "bptc: burst %u with %u errors wasn't corrected\n", i, n);
+                ret = false;
+                break;
+            }
+        }
+    }
+
+    reportRates("bptc", "bursts", "valid", total, passed, MAX_ERRORS, true);
+
+    delete[] frames;
+    delete[] payloads;
+    delete[] valid;
+
+    return ret;
+}
+
+/* Benchmark of the DMR voice burst AMBE FEC check. */
+
+bool HostBench::ambe()
+{
+    using namespace dmr;
+
+    // the encoder builds the vectors from the Golay encoders and the PRNG
+    if (!checkVocoderVectors("ambe"))
+        return false;
+
+    DMRAMBEFEC ambeFEC;
+    uint32_t seed = 0x5EEDFACEU;
+
+    // find the FEC protected bits of a burst; flipping any one of them is a single corrected bit
+    uint8_t frame[DMR_FRAME_LENGTH_BYTES];
+    randomBytes(frame, DMR_FRAME_LENGTH_BYTES, seed);
+    ambeFEC.encode(frame);
+
+    if (ambeFEC.getErrors(frame) != 0U) {
+        ::fprintf(stderr, "ambe: encoded burst has %u errors\n", ambeFEC.getErrors(frame));
+        return false;
+    }
+
+    uint16_t positions[DMR_FRAME_LENGTH_BITS];
+    uint16_t protectedBits = 0U;
+    for (uint16_t pos = 0U; pos < DMR_FRAME_LENGTH_BITS; pos++) {
+        _WRITE_BIT(frame, pos, !_READ_BIT(frame, pos));
+        uint8_t errs = ambeFEC.getErrors(frame);
+        _WRITE_BIT(frame, pos, !_READ_BIT(frame, pos));
+
+        if (errs > 1U) {
+            ::fprintf(stderr, "ambe: single error at bit %u counted as %u\n", pos, errs);
+            return false;
+        }
+
+        if (errs == 1U)
+            positions[protectedBits++] = pos;
+    }
+
+    // 3 frames of a 24 bit A vector and a 23 bit B vector
+    if (protectedBits != 141U) {
+        ::fprintf(stderr, "ambe: %u FEC protected bits, expected 141\n", protectedBits);
+        return false;
+    }
+
+    // voice bursts with 0 - 7 bit errors among the protected bits
+    const uint8_t MAX_ERRORS = 7U;
+    uint32_t count = m_iterations / DMR_FRAME_LENGTH_BITS;
+    uint8_t* frames = new uint8_t[count * DMR_FRAME_LENGTH_BYTES];
+
+    for (uint32_t i = 0U; i < count; i++) {
+        uint8_t* burst = frames + i * DMR_FRAME_LENGTH_BYTES;
+        randomBytes(burst, DMR_FRAME_LENGTH_BYTES, seed);
+        ambeFEC.encode(burst);
+
+        injectErrors(burst, positions, protectedBits, uint8_t(i % (MAX_ERRORS + 1U)), seed);
+    }
+
+    uint8_t* counts = new uint8_t[count];
+
+    uint64_t start = now();
+    for (uint32_t i = 0U; i < count; i++)
+        counts[i] = ambeFEC.getErrors(frames + i * DMR_FRAME_LENGTH_BYTES);
+    report("ambe", "AMBE FEC getErrors()", now() - start, count, "burst");
+
+    // up to 3 errors can't overload any one codeword, and must be counted exactly; beyond that, report how
+    // often the count is exact
+    bool ret = true;
+    uint32_t total[MAX_ERRORS + 1U], exact[MAX_ERRORS + 1U];
+    ::memset(total, 0x00U, sizeof(total));
+    ::memset(exact, 0x00U, sizeof(exact));
+    for (uint32_t i = 0U; i < count; i++) {
+        uint8_t n = uint8_t(i % (MAX_ERRORS + 1U));
+        total[n]++;
+        if (counts[i] == n)
+            exact[n]++;
+        else if (n <= 3U) {
+            ::fprintf(stderr, "ambe: burst %u with %u errors counted as %u\n", i, n, counts[i]);
+            ret = false;
+            break;
+        }
+    }
+
+    reportRates("ambe", "bursts", "exact", total, exact, MAX_ERRORS, false);
+
+    delete[] frames;
+    delete[] counts;
+
+    return ret;
+}
+
+/* Benchmark of the P25 LDU IMBE FEC check. */
+
+bool HostBench::imbe()
+{
+    using namespace p25;
+
+    // rows of the Hamming (15,11) generator matrix of TIA-102.BABA (as tabulated by mbelib), data bit 0 first;
+    // every sum of them must be a codeword, and every single bit error in one must be detected
+    static const uint16_t HAMMING_15113_ROWS[] = {
+        0x400FU, 0x200EU, 0x100DU, 0x080CU, 0x040BU, 0x020AU, 0x0109U, 0x0087U, 0x0046U, 0x0025U, 0x0013U };
+
+    for (uint32_t data = 0U; data < 0x800U; data++) {
+        uint32_t code = 0U;
+        for (uint8_t i = 0U; i < 11U; i++) {
+            if ((data >> (10U - i)) & 0x01U)
+                code ^= HAMMING_15113_ROWS[i];
+        }
+
+        if (P25IMBEFEC::getSyndrome15113(code) != 0U) {
+            ::fprintf(stderr, "imbe: Hamming (15,11) codeword %04X has syndrome %X\n", code, P25IMBEFEC::getSyndrome15113(code));
+            return false;
+        }
+
+        for (uint8_t i = 0U; i < 15U; i++) {
+            if (P25IMBEFEC::getSyndrome15113(code ^ (0x01U << i)) == 0U) {
+                ::fprintf(stderr, "imbe: Hamming (15,11) codeword %04X with bit %u flipped is valid\n", code, i);
+                return false;
+            }
+        }
+    }
+
+    if (!checkVocoderVectors("imbe"))
+        return false;
+
+    P25IMBEFEC imbeFEC;
+    uint32_t seed = 0x1B0EFECU;
+
+    // find the FEC protected bits of a LDU; flipping any one of them is a single error in one of the codes
+    uint8_t ldu[P25_LDU_FRAME_LENGTH_BYTES];
+    randomBytes(ldu, P25_LDU_FRAME_LENGTH_BYTES, seed);
+    imbeFEC.encode(ldu);
+
+    uint8_t golayErrs = 0U, hammingErrs = 0U;
+    imbeFEC.getErrors(ldu, golayErrs, hammingErrs);
+    if (golayErrs != 0U || hammingErrs != 0U) {
+        ::fprintf(stderr, "imbe: encoded LDU has %u/%u errors\n", golayErrs, hammingErrs);
+        return false;
+    }
+
+    uint16_t* positions = new uint16_t[P25_LDU_FRAME_LENGTH_BITS];
+    uint16_t golayBits = 0U, hammingBits = 0U;
+    for (uint16_t pos = 0U; pos < P25_LDU_FRAME_LENGTH_BITS; pos++) {
+        _WRITE_BIT(ldu, pos, !_READ_BIT(ldu, pos));
+        imbeFEC.getErrors(ldu, golayErrs, hammingErrs);
+        _WRITE_BIT(ldu, pos, !_READ_BIT(ldu, pos));
+
+        if (golayErrs + hammingErrs > 1U) {
+            ::fprintf(stderr, "imbe: single error at bit %u counted as %u/%u\n", pos, golayErrs, hammingErrs);
+            delete[] positions;
+            return false;
+        }
+
+        if (golayErrs == 1U)
+            positions[golayBits++] = pos;
+        if (hammingErrs == 1U)
+            hammingBits++;
+    }
+
+    // 9 frames of four 23 bit Golay codewords and three 15 bit Hamming codewords
+    if (golayBits != 828U || hammingBits != 405U) {
+        ::fprintf(stderr, "imbe: %u Golay and %u Hamming protected bits, expected 828 and 405\n", golayBits, hammingBits);
+        delete[] positions;
+        return false;
+    }
+
+    // LDUs with 0 - 7 bit errors among the Golay protected bits
+    const uint8_t MAX_ERRORS = 7U;
+    uint32_t count = m_iterations / P25_LDU_FRAME_LENGTH_BITS;
+    uint8_t* frames = new uint8_t[count * P25_LDU_FRAME_LENGTH_BYTES];
+
+    for (uint32_t i = 0U; i < count; i++) {
+        uint8_t* frame = frames + i * P25_LDU_FRAME_LENGTH_BYTES;
+        randomBytes(frame, P25_LDU_FRAME_LENGTH_BYTES, seed);
+        imbeFEC.encode(frame);
+
+        injectErrors(frame, positions, golayBits, uint8_t(i % (MAX_ERRORS + 1U)), seed);
+    }
+
+    uint8_t* golayCounts = new uint8_t[count];
+    uint8_t* hammingCounts = new uint8_t[count];
+
+    uint64_t start = now();
+    for (uint32_t i = 0U; i < count; i++)
+        imbeFEC.getErrors(frames + i * P25_LDU_FRAME_LENGTH_BYTES, golayCounts[i], hammingCounts[i]);
+    report("imbe", "IMBE FEC getErrors()", now() - start, count, "LDU");
+
+    // up to 3 errors can't overload any one codeword, and must be counted exactly; beyond that, report how
+    // often the count is exact
+    bool ret = true;
+    uint32_t total[MAX_ERRORS + 1U], exact[MAX_ERRORS + 1U];
+    ::memset(total, 0x00U, sizeof(total));
+    ::memset(exact, 0x00U, sizeof(exact));
+    for (uint32_t i = 0U; i < count; i++) {
+        uint8_t n = uint8_t(i % (MAX_ERRORS + 1U));
+        total[n]++;
+        if (golayCounts[i] == n && hammingCounts[i] == 0U)
+            exact[n]++;
+        else if (n <= 3U) {
+            ::fprintf(stderr, "imbe: LDU %u with %u errors counted as %u/%u\n", i, n, golayCounts[i], hammingCounts[i]);
+            ret = false;
+            break;
+        }
+    }
+
+    reportRates("imbe", "LDUs", "exact", total, exact, MAX_ERRORS, false);
+
+    delete[] positions;
+    delete[] frames;
+    delete[] golayCounts;
+    delete[] hammingCounts;
+
+    return ret;
+}
+
+/* Benchmarks the P25 frame write to the host. */
+
+bool HostBench::serialWrite()
+{
+    using namespace p25;
+
+    // the writer only runs in P25 (or idle) mode with P25 enabled
+    DVM_STATE modemState = m_modemState;
+    bool p25Enable = m_p25Enable;
+    m_modemState = STATE_P25;
+    m_p25Enable = true;
+
+    HostStream& stream = hostSim.getModemTX();
+    stream.reset();
+
+    uint8_t buffer[P25_PDU_FRAME_LENGTH_BYTES];
+    uint32_t seed = 0x5E81A1U;
+    randomBytes(buffer, P25_PDU_FRAME_LENGTH_BYTES, seed);
+
+    // alternate LDUs (short frames) and PDUs (long frames)
+    const uint16_t LENGTHS[2U] = { P25_LDU_FRAME_LENGTH_BYTES, P25_PDU_FRAME_LENGTH_BYTES };
+
+    // both writers must put the same bytes on the wire
+    bool ret = true;
+    for (uint8_t i = 0U; i < 2U; i++) {
+        legacyWriteP25Data(0x01U, buffer, LENGTHS[i]);
+        uint32_t legacyLength = stream.getData();
+
+        serial.writeP25Data(0x01U, buffer, LENGTHS[i]);
+        if (stream.getData() != legacyLength * 2U) {
+            ::fprintf(stderr, "serial: %u byte frame written as %u bytes, expected %u\n", LENGTHS[i],
+                stream.getData() - legacyLength, legacyLength);
+            ret = false;
+        }
+        else {
+            for (uint32_t j = 0U; j < legacyLength; j++) {
+                if (stream.peek(j) != stream.peek(legacyLength + j)) {
+                    ::fprintf(stderr, "serial: %u byte frame differs at byte %u\n", LENGTHS[i], j);
+                    ret = false;
+                    break;
+                }
+            }
+        }
+
+        stream.reset();
+    }
+
+    uint32_t count = m_iterations / 1024U;
+    if (count == 0U)
+        count = 1U;
+
+    uint64_t start = now();
+    for (uint32_t i = 0U; i < count; i++) {
+        legacyWriteP25Data(0x00U, buffer, LENGTHS[i & 0x01U]);
+        stream.skip(stream.getData());
+    }
+    report("serial", "legacy copy + writeInt()", now() - start, count, "frame");
+
+    start = now();
+    for (uint32_t i = 0U; i < count; i++) {
+        serial.writeP25Data(0x00U, buffer, LENGTHS[i & 0x01U]);
+        stream.skip(stream.getData());
+    }
+    report("serial", "writeP25Data() spans", now() - start, count, "frame");
+
+    m_modemState = modemState;
+    m_p25Enable = p25Enable;
+
+    return ret;
+}
+
+/* Runs the host serial port at full load with the host not reading. */
+
+bool HostBench::uart()
+{
+    using namespace p25;
+
+    DVM_STATE modemState = m_modemState;
+    bool p25Enable = m_p25Enable;
+    m_modemState = STATE_P25;
+    m_p25Enable = true;
+
+    HostStream& tx = hostSim.getModemTX();
+    HostStream& rx = hostSim.getModemRX();
+
+    uint8_t buffer[P25_PDU_FRAME_LENGTH_BYTES];
+    ::memset(buffer, 0x5AU, P25_PDU_FRAME_LENGTH_BYTES);
+
+    // alternate LDUs (short frames) and PDUs (long frames), measuring how long each is on the wire
+    const uint16_t LENGTHS[2U] = { P25_LDU_FRAME_LENGTH_BYTES, P25_PDU_FRAME_LENGTH_BYTES };
+    uint32_t frameBytes[2U];
+    for (uint8_t i = 0U; i < 2U; i++) {
+        tx.reset();
+        serial.writeP25Data(0x00U, buffer, LENGTHS[i]);
+        frameBytes[i] = tx.getData();
+    }
+    tx.reset();
+
+    // the host stops reading until the stream is well past full, then reads a frame for every two written
+    // (a UART slower than the modem); every byte offered must either be read in a whole frame or be counted
+    uint32_t count = (HOST_STREAM_SIZE / frameBytes[0U]) * 4U;
+    uint32_t droppedStart = serial.getTXDropped();
+    uint32_t offered = 0U, read = 0U, truncated = 0U;
+
+    uint8_t frame[SERIAL_FB_LEN];
+    for (uint32_t i = 0U; i < count; i++) {
+        serial.writeP25Data(0x00U, buffer, LENGTHS[i & 0x01U]);
+        offered += frameBytes[i & 0x01U];
+
+        if (i >= count / 2U && (i & 0x01U) == 0x01U)
+            readWhole(frame, frameBytes, read, truncated);
+    }
+
+    // then the host catches up
+    while (readWhole(frame, frameBytes, read, truncated))
+        ;
+
+    bool ret = true;
+    uint32_t dropped = serial.getTXDropped() - droppedStart;
+    ::fprintf(stdout, "%-12s %u bytes offered, %u read in whole frames, %u counted as dropped, %u lost\n", "uart",
+        offered, read, dropped, tx.getLost());
+
+    if (tx.getLost() != 0U || truncated != 0U || tx.getData() != 0U) {
+        ::fprintf(stderr, "uart: %u bytes lost in the stream, %u truncated frames, %u bytes left over\n", tx.getLost(),
+            truncated, tx.getData());
+        ret = false;
+    }
+    if (read + dropped != offered) {
+        ::fprintf(stderr, "uart: %u bytes read and %u dropped of %u offered\n", read, dropped, offered);
+        ret = false;
+    }
+    if (dropped == 0U) {
+        ::fprintf(stderr, "uart: the stream never filled, the writer wasn't at full load\n");
+        ret = false;
+    }
+
+    // a burst of status requests, straddling the end of the stream buffer, must all be answered by one
+    // process() call
+    const uint32_t REQUESTS = 256U;
+    const uint8_t request[3U] = { DVM_SHORT_FRAME_START, 3U, CMD_GET_STATUS };
+
+    uint8_t junk[4096U];
+    ::memset(junk, 0x00U, sizeof(junk));
+
+    rx.reset();
+    for (uint32_t n = 0U; n < HOST_STREAM_SIZE - 100U; n += sizeof(junk)) {
+        uint32_t length = HOST_STREAM_SIZE - 100U - n;
+        if (length > sizeof(junk))
+            length = sizeof(junk);
+        rx.write(junk, length);
+        rx.skip(length);
+    }
+
+    uint32_t requests = m_iterations / 1024U;
+    if (requests < REQUESTS)
+        requests = REQUESTS;
+
+    uint32_t answered = 0U;
+    uint64_t elapsed = 0U;
+    for (uint32_t n = 0U; n < requests; n += REQUESTS) {
+        tx.reset();
+        for (uint32_t i = 0U; i < REQUESTS; i++)
+            rx.write(request, 3U);
+
+        uint64_t start = now();
+        serial.process();
+        elapsed += now() - start;
+
+        uint16_t length = SERIAL_FB_LEN;
+        while (hostSim.hostReadFrame(frame, length)) {
+            if (frame[2U] == CMD_GET_STATUS)
+                answered++;
+            length = SERIAL_FB_LEN;
+        }
+
+        if (rx.getData() != 0U)
+            break;
+    }
+
+    uint32_t sent = ((requests + REQUESTS - 1U) / REQUESTS) * REQUESTS;
+    report("uart", "process() status requests", elapsed, sent, "request");
+    if (answered != sent || rx.getData() != 0U) {
+        ::fprintf(stderr, "uart: %u of %u status requests answered, %u bytes left unread\n", answered, sent, rx.getData());
+        ret = false;
+    }
+
+    rx.reset();
+    tx.reset();
+
+    m_modemState = modemState;
+    m_p25Enable = p25Enable;
+
+    return ret;
+}
+
+/* Benchmarks the host side of the serial protocol, reading DMR bursts a packet at a time. */
+
+bool HostBench::batch()
+{
+    using namespace dmr;
+
+    DVM_STATE modemState = m_modemState;
+    bool dmrEnable = m_dmrEnable;
+    m_modemState = STATE_DMR;
+    m_dmrEnable = true;
+
+    // the host reads each packet with its own read() on a pipe, standing in for the serial port
+    int fds[2U];
+    if (::pipe(fds) != 0) {
+        ::fprintf(stderr, "batch: failed to create the pipe\n");
+        return false;
+    }
+
+    const uint32_t FRAMES = 1024U;
+    uint8_t burst[DMR_FRAME_LENGTH_BYTES + 1U];
+    for (uint8_t i = 0U; i < DMR_FRAME_LENGTH_BYTES + 1U; i++)
+        burst[i] = uint8_t(i * 0x9DU + 0x35U);
+
+    uint8_t* wire[2U] = { new uint8_t[HOST_STREAM_SIZE], new uint8_t[HOST_STREAM_SIZE] };
+    uint16_t* packets[2U] = { new uint16_t[FRAMES], new uint16_t[FRAMES] };
+    uint32_t wireLength[2U], count[2U];
+
+    // the clock doesn't run here, so batches are only written as they fill, and when batching is turned off
+    for (uint8_t pass = 0U; pass < 2U; pass++) {
+        hostSim.getModemTX().reset();
+        hostSim.hostSetBatch((pass == 0U) ? 0U : 255U);
+        serial.process();
+
+        for (uint32_t i = 0U; i < FRAMES; i++)
+            serial.writeDMRData((i & 0x01U) == 0x01U, burst, DMR_FRAME_LENGTH_BYTES + 1U);
+
+        hostSim.hostSetBatch(0U);
+        serial.process();
+
+        wireLength[pass] = readPackets(wire[pass], packets[pass], count[pass]);
+    }
+
+    // the batches must carry exactly the frames written alone, in order
+    bool ret = true;
+    uint32_t frames = 0U, offset = 0U;
+    for (uint32_t i = 0U, pos = 0U; i < count[1U]; pos += packets[1U][i], i++) {
+        const uint8_t* packet = wire[1U] + pos;
+        uint16_t start = (packet[3U] == CMD_BATCH) ? SERIAL_BATCH_HEADER_LEN : 0U;
+        uint16_t length = packets[1U][i] - start;
+        if (offset + length > wireLength[0U] || ::memcmp(packet + start, wire[0U] + offset, length) != 0) {
+            ::fprintf(stderr, "batch: packet %u doesn't carry the frames written alone\n", i);
+            ret = false;
+            break;
+        }
+
+        uint32_t sink = 0U;
+        frames += (start > 0U) ? dispatch(packet, packets[1U][i], sink) : 1U;
+        offset += length;
+    }
+    if (ret && (frames != FRAMES || count[0U] != FRAMES || offset != wireLength[0U])) {
+        ::fprintf(stderr, "batch: %u frames alone in %u packets, %u frames batched\n", FRAMES, count[0U], frames);
+        ret = false;
+    }
+
+    ::fprintf(stdout, "%-12s %u DMR bursts in %u packets alone, %u batched (%u bytes, %u batched)\n", "batch",
+        FRAMES, count[0U], count[1U], wireLength[0U], wireLength[1U]);
+
+    uint32_t rounds = m_iterations / (FRAMES * 64U);
+    if (rounds == 0U)
+        rounds = 1U;
+
+    const char* VARIANTS[2U] = { "packet a frame", "batched" };
+    uint8_t buffer[SERIAL_FB_LEN];
+    uint32_t sink = 0U;
+    for (uint8_t pass = 0U; pass < 2U && ret; pass++) {
+        uint32_t dispatched = 0U;
+        uint64_t start = now();
+        for (uint32_t r = 0U; r < rounds; r++) {
+            const uint8_t* packet = wire[pass];
+            for (uint32_t i = 0U; i < count[pass]; packet += packets[pass][i], i++) {
+                if (::write(fds[1U], packet, packets[pass][i]) != packets[pass][i] ||
+                    ::read(fds[0U], buffer, packets[pass][i]) != packets[pass][i]) {
+                    ::fprintf(stderr, "batch: pipe write or read failed\n");
+                    ret = false;
+                    break;
+                }
+
+                dispatched += dispatch(buffer, packets[pass][i], sink);
+            }
+        }
+        uint64_t elapsed = now() - start;
+
+        report("batch", VARIANTS[pass], elapsed, dispatched, "frame");
+        ::fprintf(stdout, "%-12s %-28s %10.0f packets/s %9.0f frames/s\n", "batch", VARIANTS[pass],
+            double(count[pass]) * rounds * 1e9 / double(elapsed), double(dispatched) * 1e9 / double(elapsed));
+    }
+
+    ::close(fds[0U]);
+    ::close(fds[1U]);
+    for (uint8_t i = 0U; i < 2U; i++) {
+        delete[] wire[i];
+        delete[] packets[i];
+    }
+
+    m_modemState = modemState;
+    m_dmrEnable = dmrEnable;
+
+    return ret;
+}
+
+/* Fills the P25 transmit FIFO from the host until it is full, checking the TX credits carried by each acknowlegement. */
+
+bool HostBench::credits()
+{
+    using namespace p25;
+
+    DVM_STATE modemState = m_modemState;
+    bool p25Enable = m_p25Enable;
+    m_modemState = STATE_P25;
+    m_p25Enable = true;
+
+    hostSim.getModemTX().reset();
+    p25TX.clear();
+
+    const uint16_t FIFO_BYTES = P25_LDU_FRAME_LENGTH_BYTES + 2U;
+    uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES + 4U];
+    frame[0U] = DVM_SHORT_FRAME_START;
+    frame[1U] = P25_LDU_FRAME_LENGTH_BYTES + 4U;
+    frame[2U] = CMD_P25_DATA;
+    frame[3U] = 0x00U;
+    for (uint16_t i = 0U; i < P25_LDU_FRAME_LENGTH_BYTES; i++)
+        frame[i + 4U] = uint8_t(i * 0x9DU + 0x35U);
+
+    // the credits are taken from the acknowlegement of each status request (a successful data write
+    // isn't acknowleged), or from the refusal of the frame that didn't fit
+    const uint8_t request[3U] = { DVM_SHORT_FRAME_START, 3U, CMD_GET_STATUS };
+
+    hostSim.hostSetCredits(true, 0U);
+    serial.process();
+
+    bool ret = true;
+    uint32_t written = 0U, mismatched = 0U;
+    uint16_t free = 0U, queued = 0U, refusedFree = 0U;
+    bool refused = false;
+
+    uint8_t reply[SERIAL_FB_LEN];
+    for (uint32_t n = 0U; n < 64U && !refused; n++) {
+        uint16_t length = SERIAL_FB_LEN;
+        while (hostSim.hostReadFrame(reply, length)) {
+            const uint8_t* credits = NULL;
+            if (reply[2U] == CMD_ACK && length == 4U + SERIAL_CREDITS_LEN)
+                credits = reply + 4U;
+            if (reply[2U] == CMD_NAK && length == 5U + SERIAL_CREDITS_LEN) {
+                credits = reply + 5U;
+                refused = reply[4U] == RSN_RINGBUFF_FULL;
+            }
+
+            if (credits != NULL) {
+                free = (credits[8U] << 8) | credits[9U];
+                queued = (credits[10U] << 8) | credits[11U];
+                if (free != p25TX.getFreeBytes() || queued != p25TX.getQueuedMs())
+                    mismatched++;
+                if (refused)
+                    refusedFree = free;
+            }
+
+            length = SERIAL_FB_LEN;
+        }
+
+        if (refused)
+            break;
+
+        hostSim.hostWrite(frame, P25_LDU_FRAME_LENGTH_BYTES + 4U);
+        hostSim.hostWrite(request, 3U);
+        serial.process();
+        written++;
+    }
+
+    // the frame that didn't fit is the only one missing from the FIFO
+    uint32_t queuedFrames = (P25_TX_BUFFER_LEN - p25TX.getFreeBytes()) / FIFO_BYTES;
+
+    ::fprintf(stdout, "%-12s %u P25 LDUs written, %u queued (%u ms), %u bytes free when refused\n", "credits",
+        written, queuedFrames, queued, refusedFree);
+
+    if (!refused) {
+        ::fprintf(stderr, "credits: the FIFO never filled\n");
+        ret = false;
+    }
+    if (mismatched != 0U) {
+        ::fprintf(stderr, "credits: %u acknowlegements carried credits that don't match the FIFO\n", mismatched);
+        ret = false;
+    }
+    if (refused && (queuedFrames + 1U != written || refusedFree >= FIFO_BYTES)) {
+        ::fprintf(stderr, "credits: %u of %u frames left queued after a refusal with %u bytes free\n", queuedFrames,
+            written, refusedFree);
+        ret = false;
+    }
+
+    hostSim.hostSetCredits(false, 0U);
+    serial.process();
+    hostSim.getModemTX().reset();
+    p25TX.clear();
+
+    m_modemState = modemState;
+    m_p25Enable = p25Enable;
+
+    return ret;
+}
+
+#if defined(ENABLE_PROFILER)
+/* Benchmarks the profiler's record of a duration. */
+
+bool HostBench::profile()
+{
+    // durations either side of the bin edges, up to the longest a 32 bit clock can measure; the last four
+    // all land in the last bin
+    static const uint32_t DURATIONS[] = { 0U, 1U, 2U, 3U, 4U, 100U, 1000U, 32767U, 32768U, 65536U, 0xFFFFFFFFU };
+    static const uint8_t BINS[] = { 0U, 1U, 2U, 2U, 3U, 7U, 10U, 15U, 15U, 15U, 15U };
+    const uint8_t DURATION_COUNT = 11U;
+
+    Profiler stats;
+    for (uint8_t i = 0U; i < DURATION_COUNT; i++)
+        stats.record(PROBE_IO_PROCESS, DURATIONS[i]);
+
+    // the mean is taken over a 64 bit total: 4295099476 / 11
+    bool ret = true;
+    if (stats.getCount(PROBE_IO_PROCESS) != DURATION_COUNT || stats.getMin(PROBE_IO_PROCESS) != 0U ||
+        stats.getMax(PROBE_IO_PROCESS) != 0xFFFFFFFFU || stats.getMean(PROBE_IO_PROCESS) != 390463588U) {
+        ::fprintf(stderr, "profiler: %u durations, min %u, max %u, mean %u; expected 11, 0, 4294967295, 390463588\n",
+            stats.getCount(PROBE_IO_PROCESS), stats.getMin(PROBE_IO_PROCESS), stats.getMax(PROBE_IO_PROCESS),
+            stats.getMean(PROBE_IO_PROCESS));
+        ret = false;
+    }
+
+    for (uint8_t bin = 0U; bin < PROFILER_HISTOGRAM_BINS; bin++) {
+        uint16_t expected = 0U;
+        for (uint8_t i = 0U; i < DURATION_COUNT; i++)
+            expected += (BINS[i] == bin) ? 1U : 0U;
+
+        if (stats.getBin(PROBE_IO_PROCESS, bin) != expected) {
+            ::fprintf(stderr, "profiler: bin %u has %u durations, expected %u\n", bin, stats.getBin(PROBE_IO_PROCESS, bin), expected);
+            ret = false;
+        }
+    }
+
+    // a bin saturates rather than wrapping, and a probe is kept (and reset) apart from the others
+    uint64_t start = now();
+    for (uint32_t i = 0U; i < 70000U; i++)
+        stats.record(PROBE_SERIAL_PROCESS, 5U);
+    report("profiler", "record()", now() - start, 70000U, "duration");
+
+    if (stats.getCount(PROBE_SERIAL_PROCESS) != 70000U || stats.getMean(PROBE_SERIAL_PROCESS) != 5U ||
+        stats.getBin(PROBE_SERIAL_PROCESS, 3U) != 0xFFFFU) {
+        ::fprintf(stderr, "profiler: 70000 durations of 5 kept as %u, mean %u, bin 3 %u\n", stats.getCount(PROBE_SERIAL_PROCESS),
+            stats.getMean(PROBE_SERIAL_PROCESS), stats.getBin(PROBE_SERIAL_PROCESS, 3U));
+        ret = false;
+    }
+
+    stats.reset(PROBE_SERIAL_PROCESS);
+    if (stats.getCount(PROBE_SERIAL_PROCESS) != 0U || stats.getMin(PROBE_SERIAL_PROCESS) != 0U ||
+        stats.getBin(PROBE_SERIAL_PROCESS, 3U) != 0U || stats.getCount(PROBE_IO_PROCESS) != DURATION_COUNT) {
+        ::fprintf(stderr, "profiler: resetting one probe didn't clear it alone\n");
+        ret = false;
+    }
+
+    return ret;
+}
+#endif // ENABLE_PROFILER
+
+/* Helper to display a benchmark result. */
+
+void HostBench::report(const char* bench, const char* variant, uint64_t ns, uint32_t count, const char* unit) const
+{
+    ::fprintf(stdout, "%-12s %-28s %10u %ss %9.3f ms %8.3f ns/%s\n", bench, variant, count, unit,
+        double(ns) / 1e6, (count > 0U) ? double(ns) / double(count) : 0.0, unit);
+}
+
+#endif // HOST_SIM
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file HostBench.h
+ * @ingroup host_sim
+ * @file HostBench.cpp
+ * @ingroup host_sim
+ */
+#if !defined(__HOST_BENCH_H__)
+#define __HOST_BENCH_H__
+
+#if defined(HOST_SIM)
+
+#include "Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements microbenchmarks of the modem core building blocks, comparing the current
+ *  implementations against the implementations they replaced.
+ * @ingroup host_sim
+ */
+class DSP_FW_API HostBench {
+public:
+    /**
+     * @brief Initializes a new instance of the HostBench class.
+     * @param iterations Number of iterations (bits, words or codewords) to run each benchmark for.
+     */
+    HostBench(uint32_t iterations);
+
+    /**
+     * @brief Runs the named benchmark.
+     * @param name Name of the benchmark to run; "all" runs every benchmark.
+     * @returns bool True, if the benchmark ran and the implementations agree, otherwise false.
+     */
+    bool run(const char* name);
+
+    /**
+     * @brief Displays the names of the available benchmarks.
+     */
+    static void list();
+
+private:
+    uint32_t m_iterations;
+
+    /**
+     * @brief Benchmarks the RX/TX bit ring buffer.
+     * @returns bool True, if the implementations agree, otherwise false.
+     */
+    bool bitBuffer();
+    /**
+     * @brief Stress tests the bit ring buffer with the producer and consumer on two threads, checking
+     *  no bits are lost, duplicated or reordered.
+     * @returns bool True, if every bit passed the ring buffer intact, otherwise false.
+     */
+    bool spsc();
+    /**
+     * @brief Benchmarks the bit counts used by the sync correlators, checking them against the byte
+     *  table counts.
+     * @returns bool True, if the implementations agree, otherwise false.
+     */
+    bool popcount();
+    /**
+     * @brief Benchmarks the DMR sync correlator while hunting, checking it matches the stream as the
+     *  correlator it replaced did.
+     * @returns bool True, if the implementations agree, otherwise false.
+     */
+    bool dmrSync();
+    /**
+     * @brief Benchmarks the DMR burst extraction from the receivers' circular bit buffers, checking it
+     *  against a bit at a time copy for every start position and length.
+     * @returns bool True, if the implementations agree, otherwise false.
+     */
+    bool extract();
+    /**
+     * @brief Benchmarks the DMR slot type (19,8) syndrome, checking it and the slot type decode against the
+     *  polynomial long division for every pattern.
+     * @returns bool True, if the implementations agree, otherwise false.
+     */
+    bool golay();
+    /**
+     * @brief Benchmarks the P25 NID BCH (63,16) decoder, checking NIDs with up to 11 bit errors are
+     *  corrected and the error counts reported.
+     * @returns bool True, if every correctable NID was corrected, otherwise false.
+     */
+    bool nid();
+    /**
+     * @brief Benchmarks the DMR BPTC (196,96) decoder and payload CRC check, checking bursts with up to 2 bit
+     *  errors are corrected and reporting how many with more (and how much noise) pass the CRC.
+     * @returns bool True, if every correctable burst was corrected, otherwise false.
+     */
+    bool bptc();
+    /**
+     * @brief Benchmarks the DMR voice burst AMBE FEC check, checking bursts with up to 3 bit errors in the
+     *  protected bits are counted exactly and reporting how often the count is exact with more.
+     * @returns bool True, if every burst with up to 3 bit errors was counted exactly, otherwise false.
+     */
+    bool ambe();
+    /**
+     * @brief Benchmarks the P25 LDU IMBE FEC check, checking LDUs with up to 3 bit errors in the Golay
+     *  protected bits are counted exactly and reporting how often the count is exact with more.
+     * @returns bool True, if every LDU with up to 3 bit errors was counted exactly, otherwise false.
+     */
+    bool imbe();
+    /**
+     * @brief Benchmarks the P25 frame write to the host, checking the scatter/gather writer puts the same
+     *  bytes on the wire as the copying writer it replaced.
+     * @returns bool True, if the implementations agree, otherwise false.
+     */
+    bool serialWrite();
+    /**
+     * @brief Runs the host serial port at full load with the host not reading, checking every frame written
+     *  reaches the host whole or is counted as dropped, and that a burst of received commands is handled
+     *  by a single process() call.
+     * @returns bool True, if no bytes were silently lost and every command was answered, otherwise false.
+     */
+    bool uart();
+    /**
+     * @brief Benchmarks the host side of the serial protocol, reading DMR bursts through a pipe a packet at
+     *  a time as written alone and batched, checking the batches carry the same frames.
+     * @returns bool True, if the batched frames match the frames written alone, otherwise false.
+     */
+    bool batch();
+    /**
+     * @brief Fills the P25 transmit FIFO from the host until it is full, checking the TX credits carried by
+     *  each acknowlegement match the FIFO, and that a frame refused for lack of space leaves the FIFO intact.
+     * @returns bool True, if the credits match the FIFO and no queued frame was lost, otherwise false.
+     */
+    bool credits();
+#if defined(ENABLE_PROFILER)
+    /**
+     * @brief Benchmarks the profiler's record of a duration, checking the count, min, max, mean and histogram
+     *  bins kept for a set of known durations.
+     * @returns bool True, if the statistics kept match the durations recorded, otherwise false.
+     */
+    bool profile();
+#endif // ENABLE_PROFILER
+
+    /**
+     * @brief Helper to display a benchmark result.
+     * @param bench Name of the benchmark.
+     * @param variant Name of the benchmarked implementation.
+     * @param ns Elapsed time in nanoseconds.
+     * @param count Number of units processed.
+     * @param unit Name of the unit processed.
+     */
+    void report(const char* bench, const char* variant, uint64_t ns, uint32_t count, const char* unit) const;
+};
+
+#endif // HOST_SIM
+#endif // __HOST_BENCH_H__
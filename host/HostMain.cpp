@@ -0,0 +1,1276 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file HostMain.cpp
+ * @ingroup host_sim
+ */
+#include "Globals.h"
+#include "host/HostSim.h"
+#include "host/HostReplay.h"
+#include "host/HostBench.h"
+
+#if defined(HOST_SIM)
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define DEFAULT_BITS        960000U
+#define DEFAULT_CALLS       4U
+#define DEFAULT_ITERATIONS  16777216U
+
+#define MAX_ALLOW_NACS      64U
+#define REJECT_COUNTS       6U
+
+#define DMR_BIT_RATE        9600U
+#define P25_BIT_RATE        9600U
+#define NXDN_BIT_RATE       4800U
+
+#define LAUNCH_FRAMES       5U
+#define LAUNCH_CAPTURE_BITS 65536U
+
+// ---------------------------------------------------------------------------
+//  Global Functions and Variables
+// ---------------------------------------------------------------------------
+
+extern void setup();
+extern void loop();
+
+/**
+ * @brief Frame counters gathered from the modem to host stream.
+ */
+struct HostCounters {
+    uint32_t packets;
+    uint32_t frames;
+    uint32_t data;
+    uint32_t lost;
+    uint32_t ack;
+    uint32_t nak;
+    uint32_t full;
+    uint32_t credits;
+    uint32_t late;
+};
+
+/**
+ * @brief The host's view of a modem TX FIFO, from the TX credits.
+ */
+struct HostCredit {
+    uint16_t free;
+    uint16_t queued;
+    uint16_t peak;
+};
+
+static bool g_debug = false;
+static bool g_profile = false;
+static bool g_trace = false;
+static bool g_transmit = false;
+static bool g_launch = false;
+
+static uint8_t g_batch = 0U;
+static uint8_t g_credits = 0U;
+static HostCredit g_txCredit[SERIAL_CREDITS_LEN / 4U];
+
+static uint32_t g_lateLaunch = 0U;
+static uint32_t g_lateStart = 0U;
+
+static uint16_t g_colorCodes = 0U;
+static uint8_t g_allowNACs[MAX_ALLOW_NACS * 2U];
+static uint8_t g_allowNACCount = 0U;
+
+#if defined(SEND_RX_TIMESTAMP)
+/** @brief Number of frame bits (from the fourth byte on) checked against the capture at the frame's timestamp. */
+const uint16_t TIMESTAMP_CHECK_BITS = 64U;
+
+static const HostCapture* g_rxCapture = NULL;
+static uint32_t g_rxBase = 0U;
+static uint32_t g_rxChecked = 0U;
+static uint32_t g_rxMisplaced = 0U;
+#endif // defined(SEND_RX_TIMESTAMP)
+
+#if defined(ENABLE_PROFILER)
+/** @brief Names of the hot path profiler probes. */
+static const char* PROBE_NAMES[PROBE_COUNT] = {
+    "IO::interrupt1()", "IO::interrupt2()", "IO::process()", "SerialPort::process()",
+    "DMRRX::databit()", "DMRSlotRX::databit()", "DMRSlotRX::correlateSync()", "DMRIdleRX::databit()",
+    "DMRDMORX::databit()", "DMRDMORX::correlateSync()", "P25RX::databit()", "P25RX::correlateSync()",
+    "P25RX::decodeNid()", "NXDNRX::databit()", "NXDNRX::correlateSync()",
+    "DMRTX::process()", "DMRDMOTX::process()", "P25TX::process()", "NXDNTX::process()"
+};
+#endif
+
+/** @brief Real-time multiples stepped through when sweeping the replay rate. */
+static const double SWEEP_MULTIPLES[] = { 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0, 1000.0,
+    2000.0, 5000.0, 10000.0, 20000.0, 50000.0, 100000.0 };
+static const uint32_t SWEEP_MULTIPLES_LENGTH = sizeof(SWEEP_MULTIPLES) / sizeof(double);
+
+#define REPLAY_RATE_MAX     0.0
+#define REPLAY_RATE_SWEEP   -1.0
+
+/* Helper to get a monotonic timestamp in nanoseconds. */
+
+static uint64_t now()
+{
+    struct timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+}
+
+/* Helper to get the textual name of a modem state. */
+
+static const char* stateName(DVM_STATE state)
+{
+    switch (state) {
+    case STATE_DMR:
+        return "DMR";
+    case STATE_P25:
+        return "P25";
+    case STATE_NXDN:
+        return "NXDN";
+    default:
+        return "Idle";
+    }
+}
+
+/* Helper to get the over-the-air bit rate of a modem state. */
+
+static uint32_t bitRate(DVM_STATE state)
+{
+    switch (state) {
+    case STATE_P25:
+        return P25_BIT_RATE;
+    case STATE_NXDN:
+        return NXDN_BIT_RATE;
+    default:
+        return DMR_BIT_RATE;
+    }
+}
+
+/* Helper to get the reject counts from the modem (CMD_GET_REJECTS); DMR colour code, P25 NID by reason, DMR payload
+   CRC drops, then P25 NID bits corrected. Any frames waiting to be read are dropped. */
+
+static void getRejects(uint32_t* rejects)
+{
+    ::memset(rejects, 0x00U, REJECT_COUNTS * sizeof(uint32_t));
+
+    const uint8_t request[3U] = { DVM_SHORT_FRAME_START, 3U, CMD_GET_REJECTS };
+    hostSim.hostWrite(request, 3U);
+    serial.process();
+
+    uint8_t buffer[HOST_FRAME_LEN];
+    uint16_t length = HOST_FRAME_LEN;
+    while (hostSim.hostReadFrame(buffer, length)) {
+        if (buffer[0U] == DVM_SHORT_FRAME_START && buffer[2U] == CMD_GET_REJECTS && length >= 3U + REJECT_COUNTS * 4U) {
+            const uint8_t* data = buffer + 3U;
+            for (uint8_t i = 0U; i < REJECT_COUNTS; i++, data += 4U)
+                rejects[i] = (data[0U] << 24) | (data[1U] << 16) | (data[2U] << 8) | data[3U];
+            return;
+        }
+
+        length = HOST_FRAME_LEN;
+    }
+
+    ::fprintf(stderr, "failed to read the reject counts\n");
+}
+
+/* Displays the number of frames the receivers rejected early since the given counts were taken. */
+
+static void printRejects(DVM_STATE state, const uint32_t* start)
+{
+    uint32_t rejects[REJECT_COUNTS];
+    getRejects(rejects);
+
+    if (state == STATE_DMR) {
+        ::fprintf(stdout, "      DMR %u CSBKs/data headers dropped by the payload CRC check\n", rejects[4U] - start[4U]);
+        ::fprintf(stdout, "      DMR %u data bursts rejected by the colour code check\n", rejects[0U] - start[0U]);
+    }
+    if (state == STATE_P25) {
+        ::fprintf(stdout, "      P25 %u NID bits corrected by the BCH (63,16) decoder\n", rejects[5U] - start[5U]);
+        ::fprintf(stdout, "      P25 frames rejected at the NID: %u uncorrectable, %u NAC not allowed, %u illegal DUID\n",
+            rejects[1U] - start[1U], rejects[2U] - start[2U], rejects[3U] - start[3U]);
+    }
+}
+
+/* Takes the free bytes and queued airtime of each TX FIFO from the TX credits. */
+
+static void takeCredits(const uint8_t* credits)
+{
+    for (uint8_t i = 0U; i < (SERIAL_CREDITS_LEN / 4U); i++) {
+        g_txCredit[i].free = (credits[i * 4U + 0U] << 8) | credits[i * 4U + 1U];
+        g_txCredit[i].queued = (credits[i * 4U + 2U] << 8) | credits[i * 4U + 3U];
+        if (g_txCredit[i].queued > g_txCredit[i].peak)
+            g_txCredit[i].peak = g_txCredit[i].queued;
+    }
+}
+
+#if defined(SEND_RX_TIMESTAMP)
+/* Checks a received frame is found in the capture being replayed at the bit its timestamp gives. */
+
+static void checkTimestamp(const uint8_t* frame, const uint8_t* timestamp)
+{
+    if (g_rxCapture == NULL)
+        return;
+
+    // the bit clock counts a bit period per bit replayed, from the clock the replay started at
+    uint32_t clock = (timestamp[0U] << 24) | (timestamp[1U] << 16) | (timestamp[2U] << 8) | timestamp[3U];
+    uint32_t n = clock - g_rxBase - 1U;
+
+    // the sync the frame starts with is rebuilt by the receiver, so the check starts a few bytes in
+    g_rxChecked++;
+    if (n >= g_rxCapture->getLength() || g_rxCapture->getLength() - n < 24U + TIMESTAMP_CHECK_BITS) {
+        g_rxMisplaced++;
+        return;
+    }
+
+    for (uint16_t i = 24U; i < 24U + TIMESTAMP_CHECK_BITS; i++) {
+        if (g_rxCapture->getBit(n + i) != _READ_BIT(frame, i)) {
+            g_rxMisplaced++;
+            return;
+        }
+    }
+}
+
+#endif // defined(SEND_RX_TIMESTAMP)
+/* Tallies a frame written by the modem. */
+
+static void tallyFrame(HostCounters& counters, const uint8_t* buffer, uint16_t length, HostFrameLog* log)
+{
+    uint8_t offset = (buffer[0U] == DVM_LONG_FRAME_START) ? 3U : 2U;
+    uint8_t cmd = buffer[offset];
+
+    counters.frames++;
+    switch (cmd) {
+    case CMD_DMR_DATA1:
+    case CMD_DMR_DATA2:
+    case CMD_P25_DATA:
+    case CMD_NXDN_DATA:
+        counters.data++;
+#if defined(SEND_RX_TIMESTAMP)
+        // the frame (after its control or flags byte) ends with its timestamp, which is checked rather than logged
+        length -= 4U;
+        checkTimestamp(buffer + offset + 2U, buffer + length);
+#endif
+        if (log != NULL)
+            log->add(cmd, buffer + offset + 1U, length - (offset + 1U));
+        break;
+    case CMD_DMR_LOST1:
+    case CMD_DMR_LOST2:
+    case CMD_P25_LOST:
+    case CMD_NXDN_LOST:
+        counters.lost++;
+        if (log != NULL)
+            log->add(cmd, buffer + offset + 1U, length - (offset + 1U));
+        break;
+    case CMD_ACK:
+        counters.ack++;
+        if (length == 4U + SERIAL_CREDITS_LEN)
+            takeCredits(buffer + 4U);
+        break;
+    case CMD_NAK:
+        counters.nak++;
+        if (buffer[4U] == RSN_RINGBUFF_FULL)
+            counters.full++;
+        if (length == 5U + SERIAL_CREDITS_LEN)
+            takeCredits(buffer + 5U);
+        ::fprintf(stderr, "NAK, cmd = $%02X, reason = %u\n", buffer[3U], buffer[4U]);
+        break;
+    case CMD_TX_CREDITS:
+        counters.credits++;
+        if (length == 3U + SERIAL_CREDITS_LEN)
+            takeCredits(buffer + 3U);
+        break;
+    case CMD_TX_LATE:
+        counters.late++;
+        if (length == 12U) {
+            g_lateLaunch = (buffer[4U] << 24) | (buffer[5U] << 16) | (buffer[6U] << 8) | buffer[7U];
+            g_lateStart = (buffer[8U] << 24) | (buffer[9U] << 16) | (buffer[10U] << 8) | buffer[11U];
+        }
+        break;
+    case CMD_DEBUG1:
+    case CMD_DEBUG2:
+    case CMD_DEBUG3:
+    case CMD_DEBUG4:
+    case CMD_DEBUG5:
+        if (g_debug) {
+            // debug text is followed by up to four 16-bit values
+            uint8_t nValues = cmd - CMD_DEBUG1;
+            int textLength = int(length) - 3 - (nValues * 2);
+            if (textLength < 0)
+                break;
+
+            ::fprintf(stderr, "DEBUG: %.*s", textLength, buffer + 3U);
+            for (uint8_t i = 0U; i < nValues; i++) {
+                const uint8_t* value = buffer + 3U + textLength + (i * 2U);
+                ::fprintf(stderr, " %d", int16_t((value[0U] << 8) | value[1U]));
+            }
+            ::fprintf(stderr, "\n");
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* Reads and tallies all complete frames written by the modem, unpacking batches of frames. */
+
+static void drainFrames(HostCounters& counters, HostFrameLog* log = NULL)
+{
+    uint8_t buffer[HOST_FRAME_LEN];
+    uint16_t length = HOST_FRAME_LEN;
+
+    while (hostSim.hostReadFrame(buffer, length)) {
+        counters.packets++;
+
+        if (buffer[0U] == DVM_LONG_FRAME_START && buffer[3U] == CMD_BATCH) {
+            uint16_t offset = 4U;
+            while (offset + 3U <= length) {
+                const uint8_t* frame = buffer + offset;
+                uint16_t frameLength = frame[1U];
+                if (frame[0U] == DVM_LONG_FRAME_START)
+                    frameLength = (frame[1U] << 8) + frame[2U];
+                if (frameLength < 3U || offset + frameLength > length) {
+                    ::fprintf(stderr, "malformed batch, frame at %u of %u is %u bytes\n", offset, length, frameLength);
+                    break;
+                }
+
+                tallyFrame(counters, frame, frameLength, log);
+                offset += frameLength;
+            }
+        }
+        else {
+            tallyFrame(counters, buffer, length, log);
+        }
+
+        length = HOST_FRAME_LEN;
+    }
+}
+
+/* Requests the modem status, so any frames held back to be batched are written ahead of the reply. */
+
+static void flushFrames(HostCounters& counters, HostFrameLog* log = NULL)
+{
+    if (g_batch == 0U)
+        return;
+
+    const uint8_t request[3U] = { DVM_SHORT_FRAME_START, 3U, CMD_GET_STATUS };
+    hostSim.hostWrite(request, 3U);
+    loop();
+
+    drainFrames(counters, log);
+}
+
+/* Displays how many packets the frames written by the modem arrived in. */
+
+static void printPackets(const HostCounters& counters, uint32_t bits, DVM_STATE state)
+{
+    double secs = double(bits) / double(bitRate(state));
+    ::fprintf(stdout, "      serial %u frames in %u packets (%.1f packets/s of air time, batch deadline %u ms)\n",
+        counters.frames, counters.packets, (secs > 0.0) ? double(counters.packets) / secs : 0.0, g_batch);
+}
+
+/* Helper to get how many frames the TX credits allow to be written, and take them from the host's view of the FIFO. */
+
+static uint16_t spendCredits(HostCredit& credit, uint16_t fifoBytes, uint16_t frameMs, uint16_t frameLength)
+{
+    // as many frames as go in one write
+    uint16_t max = 1U;
+    if (g_batch > 0U)
+        max = (SERIAL_FB_LEN - SERIAL_BATCH_HEADER_LEN) / (frameLength + 3U);
+
+    // keep just enough airtime queued to last until the next credit event, with two frames to spare
+    uint16_t target = g_credits + (2U * frameMs);
+
+    uint16_t frames = 0U;
+    while (frames < max && credit.free >= fifoBytes && credit.queued < target) {
+        credit.free -= fifoBytes;
+        credit.queued += frameMs;
+        frames++;
+    }
+
+    return frames;
+}
+
+/* Writes a frame of traffic for the given modem state to the modem, if its transmit buffer has space. */
+
+static void feedTX(DVM_STATE state)
+{
+    uint8_t frame[p25::P25_LDU_FRAME_LENGTH_BYTES + 4U];
+    uint16_t length = 0U;
+    uint16_t space = 0U;
+    uint16_t credits = 0U;
+
+    switch (state) {
+    case STATE_DMR:
+#if defined(DUPLEX)
+        if (m_duplex)
+            space = dmrTX.getSpace2();
+        else
+            space = dmrDMOTX.getSpace();
+#else
+        space = dmrDMOTX.getSpace();
+#endif
+        frame[2U] = CMD_DMR_DATA2;
+        length = dmr::DMR_FRAME_LENGTH_BYTES + 1U;
+        if (g_credits > 0U)
+            credits = spendCredits(g_txCredit[1U], dmr::DMR_FRAME_LENGTH_BYTES, 60U, length);
+        break;
+    case STATE_P25:
+        space = p25TX.getSpace();
+        frame[2U] = CMD_P25_DATA;
+        length = p25::P25_LDU_FRAME_LENGTH_BYTES + 1U;
+        if (g_credits > 0U)
+            credits = spendCredits(g_txCredit[2U], p25::P25_LDU_FRAME_LENGTH_BYTES + 2U, 180U, length);
+        break;
+    case STATE_NXDN:
+        space = nxdnTX.getSpace();
+        frame[2U] = CMD_NXDN_DATA;
+        length = nxdn::NXDN_FRAME_LENGTH_BYTES + 1U;
+        if (g_credits > 0U)
+            credits = spendCredits(g_txCredit[3U], nxdn::NXDN_FRAME_LENGTH_BYTES, 80U, length);
+        break;
+    default:
+        return;
+    }
+
+    // with TX credits the host goes by what the modem last reported, rather than looking at the FIFO
+    // (a frame is always left free otherwise)
+    if (g_credits > 0U)
+        space = (credits > 0U) ? credits + 1U : 0U;
+
+    if (space < 2U)
+        return;
+
+    frame[0U] = DVM_SHORT_FRAME_START;
+    frame[1U] = length + 3U;
+    for (uint16_t i = 0U; i < length; i++)
+        frame[i + 3U] = uint8_t(i * 0x9DU + 0x35U);
+    frame[3U] = 0x00U;
+
+    if (g_batch == 0U) {
+        hostSim.hostWrite(frame, length + 3U);
+        return;
+    }
+
+    // queue as many frames as the transmit buffer has space for, in one batch
+    uint8_t batch[SERIAL_FB_LEN];
+    uint16_t batchLength = SERIAL_BATCH_HEADER_LEN;
+    for (uint16_t i = 1U; i < space && batchLength + length + 3U <= SERIAL_FB_LEN; i++) {
+        ::memcpy(batch + batchLength, frame, length + 3U);
+        batchLength += length + 3U;
+    }
+
+    batch[0U] = DVM_LONG_FRAME_START;
+    batch[1U] = (batchLength >> 8) & 0xFFU;
+    batch[2U] = (batchLength >> 0) & 0xFFU;
+    batch[3U] = CMD_BATCH;
+
+    hostSim.hostWrite(batch, batchLength);
+}
+
+/* Reads (and resets) the hot path profile from the modem and displays it. */
+
+static void printProfile()
+{
+#if defined(ENABLE_PROFILER)
+    for (uint8_t probe = 0U; probe < PROBE_COUNT; probe++) {
+        uint8_t request[5U];
+        request[0U] = DVM_SHORT_FRAME_START;
+        request[1U] = 5U;
+        request[2U] = CMD_GET_PROFILE;
+        request[3U] = probe;
+        request[4U] = 0x01U;                            // reset after reading
+
+        hostSim.hostWrite(request, 5U);
+        serial.process();
+
+        uint8_t buffer[SERIAL_FB_LEN];
+        uint16_t length = SERIAL_FB_LEN;
+        if (!hostSim.hostReadFrame(buffer, length) || buffer[2U] != CMD_GET_PROFILE || length < 54U) {
+            ::fprintf(stderr, "failed to read the profile for probe %u\n", probe);
+            return;
+        }
+
+        const uint8_t* data = buffer + 6U;
+        uint32_t values[4U];
+        for (uint8_t i = 0U; i < 4U; i++, data += 4U)
+            values[i] = (data[0U] << 24) | (data[1U] << 16) | (data[2U] << 8) | data[3U];
+
+        if (values[0U] == 0U)
+            continue;
+
+        const char* unit = (buffer[5U] == PROFILER_UNIT_NS) ? "ns" : "cyc";
+        ::fprintf(stdout, "      %-28s %10u calls, min %6u, mean %6u, max %8u %s; log2:", PROBE_NAMES[probe],
+            values[0U], values[1U], values[3U], values[2U], unit);
+        for (uint8_t i = 0U; i < PROFILER_HISTOGRAM_BINS; i++, data += 2U) {
+            uint16_t bin = (data[0U] << 8) | data[1U];
+            if (bin > 0U)
+                ::fprintf(stdout, " <%u:%u", 1U << i, bin);
+        }
+        ::fprintf(stdout, "\n");
+    }
+#else
+    ::fprintf(stderr, "profiler not enabled; build with make -f Makefile.HOST host-profile\n");
+#endif
+}
+
+/* Reads (and resets) the received frame latency trace from the modem and displays it. */
+
+static void printTrace()
+{
+#if defined(ENABLE_TRACER)
+    static const char* STAGE_NAMES[TRACE_STAGE_COUNT] = { "ring", "frame", "uart", "total" };
+
+    for (uint8_t stage = 0U; stage < TRACE_STAGE_COUNT; stage++) {
+        uint8_t request[5U];
+        request[0U] = DVM_SHORT_FRAME_START;
+        request[1U] = 5U;
+        request[2U] = CMD_GET_TRACE;
+        request[3U] = stage;
+        request[4U] = 0x01U;                            // reset after reading
+
+        hostSim.hostWrite(request, 5U);
+        serial.process();
+
+        uint8_t buffer[SERIAL_FB_LEN];
+        uint16_t length = SERIAL_FB_LEN;
+        if (!hostSim.hostReadFrame(buffer, length) || buffer[2U] != CMD_GET_TRACE || length < 60U) {
+            ::fprintf(stderr, "failed to read the trace for stage %u\n", stage);
+            return;
+        }
+
+        uint16_t rate = (buffer[6U] << 8) | buffer[7U];
+        const uint8_t* data = buffer + 8U;
+        uint32_t values[5U];
+        for (uint8_t i = 0U; i < 5U; i++, data += 4U)
+            values[i] = (data[0U] << 24) | (data[1U] << 16) | (data[2U] << 8) | data[3U];
+
+        if (stage == 0U)
+            ::fprintf(stdout, "      RX trace (1 in %u syncs, %u frames abandoned), bits at %u bits/s:\n", buffer[5U], values[0U], rate);
+
+        double ms = (rate > 0U) ? 1000.0 / double(rate) : 0.0;
+        ::fprintf(stdout, "      %-5s %6u frames, min %5u, mean %5u (%7.2f ms), max %5u (%7.2f ms); log2:", STAGE_NAMES[stage],
+            values[1U], values[2U], values[4U], double(values[4U]) * ms, values[3U], double(values[3U]) * ms);
+        for (uint8_t i = 0U; i < TRACER_HISTOGRAM_BINS; i++, data += 2U) {
+            uint16_t bin = (data[0U] << 8) | data[1U];
+            if (bin > 0U)
+                ::fprintf(stdout, " <%u:%u", 1U << i, bin);
+        }
+        ::fprintf(stdout, "\n");
+    }
+#else
+    ::fprintf(stderr, "tracer not enabled; build with make -f Makefile.HOST host-trace\n");
+#endif
+}
+
+/* Configures the modem for the given modem state. */
+
+static bool configure(DVM_STATE state, uint8_t colorCode, uint16_t nac)
+{
+    HostCounters counters;
+    ::memset(&counters, 0x00U, sizeof(HostCounters));
+
+    hostSim.hostSetConfig(state, colorCode, nac, g_debug);
+    if (g_batch > 0U)
+        hostSim.hostSetBatch(g_batch);
+    if (g_credits > 0U) {
+        ::memset(g_txCredit, 0x00U, sizeof(g_txCredit));
+        hostSim.hostSetCredits(true, g_credits);
+    }
+    if (g_colorCodes != 0U) {
+        uint8_t mask[2U];
+        mask[0U] = (g_colorCodes >> 8) & 0xFFU;
+        mask[1U] = (g_colorCodes >> 0) & 0xFFU;
+        hostSim.hostSetAllowList(0x00U, mask, 2U);
+    }
+    if (g_allowNACCount > 0U)
+        hostSim.hostSetAllowList(0x01U, g_allowNACs, g_allowNACCount * 2U);
+    if (g_trace) {
+        // trace every frame with a sync
+        uint8_t request[6U] = { DVM_SHORT_FRAME_START, 6U, CMD_GET_TRACE, 0xFFU, 0x00U, 0x01U };
+        hostSim.hostWrite(request, 6U);
+    }
+    for (uint32_t i = 0U; i < 16U; i++)
+        loop();
+    drainFrames(counters);
+
+    if (m_modemState != state || counters.ack == 0U) {
+        ::fprintf(stderr, "%s: failed to configure the modem\n", stateName(state));
+        return false;
+    }
+
+    return true;
+}
+
+/* Runs the superloop with the virtual symbol clock for the given modem state. */
+
+static bool run(DVM_STATE state, uint32_t bits, uint32_t loops, uint32_t stall, uint8_t colorCode, uint16_t nac)
+{
+    if (!configure(state, colorCode, nac))
+        return false;
+#if defined(ENABLE_PROFILER)
+    profiler.reset();
+#endif
+#if defined(ENABLE_TRACER)
+    tracer.reset();
+#endif
+    uint32_t dropped = io.getRXDropped();
+    uint32_t marksDropped = io.getRXMarksDropped();
+    uint32_t nxdnFiltered = nxdnRX.getFiltered();
+    uint32_t rejects[REJECT_COUNTS];
+    getRejects(rejects);
+    io.getRXPeak();
+
+    HostCounters counters;
+    ::memset(&counters, 0x00U, sizeof(HostCounters));
+
+    uint64_t txBits = hostSim.getTXBits();
+
+    uint32_t n = 0U;
+    uint64_t start = now();
+    for (; n < bits; n++) {
+        hostSim.clockBit();
+        if ((n % stall) == (stall - 1U)) {
+            for (uint32_t i = 0U; i < loops; i++)
+                loop();
+        }
+
+        if ((n & 0x3FU) == 0x3FU) {
+            drainFrames(counters);
+            if (g_transmit)
+                feedTX(state);
+        }
+
+        if (hostSim.isResetRequested() || hostSim.isRXDone())
+            break;
+    }
+    uint64_t elapsed = now() - start;
+    drainFrames(counters);
+    flushFrames(counters);
+
+    double secs = double(elapsed) / 1e9;
+    double rate = (secs > 0.0) ? double(n) / secs : 0.0;
+
+    ::fprintf(stdout, "%-5s %10u bits %9.3f s %12.0f bits/s (%7.1fx real-time) frames: %u data, %u lost, %u total, RX peak %u bits, %u dropped, %u marks dropped\n",
+        stateName(state), n, secs, rate, rate / double(bitRate(state)), counters.data, counters.lost, counters.frames,
+        io.getRXPeak(), io.getRXDropped() - dropped, io.getRXMarksDropped() - marksDropped);
+    printPackets(counters, n, state);
+    if (state == STATE_NXDN)
+        ::fprintf(stdout, "      NXDN %u frames dropped by the LICH check\n", nxdnRX.getFiltered() - nxdnFiltered);
+    printRejects(state, rejects);
+    if (g_transmit)
+        ::fprintf(stdout, "      TX %llu bits, hash %08X, %u bits dropped, %u marks dropped\n", (unsigned long long)(hostSim.getTXBits() - txBits),
+            hostSim.getTXHash(), io.getTXDropped(), io.getTXMarksDropped());
+    if (g_credits > 0U) {
+        uint16_t peak = 0U;
+        for (uint8_t i = 0U; i < (SERIAL_CREDITS_LEN / 4U); i++) {
+            if (g_txCredit[i].peak > peak)
+                peak = g_txCredit[i].peak;
+        }
+
+        ::fprintf(stdout, "      TX credits %u events (every %u ms at most), %u ring buffer full NAKs, %u ms peak queued\n",
+            counters.credits, g_credits, counters.full, peak);
+    }
+    if (g_profile)
+        printProfile();
+    if (g_trace)
+        printTrace();
+
+    return true;
+}
+
+/* Helper to find a frame in the bits captured from the TXD pin, from the given bit on. */
+
+static int32_t findFrame(const uint8_t* capture, const uint8_t* frame, uint16_t length, uint32_t from)
+{
+    uint32_t frameBits = length * 8U;
+    for (uint32_t n = from; n + frameBits <= LAUNCH_CAPTURE_BITS; n++) {
+        uint32_t i = 0U;
+        while (i < frameBits && _READ_BIT(capture, n + i) == _READ_BIT(frame, i))
+            i++;
+
+        if (i == frameBits)
+            return int32_t(n);
+    }
+
+    return -1;
+}
+
+/* Checks frames written with a launch time go out at it, and a frame that can't is reported late. */
+
+static bool launch(DVM_STATE state, uint8_t colorCode, uint16_t nac)
+{
+    if (!configure(state, colorCode, nac))
+        return false;
+
+    // frame length (P25 HDUs, so all four fit the FIFO), the air time each frame takes up (DMR bursts
+    // are padded out to 60 ms), and the gap ahead of the last frame; P25 and NXDN hang 4 bits of silence
+    // per tail count (625 ms and 5 s), so their gap lies between that hang and twice it
+    uint8_t cmd = CMD_DMR_DATA2;
+    uint16_t length = dmr::DMR_FRAME_LENGTH_BYTES;
+    uint32_t airBits = 576U;
+    uint32_t gapBits = 30000U;
+    switch (state) {
+    case STATE_P25:
+        cmd = CMD_P25_DATA;
+        length = p25::P25_HDU_FRAME_LENGTH_BYTES;
+        airBits = length * 8U;
+        gapBits = 4500U;
+        break;
+    case STATE_NXDN:
+        cmd = CMD_NXDN_DATA;
+        length = nxdn::NXDN_FRAME_LENGTH_BYTES;
+        airBits = length * 8U;
+        gapBits = 18000U;
+        break;
+    default:
+        break;
+    }
+
+    HostCounters counters;
+    ::memset(&counters, 0x00U, sizeof(HostCounters));
+    g_lateLaunch = g_lateStart = 0U;
+
+    uint8_t* capture = new uint8_t[LAUNCH_CAPTURE_BITS / 8U];
+    ::memset(capture, 0x00U, LAUNCH_CAPTURE_BITS / 8U);
+    hostSim.setTXCapture(capture, LAUNCH_CAPTURE_BITS);
+
+    // the first frame launches from idle, well after its preamble would otherwise have started; the second
+    // an odd number of bits after the first ends (so it can only start within a symbol); the third has no
+    // launch time and follows the second; the launch time of the fourth has long passed when it is due; and
+    // the fifth launches beyond the TX hang, so the transmitter unkeys before it
+    uint32_t base = io.getClock();
+    uint32_t launches[LAUNCH_FRAMES];
+    launches[0U] = base + 8000U;
+    launches[1U] = launches[0U] + airBits + 1001U;
+    launches[2U] = 0U;
+    launches[3U] = launches[0U];
+    launches[4U] = launches[1U] + airBits * 3U + gapBits;
+
+    uint8_t frames[LAUNCH_FRAMES][SERIAL_FB_LEN];
+    for (uint8_t k = 0U; k < LAUNCH_FRAMES; k++) {
+        uint8_t* frame = frames[k];
+        uint16_t headerLength = (k != 2U) ? 8U : 4U;
+
+        frame[0U] = DVM_SHORT_FRAME_START;
+        frame[1U] = uint8_t(headerLength + length);
+        frame[2U] = cmd;
+        frame[3U] = 0x00U;
+        if (k != 2U) {
+            frame[3U] |= DVM_TX_LAUNCH;
+            for (uint8_t i = 0U; i < 4U; i++)
+                frame[4U + i] = (launches[k] >> (24U - i * 8U)) & 0xFFU;
+        }
+        for (uint16_t i = 0U; i < length; i++)
+            frame[headerLength + i] = uint8_t(i * 0x9DU + 0x35U + k * 0x5BU);
+
+        hostSim.hostWrite(frame, headerLength + length);
+    }
+
+    // follow the transmitter keying up and down
+    uint32_t bits = (launches[4U] - base) + airBits + 4000U;
+    uint32_t keyedUp = 0U, keyedDown = 0U, unkeyed = 0U;
+    bool keyed = m_tx;
+    for (uint32_t n = 0U; n < bits; n++) {
+        hostSim.clockBit();
+        loop();
+
+        if (m_tx != keyed) {
+            keyed = m_tx;
+            if (keyed) {
+                keyedDown = unkeyed;
+                keyedUp = io.getClock();
+            }
+            else
+                unkeyed = io.getClock();
+        }
+
+        if ((n & 0x3FU) == 0x3FU)
+            drainFrames(counters);
+    }
+    drainFrames(counters);
+    hostSim.setTXCapture(NULL, 0U);
+
+    // find each frame, in order, in what was sent
+    bool ret = true;
+    uint32_t starts[LAUNCH_FRAMES];
+    uint32_t from = 0U;
+    for (uint8_t k = 0U; k < LAUNCH_FRAMES; k++) {
+        uint16_t headerLength = (k != 2U) ? 8U : 4U;
+        int32_t n = findFrame(capture, frames[k] + headerLength, length, from);
+        if (n < 0) {
+            ::fprintf(stderr, "%s: launch frame %u was never sent\n", stateName(state), k);
+            delete[] capture;
+            return false;
+        }
+
+        starts[k] = base + uint32_t(n);
+        from = uint32_t(n) + length * 8U;
+    }
+
+    uint32_t first = 0U;
+    hostSim.getTXFirst(first);
+
+    int32_t offsets[3U] = { int32_t(starts[0U] - launches[0U]), int32_t(starts[1U] - launches[1U]), int32_t(starts[4U] - launches[4U]) };
+    ::fprintf(stdout, "%-5s launch: keyed up %d bits ahead, frames sent %d, %d and %d bits from their launch times, late frame sent %d bits after (%u reported), keyed up again %d bits ahead\n",
+        stateName(state), int32_t(launches[0U] - first), offsets[0U], offsets[1U], offsets[2U], int32_t(starts[3U] - launches[3U]),
+        counters.late, int32_t(launches[4U] - keyedUp));
+
+    if (int32_t(first - base) < 64) {
+        ::fprintf(stderr, "%s: keyed up as the first frame was written, rather than ahead of its launch time\n", stateName(state));
+        ret = false;
+    }
+    for (uint8_t k = 0U; k < 3U; k++) {
+        if (offsets[k] < -1 || offsets[k] > 1) {
+            ::fprintf(stderr, "%s: launch frame %u sent %d bits from its launch time\n", stateName(state), (k < 2U) ? k : 4U, offsets[k]);
+            ret = false;
+        }
+    }
+    if (int32_t(keyedDown - (starts[3U] + airBits)) < 0 || int32_t(keyedUp - keyedDown) < 0 || int32_t(starts[4U] - keyedUp) < 64) {
+        ::fprintf(stderr, "%s: the transmitter wasn't unkeyed and keyed up again ahead of the last frame\n", stateName(state));
+        ret = false;
+    }
+    if (starts[2U] != starts[1U] + airBits) {
+        ::fprintf(stderr, "%s: the frame without a launch time didn't follow the one before\n", stateName(state));
+        ret = false;
+    }
+    if (counters.late != 1U || g_lateLaunch != launches[3U] || g_lateStart != starts[3U]) {
+        ::fprintf(stderr, "%s: %u frames reported late; the last launching at %u sent at %u, rather than %u at %u\n",
+            stateName(state), counters.late, g_lateLaunch, g_lateStart, launches[3U], starts[3U]);
+        ret = false;
+    }
+    if (counters.nak > 0U)
+        ret = false;
+
+    delete[] capture;
+    return ret;
+}
+
+/* Replays a capture straight into the RX ring buffer at the given multiple of real-time (0 for unlimited). */
+
+static bool replay(const HostCapture& capture, double multiple, uint8_t colorCode, uint16_t nac, HostFrameLog& log)
+{
+    DVM_STATE state = capture.getState();
+
+    // the receive chain for a mode is only reset when another mode is selected; bounce through
+    // another mode first so every replay starts from the same receiver state
+    if (!configure((state == STATE_P25) ? STATE_NXDN : STATE_P25, colorCode, nac))
+        return false;
+    if (!configure(state, colorCode, nac))
+        return false;
+#if defined(ENABLE_PROFILER)
+    profiler.reset();
+#endif
+#if defined(ENABLE_TRACER)
+    tracer.reset();
+#endif
+
+    HostCounters counters;
+    ::memset(&counters, 0x00U, sizeof(HostCounters));
+    log.clear();
+
+    uint32_t nxdnFiltered = nxdnRX.getFiltered();
+    uint32_t rejects[REJECT_COUNTS];
+    getRejects(rejects);
+
+    uint32_t length = capture.getLength();
+#if defined(SEND_RX_TIMESTAMP)
+    g_rxCapture = &capture;
+    g_rxBase = io.getClock();
+    g_rxChecked = 0U;
+    g_rxMisplaced = 0U;
+#endif
+    double bitsPerNs = double(bitRate(state)) * multiple / 1e9;
+
+    uint32_t n = 0U;
+    uint32_t dropped = 0U;
+    uint32_t passes = 0U;
+    uint64_t start = now();
+    while (n < length) {
+        if (multiple > REPLAY_RATE_MAX) {
+            // paced; bits that are due but don't fit the ring buffer are lost, just as with the air interface
+            uint32_t due = uint32_t(double(now() - start) * bitsPerNs);
+            if (due > length)
+                due = length;
+
+            for (; n < due; n++) {
+                if (!io.injectRX(capture.getBit(n), capture.getControl(n)))
+                    dropped++;
+            }
+        }
+        else {
+            // unlimited; fill the ring buffer as far as it goes (a bit that doesn't fit would still take a
+            // bit period)
+            for (; n < length && io.getRXSpace() > 0U; n++)
+                io.injectRX(capture.getBit(n), capture.getControl(n));
+        }
+
+        loop();
+
+        if ((++passes & 0x3FU) == 0x3FU)
+            drainFrames(counters, &log);
+    }
+
+    // let the receive chain drain the ring buffer
+    uint16_t space;
+    do {
+        space = io.getRXSpace();
+        loop();
+    } while (io.getRXSpace() != space);
+
+    uint64_t elapsed = now() - start;
+    drainFrames(counters, &log);
+    flushFrames(counters, &log);
+
+    double secs = double(elapsed) / 1e9;
+    double rate = (secs > 0.0) ? double(length) / secs : 0.0;
+
+    char rateText[16U];
+    if (multiple > REPLAY_RATE_MAX)
+        ::snprintf(rateText, sizeof(rateText), "%gx", multiple);
+    else
+        ::snprintf(rateText, sizeof(rateText), "max");
+
+    ::fprintf(stdout, "%-5s replay %-7s %10u bits %9.3f s %12.0f bits/s (%7.1fx real-time) frames: %u data, %u lost, %u total, %u bits dropped\n",
+        stateName(state), rateText, length, secs, rate, rate / double(bitRate(state)), counters.data, counters.lost, counters.frames, dropped);
+    printPackets(counters, length, state);
+    if (state == STATE_NXDN)
+        ::fprintf(stdout, "      NXDN %u frames dropped by the LICH check\n", nxdnRX.getFiltered() - nxdnFiltered);
+    printRejects(state, rejects);
+    if (g_profile)
+        printProfile();
+    if (g_trace)
+        printTrace();
+
+#if defined(SEND_RX_TIMESTAMP)
+    g_rxCapture = NULL;
+    ::fprintf(stdout, "      RX timestamps: %u frames checked against the capture, %u misplaced\n", g_rxChecked, g_rxMisplaced);
+    if (g_rxMisplaced > 0U)
+        return false;
+#endif
+
+    return true;
+}
+
+/* Replays a capture at increasing multiples of real-time until frames start being lost. */
+
+static bool sweep(const HostCapture& capture, const HostFrameLog& reference, uint8_t colorCode, uint16_t nac)
+{
+    DVM_STATE state = capture.getState();
+
+    HostFrameLog log;
+    for (uint32_t i = 0U; i < SWEEP_MULTIPLES_LENGTH; i++) {
+        if (!replay(capture, SWEEP_MULTIPLES[i], colorCode, nac, log))
+            return false;
+
+        int32_t mismatch = log.compare(reference);
+        if (mismatch >= 0) {
+            ::fprintf(stdout, "%-5s frames lost at %gx real-time (%.0f bits/s); first difference at frame %d of %u\n",
+                stateName(state), SWEEP_MULTIPLES[i], SWEEP_MULTIPLES[i] * double(bitRate(state)), mismatch, reference.getCount());
+            return true;
+        }
+    }
+
+    ::fprintf(stdout, "%-5s no frames lost up to %gx real-time\n", stateName(state), SWEEP_MULTIPLES[SWEEP_MULTIPLES_LENGTH - 1U]);
+    return true;
+}
+
+/* Displays the program usage. */
+
+static void usage(const char* progName)
+{
+    ::fprintf(stdout,
+        "usage: %s [-m dmr|p25|nxdn|all] [-n bits] [-l loops] [-e bits] [-i file] [-c cc] [-a nac] [-C mask] [-A nacs] [-B ms]\n"
+        "          [-F ms] [-t] [-T] [-d] [-p] [-L]\n"
+        "       %s -m dmr|p25|nxdn -s capture [-k calls] [-c cc] [-a nac]\n"
+        "       %s -r capture [-m dmr|p25|nxdn] [-R max|sweep|multiple] [-w golden] [-g golden] [-c cc] [-a nac] [-C mask]\n"
+        "          [-A nacs] [-B ms] [-d] [-p] [-L]\n"
+        "       %s -b all|name [-n iterations]\n\n"
+        "  -m   modem mode to run (default: all)\n"
+        "  -n   number of bit periods to clock (default: %u)\n"
+        "  -l   superloop passes per bit period (default: 1)\n"
+        "  -e   bit periods clocked between superloop passes, to emulate passes stalled by host\n"
+        "       traffic (default: 1)\n"
+        "  -i   raw RXD bit stream (packed, MSB first) to present on the air interface (default: pseudo-random)\n"
+        "  -c   DMR color code (default: 1)\n"
+        "  -a   P25 NAC (default: $293)\n"
+        "  -C   bitmask of the DMR color codes the receivers allow (default: the -c color code only)\n"
+        "  -A   comma separated P25 NACs the receiver allows (default: the -a NAC only)\n"
+        "  -B   batch the frames written by the modem (and to it, with -t), flushing within the given\n"
+        "       deadline in milliseconds (default: 0, off)\n"
+        "  -F   feed the transmitter (with -t) from the TX credits the modem reports, at most every given\n"
+        "       milliseconds (default: 0, off)\n"
+        "  -t   keep the transmitter fed with frames from the host\n"
+        "  -T   check frames written with a launch time are transmitted at it, instead of clocking bits\n"
+        "  -d   display modem debug messages\n"
+        "  -p   display the hot path profile (requires the host-profile build)\n"
+        "  -L   display the per-stage latency of the received frames (requires the host-trace build)\n"
+        "  -s   synthesize a capture of valid traffic for the mode and write it to the given file\n"
+        "  -k   number of transmissions to synthesize (default: %u)\n"
+        "  -r   replay a capture (or raw packed bit stream) straight into the RX ring buffer\n"
+        "  -R   replay rate; max (unlimited), sweep (increasing multiples of real-time until frames\n"
+        "       are lost) or a multiple of real-time (default: max)\n"
+        "  -w   write the frames produced by the replay to the given golden file\n"
+        "  -g   compare the frames produced by the replay against the given golden file\n"
+        "  -b   run the named microbenchmark (or all) for -n iterations (default: %u)\n",
+        progName, progName, progName, progName, DEFAULT_BITS, DEFAULT_CALLS, DEFAULT_ITERATIONS);
+}
+
+// ---------------------------------------------------------------------------
+//  Host Simulator Entry Point
+// ---------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    const char* mode = "all";
+    const char* fileName = NULL;
+    const char* captureFile = NULL;
+    const char* synthFile = NULL;
+    const char* goldenIn = NULL;
+    const char* benchName = NULL;
+    const char* goldenOut = NULL;
+    uint32_t bits = DEFAULT_BITS;
+    bool bitsSet = false;
+    uint32_t loops = 1U;
+    uint32_t stall = 1U;
+    uint32_t calls = DEFAULT_CALLS;
+    uint8_t colorCode = 1U;
+    uint16_t nac = 0x293U;
+    double replayRate = REPLAY_RATE_MAX;
+
+    int c;
+    while ((c = ::getopt(argc, argv, "m:n:l:e:i:c:a:C:A:B:F:s:k:r:R:w:g:b:pLtTdh")) != -1) {
+        switch (c) {
+        case 'm':
+            mode = optarg;
+            break;
+        case 'n':
+            bits = uint32_t(::strtoul(optarg, NULL, 0));
+            bitsSet = true;
+            break;
+        case 'l':
+            loops = uint32_t(::strtoul(optarg, NULL, 0));
+            break;
+        case 'e':
+            stall = uint32_t(::strtoul(optarg, NULL, 0));
+            if (stall == 0U)
+                stall = 1U;
+            break;
+        case 'i':
+            fileName = optarg;
+            break;
+        case 'c':
+            colorCode = uint8_t(::strtoul(optarg, NULL, 0));
+            break;
+        case 'a':
+            nac = uint16_t(::strtoul(optarg, NULL, 0));
+            break;
+        case 'C':
+            g_colorCodes = uint16_t(::strtoul(optarg, NULL, 0));
+            break;
+        case 'A':
+            {
+                char* p = optarg;
+                g_allowNACCount = 0U;
+                while (*p != '\0' && g_allowNACCount < MAX_ALLOW_NACS) {
+                    uint16_t allow = uint16_t(::strtoul(p, &p, 0));
+                    g_allowNACs[g_allowNACCount * 2U] = (allow >> 8) & 0xFFU;
+                    g_allowNACs[g_allowNACCount * 2U + 1U] = (allow >> 0) & 0xFFU;
+                    g_allowNACCount++;
+
+                    if (*p != ',')
+                        break;
+                    p++;
+                }
+            }
+            break;
+        case 'B':
+            g_batch = uint8_t(::strtoul(optarg, NULL, 0));
+            break;
+        case 'F':
+            g_credits = uint8_t(::strtoul(optarg, NULL, 0));
+            break;
+        case 's':
+            synthFile = optarg;
+            break;
+        case 'k':
+            calls = uint32_t(::strtoul(optarg, NULL, 0));
+            break;
+        case 'r':
+            captureFile = optarg;
+            break;
+        case 'R':
+            if (::strcmp(optarg, "max") == 0)
+                replayRate = REPLAY_RATE_MAX;
+            else if (::strcmp(optarg, "sweep") == 0)
+                replayRate = REPLAY_RATE_SWEEP;
+            else {
+                replayRate = ::strtod(optarg, NULL);
+                if (replayRate <= 0.0) {
+                    usage(argv[0U]);
+                    return EXIT_FAILURE;
+                }
+            }
+            break;
+        case 'w':
+            goldenOut = optarg;
+            break;
+        case 'g':
+            goldenIn = optarg;
+            break;
+        case 'b':
+            benchName = optarg;
+            break;
+        case 'd':
+            g_debug = true;
+            break;
+        case 'p':
+            g_profile = true;
+            break;
+        case 'L':
+            g_trace = true;
+            break;
+        case 't':
+            g_transmit = true;
+            break;
+        case 'T':
+            g_launch = true;
+            break;
+        default:
+            usage(argv[0U]);
+            return (c == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (::strcmp(mode, "dmr") != 0 && ::strcmp(mode, "p25") != 0 && ::strcmp(mode, "nxdn") != 0 && ::strcmp(mode, "all") != 0) {
+        usage(argv[0U]);
+        return EXIT_FAILURE;
+    }
+
+    DVM_STATE state = STATE_IDLE;
+    if (::strcmp(mode, "dmr") == 0)
+        state = STATE_DMR;
+    else if (::strcmp(mode, "p25") == 0)
+        state = STATE_P25;
+    else if (::strcmp(mode, "nxdn") == 0)
+        state = STATE_NXDN;
+
+    // run microbenchmarks
+    if (benchName != NULL) {
+        HostBench bench(bitsSet ? bits : DEFAULT_ITERATIONS);
+        return bench.run(benchName) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // synthesize a capture
+    if (synthFile != NULL) {
+        if (state == STATE_IDLE) {
+            ::fprintf(stderr, "a single mode is required to synthesize a capture\n");
+            return EXIT_FAILURE;
+        }
+
+        HostCapture capture;
+        capture.generate(state, colorCode, nac, calls);
+        if (!capture.save(synthFile))
+            return EXIT_FAILURE;
+
+        ::fprintf(stdout, "%-5s wrote %u bits (%.3f s) to %s\n", stateName(state), capture.getLength(),
+            double(capture.getLength()) / double(bitRate(state)), synthFile);
+        return EXIT_SUCCESS;
+    }
+
+    // replay a capture straight into the RX ring buffer
+    if (captureFile != NULL) {
+        HostCapture capture;
+        if (!capture.load(captureFile, state))
+            return EXIT_FAILURE;
+
+        if (capture.getState() != STATE_DMR && capture.getState() != STATE_P25 && capture.getState() != STATE_NXDN) {
+            ::fprintf(stderr, "%s: a single mode is required to replay a raw capture\n", captureFile);
+            return EXIT_FAILURE;
+        }
+
+        setup();
+
+        HostFrameLog log;
+        if (!replay(capture, (replayRate == REPLAY_RATE_SWEEP) ? REPLAY_RATE_MAX : replayRate, colorCode, nac, log))
+            return EXIT_FAILURE;
+
+        if (goldenOut != NULL) {
+            if (!log.save(goldenOut, capture.getState()))
+                return EXIT_FAILURE;
+            ::fprintf(stdout, "golden: wrote %u frames to %s\n", log.getCount(), goldenOut);
+        }
+
+        bool ret = true;
+        if (goldenIn != NULL) {
+            int32_t mismatch = log.compare(goldenIn, true);
+            if (mismatch == -1)
+                ::fprintf(stdout, "golden: %u frames match %s\n", log.getCount(), goldenIn);
+            else
+                ret = false;
+        }
+
+        // the unlimited replay (whose output was checked against the golden file) is the reference
+        // for the sweep
+        if (ret && replayRate == REPLAY_RATE_SWEEP)
+            ret = sweep(capture, log, colorCode, nac);
+
+        return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    uint8_t* rxBits = NULL;
+    uint32_t rxLength = 0U;
+    if (fileName != NULL) {
+        FILE* fp = ::fopen(fileName, "rb");
+        if (fp == NULL) {
+            ::fprintf(stderr, "failed to open %s\n", fileName);
+            return EXIT_FAILURE;
+        }
+
+        ::fseek(fp, 0L, SEEK_END);
+        long size = ::ftell(fp);
+        ::fseek(fp, 0L, SEEK_SET);
+
+        rxBits = new uint8_t[size > 0L ? size : 1L];
+        rxLength = uint32_t(::fread(rxBits, 1U, size > 0L ? size : 0L, fp)) * 8U;
+        ::fclose(fp);
+    }
+
+    setup();
+    hostSim.setRXSource(rxBits, rxLength, true);
+
+    bool ret = true;
+    if (g_launch) {
+        if (state == STATE_DMR || state == STATE_IDLE)
+            ret &= launch(STATE_DMR, colorCode, nac);
+        if (state == STATE_P25 || state == STATE_IDLE)
+            ret &= launch(STATE_P25, colorCode, nac);
+        if (state == STATE_NXDN || state == STATE_IDLE)
+            ret &= launch(STATE_NXDN, colorCode, nac);
+
+        return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (state == STATE_DMR || state == STATE_IDLE)
+        ret &= run(STATE_DMR, bits, loops, stall, colorCode, nac);
+    if (state == STATE_P25 || state == STATE_IDLE)
+        ret &= run(STATE_P25, bits, loops, stall, colorCode, nac);
+    if (state == STATE_NXDN || state == STATE_IDLE)
+        ret &= run(STATE_NXDN, bits, loops, stall, colorCode, nac);
+
+    if (rxBits != NULL)
+        delete[] rxBits;
+
+    return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // HOST_SIM
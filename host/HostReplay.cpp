@@ -0,0 +1,570 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "host/HostReplay.h"
+#include "Utils.h"
+
+#if defined(HOST_SIM)
+#include "dmr/DMRAMBEFEC.h"
+#include "dmr/DMRBPTC.h"
+#include "dmr/DMRSlotType.h"
+#include "nxdn/NXDNLICH.h"
+#include "p25/P25IMBEFEC.h"
+#include "p25/P25NID.h"
+
+using namespace dmr;
+using namespace p25;
+using namespace nxdn;
+
+#include <stdio.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t INITIAL_CAPTURE_BITS = 65536U;
+const uint32_t INITIAL_LOG_LENGTH = 65536U;
+
+const uint32_t DMR_TDMA_FRAME_LENGTH_BITS = 576U;
+const uint32_t DMR_SUPERFRAME_LENGTH = 6U;
+const uint8_t  DMR_NO_SLOT_TYPE = 0xFFU;
+
+const uint32_t MAX_GOLDEN_LINE = 2048U;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the HostCapture class. */
+
+HostCapture::HostCapture() :
+    m_state(STATE_IDLE),
+    m_bits(NULL),
+    m_control(NULL),
+    m_length(0U),
+    m_capacity(0U),
+    m_hasControl(false),
+    m_seed(0x12345678U)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the HostCapture class. */
+
+HostCapture::~HostCapture()
+{
+    delete[] m_bits;
+    delete[] m_control;
+}
+
+/* Clears the capture. */
+
+void HostCapture::clear()
+{
+    m_state = STATE_IDLE;
+    m_length = 0U;
+    m_hasControl = false;
+    m_seed = 0x12345678U;
+}
+
+/* Loads a capture from a file. */
+
+bool HostCapture::load(const char* fileName, DVM_STATE state)
+{
+    FILE* fp = ::fopen(fileName, "rb");
+    if (fp == NULL) {
+        ::fprintf(stderr, "failed to open %s\n", fileName);
+        return false;
+    }
+
+    ::fseek(fp, 0L, SEEK_END);
+    long size = ::ftell(fp);
+    ::fseek(fp, 0L, SEEK_SET);
+
+    uint8_t* data = new uint8_t[size > 0L ? size : 1L];
+    uint32_t length = uint32_t(::fread(data, 1U, size > 0L ? size : 0L, fp));
+    ::fclose(fp);
+
+    clear();
+
+    const uint8_t* bits = data;
+    const uint8_t* control = NULL;
+    uint32_t nBits = length * 8U;
+    m_state = state;
+
+    if (length >= HOST_CAPTURE_HEADER_LENGTH && ::memcmp(data, HOST_CAPTURE_MAGIC, 4U) == 0) {
+        if (data[4U] != HOST_CAPTURE_VERSION) {
+            ::fprintf(stderr, "%s: unsupported capture version %u\n", fileName, data[4U]);
+            delete[] data;
+            return false;
+        }
+
+        m_state = DVM_STATE(data[5U]);
+        nBits = (data[8U] << 24) | (data[9U] << 16) | (data[10U] << 8) | data[11U];
+
+        uint32_t nBytes = (nBits + 7U) / 8U;
+        uint32_t needed = HOST_CAPTURE_HEADER_LENGTH + nBytes;
+        if ((data[6U] & HOST_CAPTURE_FLAG_CONTROL) == HOST_CAPTURE_FLAG_CONTROL)
+            needed += nBytes;
+
+        if (length < needed) {
+            ::fprintf(stderr, "%s: truncated capture (%u of %u bytes)\n", fileName, length, needed);
+            delete[] data;
+            return false;
+        }
+
+        bits = data + HOST_CAPTURE_HEADER_LENGTH;
+        if ((data[6U] & HOST_CAPTURE_FLAG_CONTROL) == HOST_CAPTURE_FLAG_CONTROL)
+            control = bits + nBytes;
+    }
+
+    for (uint32_t i = 0U; i < nBits; i++)
+        append(_READ_BIT(bits, i) != 0U, (control != NULL) ? (_READ_BIT(control, i) != 0U) : false);
+    m_hasControl = (control != NULL);
+
+    delete[] data;
+    return true;
+}
+
+/* Saves the capture to a file. */
+
+bool HostCapture::save(const char* fileName) const
+{
+    FILE* fp = ::fopen(fileName, "wb");
+    if (fp == NULL) {
+        ::fprintf(stderr, "failed to create %s\n", fileName);
+        return false;
+    }
+
+    uint8_t header[HOST_CAPTURE_HEADER_LENGTH];
+    ::memset(header, 0x00U, HOST_CAPTURE_HEADER_LENGTH);
+    ::memcpy(header, HOST_CAPTURE_MAGIC, 4U);
+    header[4U] = HOST_CAPTURE_VERSION;
+    header[5U] = uint8_t(m_state);
+    header[6U] = m_hasControl ? HOST_CAPTURE_FLAG_CONTROL : 0x00U;
+    header[8U] = (m_length >> 24) & 0xFFU;
+    header[9U] = (m_length >> 16) & 0xFFU;
+    header[10U] = (m_length >> 8) & 0xFFU;
+    header[11U] = (m_length >> 0) & 0xFFU;
+
+    uint32_t nBytes = (m_length + 7U) / 8U;
+    bool ret = ::fwrite(header, 1U, HOST_CAPTURE_HEADER_LENGTH, fp) == HOST_CAPTURE_HEADER_LENGTH;
+    if (nBytes > 0U) {
+        ret &= ::fwrite(m_bits, 1U, nBytes, fp) == nBytes;
+        if (m_hasControl)
+            ret &= ::fwrite(m_control, 1U, nBytes, fp) == nBytes;
+    }
+
+    ::fclose(fp);
+    return ret;
+}
+
+/* Synthesizes a capture of valid traffic for the given modem state. */
+
+void HostCapture::generate(DVM_STATE state, uint8_t colorCode, uint16_t nac, uint32_t calls)
+{
+    clear();
+    m_state = state;
+
+    for (uint32_t n = 0U; n < calls; n++) {
+        switch (state) {
+        case STATE_DMR:
+            {
+                appendNoise(DMR_TDMA_FRAME_LENGTH_BITS * 4U);
+
+                // voice call; LC header, superframes (A with voice sync, B - F with embedded signalling), terminator
+                appendDMR(DMR_MS_DATA_SYNC_BYTES, colorCode, DT_VOICE_LC_HEADER);
+                for (uint32_t i = 0U; i < 3U; i++) {
+                    appendDMR(DMR_MS_VOICE_SYNC_BYTES, colorCode, DMR_NO_SLOT_TYPE);
+                    for (uint32_t j = 1U; j < DMR_SUPERFRAME_LENGTH; j++)
+                        appendDMR(NULL, colorCode, DMR_NO_SLOT_TYPE);
+                }
+                appendDMR(DMR_MS_DATA_SYNC_BYTES, colorCode, DT_TERMINATOR_WITH_LC);
+                appendNoise(DMR_TDMA_FRAME_LENGTH_BITS * 2U);
+
+                // control
+                appendDMR(DMR_MS_DATA_SYNC_BYTES, colorCode, DT_CSBK);
+                appendNoise(DMR_TDMA_FRAME_LENGTH_BITS * 2U);
+
+                // data; header and rate 1/2 blocks
+                appendDMR(DMR_MS_DATA_SYNC_BYTES, colorCode, DT_DATA_HEADER);
+                for (uint32_t i = 0U; i < 3U; i++)
+                    appendDMR(DMR_MS_DATA_SYNC_BYTES, colorCode, DT_RATE_12_DATA);
+
+                // long enough for the receiver to lose lock
+                appendNoise(DMR_TDMA_FRAME_LENGTH_BITS * 16U);
+            }
+            break;
+
+        case STATE_P25:
+            {
+                appendNoise(P25_LDU_FRAME_LENGTH_BITS);
+
+                // voice call; HDU, LDU1/LDU2 pairs, TDU
+                appendP25(nac, P25_DUID_HDU, P25_HDU_FRAME_LENGTH_BYTES);
+                for (uint32_t i = 0U; i < 3U; i++) {
+                    appendP25(nac, P25_DUID_LDU1, P25_LDU_FRAME_LENGTH_BYTES);
+                    appendP25(nac, P25_DUID_LDU2, P25_LDU_FRAME_LENGTH_BYTES);
+                }
+                appendP25(nac, P25_DUID_TDU, P25_TDU_FRAME_LENGTH_BYTES);
+                appendNoise(P25_LDU_FRAME_LENGTH_BITS);
+
+                // control
+                appendP25(nac, P25_DUID_TSDU, P25_TSDU_FRAME_LENGTH_BYTES);
+                appendNoise(P25_LDU_FRAME_LENGTH_BITS);
+
+                // data
+                appendP25(nac, P25_DUID_PDU, P25_PDU_FRAME_LENGTH_BYTES);
+                appendNoise(P25_LDU_FRAME_LENGTH_BITS * 2U);
+            }
+            break;
+
+        case STATE_NXDN:
+            {
+                appendNoise(NXDN_FRAME_LENGTH_BITS * 2U);
+
+                // data channel voice; the last frame carries the idle SACCH
+                for (uint32_t i = 0U; i < 8U; i++)
+                    appendNXDN((i == 7U) ? NXDN_LICH_USC_SACCH_SS_IDLE : NXDN_LICH_USC_SACCH_NS);
+
+                // long enough for the receiver to lose lock
+                appendNoise(NXDN_FRAME_LENGTH_BITS * 8U);
+            }
+            break;
+
+        default:
+            appendNoise(DMR_TDMA_FRAME_LENGTH_BITS);
+            break;
+        }
+    }
+}
+
+/* Initializes a new instance of the HostFrameLog class. */
+
+HostFrameLog::HostFrameLog() :
+    m_text(NULL),
+    m_length(0U),
+    m_capacity(0U),
+    m_count(0U)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the HostFrameLog class. */
+
+HostFrameLog::~HostFrameLog()
+{
+    delete[] m_text;
+}
+
+/* Clears the log. */
+
+void HostFrameLog::clear()
+{
+    m_length = 0U;
+    m_count = 0U;
+}
+
+/* Records a frame. */
+
+void HostFrameLog::add(uint8_t cmd, const uint8_t* data, uint16_t length)
+{
+    // "CC " + 2 characters per byte + line terminator
+    uint32_t needed = m_length + 3U + (length * 2U) + 1U;
+    if (needed > m_capacity) {
+        uint32_t capacity = (m_capacity == 0U) ? INITIAL_LOG_LENGTH : m_capacity;
+        while (capacity < needed)
+            capacity *= 2U;
+
+        char* text = new char[capacity];
+        if (m_text != NULL) {
+            ::memcpy(text, m_text, m_length);
+            delete[] m_text;
+        }
+
+        m_text = text;
+        m_capacity = capacity;
+    }
+
+    static const char HEX[] = "0123456789ABCDEF";
+
+    char* p = m_text + m_length;
+    *p++ = HEX[(cmd >> 4) & 0x0FU];
+    *p++ = HEX[cmd & 0x0FU];
+    *p++ = ' ';
+    for (uint16_t i = 0U; i < length; i++) {
+        *p++ = HEX[(data[i] >> 4) & 0x0FU];
+        *p++ = HEX[data[i] & 0x0FU];
+    }
+    *p++ = '\n';
+
+    m_length = uint32_t(p - m_text);
+    m_count++;
+}
+
+/* Saves the log as a golden file. */
+
+bool HostFrameLog::save(const char* fileName, DVM_STATE state) const
+{
+    FILE* fp = ::fopen(fileName, "w");
+    if (fp == NULL) {
+        ::fprintf(stderr, "failed to create %s\n", fileName);
+        return false;
+    }
+
+    ::fprintf(fp, "# dvm-firmware-hs golden frames, state %u, %u frames\n", uint32_t(state), m_count);
+    bool ret = true;
+    if (m_length > 0U)
+        ret = ::fwrite(m_text, 1U, m_length, fp) == m_length;
+
+    ::fclose(fp);
+    return ret;
+}
+
+/* Compares the log against a golden file. */
+
+int32_t HostFrameLog::compare(const char* fileName, bool verbose) const
+{
+    FILE* fp = ::fopen(fileName, "r");
+    if (fp == NULL) {
+        ::fprintf(stderr, "failed to open %s\n", fileName);
+        return -2;
+    }
+
+    char* line = new char[MAX_GOLDEN_LINE];
+
+    uint32_t offset = 0U;
+    int32_t n = 0;
+    int32_t ret = -1;
+    while (::fgets(line, MAX_GOLDEN_LINE, fp) != NULL) {
+        if (line[0U] == '#')
+            continue;
+
+        uint32_t expectedLength = uint32_t(::strcspn(line, "\r\n"));
+        uint32_t length = 0U;
+        const char* text = nextLine(offset, length);
+        if (text == NULL || length != expectedLength || ::memcmp(text, line, length) != 0) {
+            if (verbose) {
+                ::fprintf(stderr, "golden mismatch at frame %d\n", n);
+                ::fprintf(stderr, "  expected: %.*s\n", int(expectedLength), line);
+                if (text != NULL)
+                    ::fprintf(stderr, "  actual:   %.*s\n", int(length), text);
+                else
+                    ::fprintf(stderr, "  actual:   <none>\n");
+            }
+
+            ret = n;
+            break;
+        }
+
+        offset += length + 1U;
+        n++;
+    }
+
+    // frames beyond the end of the golden file
+    uint32_t length = 0U;
+    if (ret == -1 && nextLine(offset, length) != NULL) {
+        if (verbose) {
+            ::fprintf(stderr, "golden mismatch at frame %d\n", n);
+            ::fprintf(stderr, "  expected: <none>\n");
+            ::fprintf(stderr, "  actual:   %.*s\n", int(length), m_text + offset);
+        }
+
+        ret = n;
+    }
+
+    delete[] line;
+    ::fclose(fp);
+
+    return ret;
+}
+
+/* Compares the log against another log. */
+
+int32_t HostFrameLog::compare(const HostFrameLog& log) const
+{
+    uint32_t offset = 0U;
+    for (int32_t n = 0; ; n++) {
+        uint32_t length = 0U, otherLength = 0U;
+        const char* text = nextLine(offset, length);
+        const char* otherText = log.nextLine(offset, otherLength);
+
+        if (text == NULL && otherText == NULL)
+            return -1;
+
+        if (text == NULL || otherText == NULL || length != otherLength || ::memcmp(text, otherText, length) != 0)
+            return n;
+
+        offset += length + 1U;
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Appends a bit (and its slot control mark) to the capture. */
+
+void HostCapture::append(bool bit, bool control)
+{
+    if (m_length >= m_capacity) {
+        uint32_t capacity = (m_capacity == 0U) ? INITIAL_CAPTURE_BITS : m_capacity * 2U;
+
+        uint8_t* bits = new uint8_t[capacity / 8U];
+        uint8_t* marks = new uint8_t[capacity / 8U];
+        ::memset(bits, 0x00U, capacity / 8U);
+        ::memset(marks, 0x00U, capacity / 8U);
+        if (m_bits != NULL) {
+            ::memcpy(bits, m_bits, m_capacity / 8U);
+            ::memcpy(marks, m_control, m_capacity / 8U);
+            delete[] m_bits;
+            delete[] m_control;
+        }
+
+        m_bits = bits;
+        m_control = marks;
+        m_capacity = capacity;
+    }
+
+    _WRITE_BIT(m_bits, m_length, bit);
+    _WRITE_BIT(m_control, m_length, control);
+    m_length++;
+}
+
+/* Appends packed (MSB first) bits to the capture. */
+
+void HostCapture::appendBits(const uint8_t* data, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++)
+        append(_READ_BIT(data, i) != 0U);
+}
+
+/* Appends pseudo-random bits (idle channel noise) to the capture. */
+
+void HostCapture::appendNoise(uint32_t length)
+{
+    uint8_t data[64U];
+    while (length > 0U) {
+        uint32_t n = (length > 512U) ? 512U : length;
+        fill(data, 64U);
+        appendBits(data, n);
+        length -= n;
+    }
+}
+
+/* Fills a buffer with pseudo-random bytes. */
+
+void HostCapture::fill(uint8_t* data, uint32_t length)
+{
+    for (uint32_t i = 0U; i < length; i++) {
+        // xorshift32
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        data[i] = uint8_t(m_seed >> 24);
+    }
+}
+
+/* Appends a DMR burst (and the remainder of its TDMA frame). */
+
+void HostCapture::appendDMR(const uint8_t* sync, uint8_t colorCode, uint8_t dataType)
+{
+    uint8_t burst[DMR_FRAME_LENGTH_BYTES];
+    fill(burst, DMR_FRAME_LENGTH_BYTES);
+
+    // the sync (or embedded signalling) sits in the middle of the burst, straddling bytes 13 - 19
+    if (sync != NULL) {
+        for (uint8_t i = 0U; i < DMR_SYNC_BYTES_LENGTH; i++)
+            burst[i + 13U] = (burst[i + 13U] & ~DMR_SYNC_BYTES_MASK[i]) | (sync[i] & DMR_SYNC_BYTES_MASK[i]);
+    }
+
+    if (dataType != DMR_NO_SLOT_TYPE) {
+        DMRSlotType slotType;
+        slotType.encode(colorCode, dataType, burst);
+    }
+
+    // CSBKs and data headers carry a CRC checked BPTC (196,96) payload
+    if (dataType == DT_CSBK || dataType == DT_DATA_HEADER) {
+        uint8_t data[DMR_BPTC_DATA_LENGTH_BYTES];
+        fill(data, DMR_BPTC_DATA_LENGTH_BYTES - 2U);
+
+        uint16_t crc = crcCCITT162(data, DMR_BPTC_DATA_LENGTH_BYTES - 2U);
+        crc ^= (dataType == DT_CSBK) ? DMR_CSBK_CRC_MASK : DMR_DATA_HEADER_CRC_MASK;
+        data[10U] = uint8_t(crc >> 8);
+        data[11U] = uint8_t(crc & 0xFFU);
+
+        DMRBPTC bptc;
+        bptc.encode(data, burst);
+    }
+
+    // voice bursts carry three AMBE frames with Golay protected A and B vectors
+    if (dataType == DMR_NO_SLOT_TYPE) {
+        DMRAMBEFEC ambeFEC;
+        ambeFEC.encode(burst);
+    }
+
+    appendBits(burst, DMR_FRAME_LENGTH_BITS);
+
+    // the other timeslot
+    appendNoise(DMR_TDMA_FRAME_LENGTH_BITS - DMR_FRAME_LENGTH_BITS);
+}
+
+/* Appends a P25 data unit. */
+
+void HostCapture::appendP25(uint16_t nac, uint8_t duid, uint32_t length)
+{
+    uint8_t frame[P25_PDU_FRAME_LENGTH_BYTES];
+    fill(frame, length);
+
+    ::memcpy(frame, P25_SYNC_BYTES, P25_SYNC_BYTES_LENGTH);
+
+    P25NID nid;
+    nid.encode(nac, duid, frame);
+
+    // LDUs carry nine IMBE frames with Golay and Hamming protected vectors
+    if (duid == P25_DUID_LDU1 || duid == P25_DUID_LDU2) {
+        P25IMBEFEC imbeFEC;
+        imbeFEC.encode(frame);
+    }
+
+    appendBits(frame, length * 8U);
+}
+
+/* Appends a NXDN frame. */
+
+void HostCapture::appendNXDN(uint8_t fct)
+{
+    uint8_t frame[NXDN_FRAME_LENGTH_BYTES];
+    fill(frame, NXDN_FRAME_LENGTH_BYTES);
+
+    for (uint8_t i = 0U; i < NXDN_FSW_BYTES_LENGTH; i++)
+        frame[i] = (frame[i] & ~NXDN_FSW_BYTES_MASK[i]) | (NXDN_FSW_BYTES[i] & NXDN_FSW_BYTES_MASK[i]);
+
+    NXDNLICH lich;
+    lich.encode(NXDN_LICH_RFCT_RDCH, fct, 0x03U, true, frame); // no FACCH steal
+
+    appendBits(frame, NXDN_FRAME_LENGTH_BITS);
+}
+
+/* Helper to get the line starting at the given offset. */
+
+const char* HostFrameLog::nextLine(uint32_t offset, uint32_t& length) const
+{
+    if (offset >= m_length)
+        return NULL;
+
+    const char* text = m_text + offset;
+    const char* end = (const char*)::memchr(text, '\n', m_length - offset);
+    length = (end != NULL) ? uint32_t(end - text) : (m_length - offset);
+
+    return text;
+}
+
+#endif // HOST_SIM
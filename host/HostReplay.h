@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file HostReplay.h
+ * @ingroup host_sim
+ * @file HostReplay.cpp
+ * @ingroup host_sim
+ */
+#if !defined(__HOST_REPLAY_H__)
+#define __HOST_REPLAY_H__
+
+#if defined(HOST_SIM)
+
+#include "Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup host_sim
+ * @{
+ */
+
+/** @brief Magic bytes at the start of a capture file. */
+const uint8_t   HOST_CAPTURE_MAGIC[] = { 'D', 'V', 'M', 'R' };
+/** @brief Version of the capture file format. */
+const uint8_t   HOST_CAPTURE_VERSION = 0x01U;
+/** @brief Length of the capture file header. */
+const uint32_t  HOST_CAPTURE_HEADER_LENGTH = 12U;
+/** @brief Capture file flag indicating the slot control marks follow the bit stream. */
+const uint8_t   HOST_CAPTURE_FLAG_CONTROL = 0x01U;
+/** @} */
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a captured (or synthesized) RXD bit stream with its slot control marks.
+ * @details Capture files start with a 12 byte header ("DVMR", version, modem state, flags, reserved and
+ *  the big-endian bit count) followed by the packed (MSB first) bit stream and, if flagged, the packed
+ *  slot control marks. Files without the header are treated as a raw packed bit stream.
+ * @ingroup host_sim
+ */
+class DSP_FW_API HostCapture {
+public:
+    /**
+     * @brief Initializes a new instance of the HostCapture class.
+     */
+    HostCapture();
+    /**
+     * @brief Finalizes a instance of the HostCapture class.
+     */
+    ~HostCapture();
+
+    /**
+     * @brief Clears the capture.
+     */
+    void clear();
+
+    /**
+     * @brief Loads a capture from a file.
+     * @param fileName Capture file to load.
+     * @param state Modem state to assume for raw (headerless) capture files.
+     * @returns bool True, if the capture was loaded, otherwise false.
+     */
+    bool load(const char* fileName, DVM_STATE state);
+    /**
+     * @brief Saves the capture to a file.
+     * @param fileName Capture file to write.
+     * @returns bool True, if the capture was saved, otherwise false.
+     */
+    bool save(const char* fileName) const;
+
+    /**
+     * @brief Synthesizes a capture of valid traffic for the given modem state.
+     * @param state Modem state to synthesize traffic for.
+     * @param colorCode DMR color code.
+     * @param nac P25 NAC.
+     * @param calls Number of transmissions to synthesize.
+     */
+    void generate(DVM_STATE state, uint8_t colorCode, uint16_t nac, uint32_t calls);
+
+    /**
+     * @brief Gets the modem state the capture was taken in.
+     * @returns DVM_STATE Modem state.
+     */
+    DVM_STATE getState() const { return m_state; }
+    /**
+     * @brief Gets the length of the capture in bits.
+     * @returns uint32_t Length of the capture in bits.
+     */
+    uint32_t getLength() const { return m_length; }
+    /**
+     * @brief Gets the bit at the given position.
+     * @param n Bit position.
+     * @returns uint8_t Bit value.
+     */
+    uint8_t getBit(uint32_t n) const { return _READ_BIT(m_bits, n); }
+    /**
+     * @brief Gets the slot control mark at the given position.
+     * @param n Bit position.
+     * @returns uint8_t Slot control mark.
+     */
+    uint8_t getControl(uint32_t n) const { return _READ_BIT(m_control, n); }
+
+private:
+    DVM_STATE m_state;
+
+    uint8_t* m_bits;
+    uint8_t* m_control;
+    uint32_t m_length;
+    uint32_t m_capacity;
+    bool m_hasControl;
+
+    uint32_t m_seed;
+
+    /**
+     * @brief Appends a bit (and its slot control mark) to the capture.
+     * @param bit Bit value.
+     * @param control Slot control mark.
+     */
+    void append(bool bit, bool control = false);
+    /**
+     * @brief Appends packed (MSB first) bits to the capture.
+     * @param data Packed bits.
+     * @param length Number of bits.
+     */
+    void appendBits(const uint8_t* data, uint32_t length);
+    /**
+     * @brief Appends pseudo-random bits (idle channel noise) to the capture.
+     * @param length Number of bits.
+     */
+    void appendNoise(uint32_t length);
+    /**
+     * @brief Fills a buffer with pseudo-random bytes.
+     * @param[out] data Buffer to fill.
+     * @param length Length of buffer.
+     */
+    void fill(uint8_t* data, uint32_t length);
+
+    /**
+     * @brief Appends a DMR burst (and the remainder of its TDMA frame).
+     * @param sync Sync bytes for the burst; NULL for no sync (embedded signalling).
+     * @param colorCode DMR color code.
+     * @param dataType DMR data type; 0xFF for no slot type.
+     */
+    void appendDMR(const uint8_t* sync, uint8_t colorCode, uint8_t dataType);
+    /**
+     * @brief Appends a P25 data unit.
+     * @param nac P25 NAC.
+     * @param duid P25 DUID.
+     * @param length Length of the data unit in bytes.
+     */
+    void appendP25(uint16_t nac, uint8_t duid, uint32_t length);
+    /**
+     * @brief Appends a NXDN data channel frame.
+     * @param fct Functional Channel Type of the frame LICH.
+     */
+    void appendNXDN(uint8_t fct);
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Records the frames written by the modem to the host, as text lines, for golden comparison.
+ * @details Each line contains the command byte followed by the frame payload in hex.
+ * @ingroup host_sim
+ */
+class DSP_FW_API HostFrameLog {
+public:
+    /**
+     * @brief Initializes a new instance of the HostFrameLog class.
+     */
+    HostFrameLog();
+    /**
+     * @brief Finalizes a instance of the HostFrameLog class.
+     */
+    ~HostFrameLog();
+
+    /**
+     * @brief Clears the log.
+     */
+    void clear();
+
+    /**
+     * @brief Records a frame.
+     * @param cmd Command byte of the frame.
+     * @param data Frame payload.
+     * @param length Length of the frame payload.
+     */
+    void add(uint8_t cmd, const uint8_t* data, uint16_t length);
+
+    /**
+     * @brief Gets the number of frames recorded.
+     * @returns uint32_t Number of frames recorded.
+     */
+    uint32_t getCount() const { return m_count; }
+
+    /**
+     * @brief Saves the log as a golden file.
+     * @param fileName Golden file to write.
+     * @param state Modem state the frames were recorded in.
+     * @returns bool True, if the log was saved, otherwise false.
+     */
+    bool save(const char* fileName, DVM_STATE state) const;
+    /**
+     * @brief Compares the log against a golden file.
+     * @param fileName Golden file to compare against.
+     * @param verbose Flag indicating the first mismatch is displayed.
+     * @returns int32_t Index of the first mismatching frame; -1 if the log matches, -2 on error.
+     */
+    int32_t compare(const char* fileName, bool verbose) const;
+    /**
+     * @brief Compares the log against another log.
+     * @param log Log to compare against.
+     * @returns int32_t Index of the first mismatching frame; -1 if the logs match.
+     */
+    int32_t compare(const HostFrameLog& log) const;
+
+private:
+    char* m_text;
+    uint32_t m_length;
+    uint32_t m_capacity;
+    uint32_t m_count;
+
+    /**
+     * @brief Helper to get the line starting at the given offset.
+     * @param offset Offset of the line in the log.
+     * @param[out] length Length of the line (excluding the line terminator).
+     * @returns const char* Start of the line; NULL if there are no more lines.
+     */
+    const char* nextLine(uint32_t offset, uint32_t& length) const;
+};
+
+#endif // HOST_SIM
+#endif // __HOST_REPLAY_H__
@@ -0,0 +1,412 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "host/HostSim.h"
+
+#if defined(HOST_SIM)
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t HOST_STREAM_MASK = HOST_STREAM_SIZE - 1U;
+
+const uint32_t HOST_FNV_BASIS = 0x811C9DC5U;
+const uint32_t HOST_FNV_PRIME = 0x01000193U;
+
+// ---------------------------------------------------------------------------
+//  Globals
+// ---------------------------------------------------------------------------
+
+HostSim hostSim;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the HostStream class. */
+
+HostStream::HostStream() :
+    m_buffer(),
+    m_head(0U),
+    m_tail(0U),
+    m_lost(0U)
+{
+    /* stub */
+}
+
+/* Clears the stream. */
+
+void HostStream::reset()
+{
+    m_head = 0U;
+    m_tail = 0U;
+    m_lost = 0U;
+}
+
+/* Helper to get how much data is in the stream. */
+
+uint32_t HostStream::getData() const
+{
+    return m_head - m_tail;
+}
+
+/* Helper to get how much space the stream has for data. */
+
+uint32_t HostStream::getSpace() const
+{
+    return HOST_STREAM_SIZE - getData();
+}
+
+/* Writes bytes to the stream. */
+
+uint32_t HostStream::write(const uint8_t* data, uint32_t length)
+{
+    uint32_t space = getSpace();
+    if (length > space) {
+        m_lost += length - space;
+        length = space;
+    }
+
+    for (uint32_t i = 0U; i < length; i++)
+        m_buffer[(m_head + i) & HOST_STREAM_MASK] = data[i];
+    m_head += length;
+
+    return length;
+}
+
+/* Reads a byte from the stream. */
+
+uint8_t HostStream::read()
+{
+    if (m_head == m_tail)
+        return 0U;
+
+    uint8_t c = m_buffer[m_tail & HOST_STREAM_MASK];
+    m_tail++;
+
+    return c;
+}
+
+/* Reads a byte from the stream without removing it. */
+
+uint8_t HostStream::peek(uint32_t offset) const
+{
+    if (offset >= getData())
+        return 0U;
+
+    return m_buffer[(m_tail + offset) & HOST_STREAM_MASK];
+}
+
+/* Gets the bytes that can be read without wrapping, leaving them in the stream. */
+
+uint32_t HostStream::peek(const uint8_t** data) const
+{
+    uint32_t tail = m_tail & HOST_STREAM_MASK;
+    uint32_t length = getData();
+    if (length > HOST_STREAM_SIZE - tail)
+        length = HOST_STREAM_SIZE - tail;
+
+    *data = m_buffer + tail;
+    return length;
+}
+
+/* Discards bytes from the stream. */
+
+void HostStream::skip(uint32_t length)
+{
+    if (length > getData())
+        length = getData();
+
+    m_tail += length;
+}
+
+/* Initializes a new instance of the HostSim class. */
+
+HostSim::HostSim() :
+    m_clk(false),
+    m_inInterrupt(false),
+    m_bitClock(0U),
+    m_rxBits(NULL),
+    m_rxLength(0U),
+    m_rxPtr(0U),
+    m_rxLoop(true),
+    m_rxSeed(0x12345678U),
+    m_rxd(false),
+    m_txBits(0U),
+    m_txHash(HOST_FNV_BASIS),
+    m_txCapture(NULL),
+    m_txCaptureLength(0U),
+    m_txBase(0U),
+    m_txFirst(0U),
+    m_txCaptured(false),
+    m_ptt(false),
+    m_modemRX(),
+    m_modemTX(),
+    m_flash(),
+    m_resetRequested(false)
+{
+    ::memset(m_flash, 0xFFU, HOST_FLASH_SIZE);
+}
+
+/* Resets the simulated hardware state. */
+
+void HostSim::reset()
+{
+    m_clk = false;
+    m_inInterrupt = false;
+    m_bitClock = 0U;
+
+    m_rxPtr = 0U;
+    m_rxSeed = 0x12345678U;
+    m_rxd = false;
+
+    m_txBits = 0U;
+    m_txHash = HOST_FNV_BASIS;
+    m_txCapture = NULL;
+    m_ptt = false;
+
+    m_modemRX.reset();
+    m_modemTX.reset();
+
+    m_resetRequested = false;
+}
+
+/* Toggles the virtual symbol clock and runs the hardware interrupt handlers. */
+
+void HostSim::clockEdge()
+{
+    m_clk = !m_clk;
+
+    // the demodulator presents the next bit on the rising edge of the clock
+    if (m_clk) {
+        if (m_rxBits == NULL) {
+            // xorshift32
+            m_rxSeed ^= m_rxSeed << 13;
+            m_rxSeed ^= m_rxSeed >> 17;
+            m_rxSeed ^= m_rxSeed << 5;
+            m_rxd = (m_rxSeed & 0x01U) == 0x01U;
+        }
+        else {
+            if (m_rxPtr >= m_rxLength && m_rxLoop)
+                m_rxPtr = 0U;
+
+            if (m_rxPtr < m_rxLength) {
+                m_rxd = _READ_BIT(m_rxBits, m_rxPtr) == 1U;
+                m_rxPtr++;
+            }
+            else {
+                m_rxd = false;
+            }
+        }
+
+        m_bitClock++;
+    }
+
+    m_inInterrupt = true;
+
+    io.interrupt1();
+#if defined(DUPLEX)
+    if (m_clk)
+        io.interrupt2();
+#endif
+
+    m_inInterrupt = false;
+}
+
+/* Runs one full bit period (a rising and a falling edge) of the virtual symbol clock. */
+
+void HostSim::clockBit()
+{
+    clockEdge();
+    clockEdge();
+}
+
+/* Sets the bit stream presented on the RXD pin. */
+
+void HostSim::setRXSource(const uint8_t* bits, uint32_t length, bool loop)
+{
+    m_rxBits = bits;
+    m_rxLength = length;
+    m_rxPtr = 0U;
+    m_rxLoop = loop;
+}
+
+/* Flag indicating the RX bit stream has been exhausted. */
+
+bool HostSim::isRXDone() const
+{
+    if (m_rxBits == NULL || m_rxLoop)
+        return false;
+
+    return m_rxPtr >= m_rxLength;
+}
+
+/* Sets the level of the TXD pin. */
+
+void HostSim::setTXD(bool on)
+{
+    m_txBits++;
+    m_txHash = (m_txHash ^ (on ? 1U : 0U)) * HOST_FNV_PRIME;
+
+    // the bit is sent in the bit period the clock has just counted
+    if (m_txCapture != NULL) {
+        uint32_t n = io.getClock() - m_txBase;
+        if (n < m_txCaptureLength) {
+            _WRITE_BIT(m_txCapture, n, on);
+            if (!m_txCaptured) {
+                m_txCaptured = true;
+                m_txFirst = io.getClock();
+            }
+        }
+    }
+}
+
+/* Sets the buffer the bits clocked out of the TXD pin are captured into. */
+
+void HostSim::setTXCapture(uint8_t* bits, uint32_t length)
+{
+    m_txCapture = bits;
+    m_txCaptureLength = length;
+    m_txBase = io.getClock();
+    m_txCaptured = false;
+}
+
+/* Writes bytes from the host to the modem. */
+
+void HostSim::hostWrite(const uint8_t* data, uint16_t length)
+{
+    m_modemRX.write(data, length);
+}
+
+/* Reads a complete frame written by the modem to the host. */
+
+bool HostSim::hostReadFrame(uint8_t* buffer, uint16_t& length)
+{
+    // resynchronize to the start of a frame
+    while (m_modemTX.getData() > 0U) {
+        uint8_t c = m_modemTX.peek(0U);
+        if (c == DVM_SHORT_FRAME_START || c == DVM_LONG_FRAME_START)
+            break;
+
+        m_modemTX.skip(1U);
+    }
+
+    if (m_modemTX.getData() < 3U)
+        return false;
+
+    uint16_t frameLength = m_modemTX.peek(1U);
+    if (m_modemTX.peek(0U) == DVM_LONG_FRAME_START)
+        frameLength = (m_modemTX.peek(1U) << 8) + m_modemTX.peek(2U);
+
+    if (frameLength < 3U) {
+        m_modemTX.skip(1U);
+        return false;
+    }
+
+    if (m_modemTX.getData() < frameLength)
+        return false;
+
+    uint16_t n = (frameLength > length) ? length : frameLength;
+    for (uint16_t i = 0U; i < n; i++)
+        buffer[i] = m_modemTX.peek(i);
+
+    m_modemTX.skip(frameLength);
+    length = n;
+
+    return true;
+}
+
+/* Writes the modem configuration for the given modem state from the host to the modem. */
+
+void HostSim::hostSetConfig(DVM_STATE state, uint8_t colorCode, uint16_t nac, bool debug)
+{
+    uint8_t buffer[20U];
+    ::memset(buffer, 0x00U, 20U);
+
+    buffer[0U] = DVM_SHORT_FRAME_START;
+    buffer[1U] = 20U;
+    buffer[2U] = CMD_SET_CONFIG;
+
+    uint8_t* data = buffer + 3U;
+    data[0U] = 0x80U;                                   // simplex
+    if (debug)
+        data[0U] |= 0x10U;
+    switch (state) {
+    case STATE_DMR:
+        data[1U] = 0x02U;
+        break;
+    case STATE_P25:
+        data[1U] = 0x08U;
+        break;
+    case STATE_NXDN:
+        data[1U] = 0x10U;
+        break;
+    default:
+        break;
+    }
+    data[2U] = 8U;                                      // FDMA preamble
+    data[3U] = uint8_t(state);
+    data[5U] = 50U << 2;                                // CW Id TX level
+    data[6U] = colorCode;
+    data[8U] = (nac >> 4) & 0xFFU;
+    data[9U] = (nac << 4) & 0xF0U;
+    data[10U] = 50U;                                    // DMR TX level
+    data[12U] = 50U;                                    // P25 TX level
+    data[15U] = 50U;                                    // NXDN TX level
+
+    hostWrite(buffer, 20U);
+}
+
+/* Writes a receive allow list from the host to the modem. */
+
+void HostSim::hostSetAllowList(uint8_t type, const uint8_t* data, uint8_t length)
+{
+    uint8_t buffer[255U];
+    if (length > 251U)
+        length = 251U;
+
+    buffer[0U] = DVM_SHORT_FRAME_START;
+    buffer[1U] = length + 4U;
+    buffer[2U] = CMD_SET_ALLOW_LIST;
+    buffer[3U] = type;
+    ::memcpy(buffer + 4U, data, length);
+
+    hostWrite(buffer, length + 4U);
+}
+
+/* Writes the batch flush deadline from the host to the modem. */
+
+void HostSim::hostSetBatch(uint8_t timeout)
+{
+    uint8_t buffer[4U];
+    buffer[0U] = DVM_SHORT_FRAME_START;
+    buffer[1U] = 4U;
+    buffer[2U] = CMD_SET_BATCH;
+    buffer[3U] = timeout;
+
+    hostWrite(buffer, 4U);
+}
+
+/* Writes the TX credit reporting from the host to the modem. */
+
+void HostSim::hostSetCredits(bool ack, uint8_t interval)
+{
+    uint8_t buffer[5U];
+    buffer[0U] = DVM_SHORT_FRAME_START;
+    buffer[1U] = 5U;
+    buffer[2U] = CMD_SET_CREDITS;
+    buffer[3U] = ack ? 0x01U : 0x00U;
+    buffer[4U] = interval;
+
+    hostWrite(buffer, 5U);
+}
+
+#endif // HOST_SIM
@@ -0,0 +1,335 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @defgroup host_sim Host Simulator
+ * @brief Digital Voice Modem - Hotspot Firmware Host Simulator
+ * @details Simulated air interface and serial backend used to run the modem core natively on a host.
+ * @ingroup hotspot_fw
+ *
+ * @file HostSim.h
+ * @ingroup host_sim
+ * @file HostSim.cpp
+ * @ingroup host_sim
+ */
+#if !defined(__HOST_SIM_H__)
+#define __HOST_SIM_H__
+
+#if defined(HOST_SIM)
+
+#include "Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup host_sim
+ * @{
+ */
+
+/** @brief Size of the simulated serial streams (needs to be a power of 2!). */
+const uint32_t HOST_STREAM_SIZE = 65536U;
+/** @brief Size of the simulated configuration flash page. */
+const uint16_t HOST_FLASH_SIZE = 1024U;
+/** @brief Length of the longest frame the modem writes to the host (a P25 PDU, with its RSSI and timestamp). */
+const uint16_t HOST_FRAME_LEN = 524U;
+/** @} */
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a simple byte FIFO used for the simulated serial streams.
+ * @ingroup host_sim
+ */
+class DSP_FW_API HostStream {
+public:
+    /**
+     * @brief Initializes a new instance of the HostStream class.
+     */
+    HostStream();
+
+    /**
+     * @brief Clears the stream.
+     */
+    void reset();
+
+    /**
+     * @brief Helper to get how much data is in the stream.
+     * @returns uint32_t Number of bytes in the stream.
+     */
+    uint32_t getData() const;
+    /**
+     * @brief Helper to get how much space the stream has for data.
+     * @returns uint32_t Number of bytes that can be written to the stream.
+     */
+    uint32_t getSpace() const;
+
+    /**
+     * @brief Writes bytes to the stream.
+     * @param data Data to write.
+     * @param length Length of data to write.
+     * @returns uint32_t Number of bytes written to the stream.
+     */
+    uint32_t write(const uint8_t* data, uint32_t length);
+    /**
+     * @brief Reads a byte from the stream.
+     * @returns uint8_t Byte read from the stream.
+     */
+    uint8_t read();
+    /**
+     * @brief Reads a byte from the stream without removing it.
+     * @param offset Offset from the start of the stream.
+     * @returns uint8_t Byte at the given offset.
+     */
+    uint8_t peek(uint32_t offset) const;
+    /**
+     * @brief Gets the bytes that can be read without wrapping, leaving them in the stream.
+     * @param[out] data Pointer to the first unread byte.
+     * @returns uint32_t Number of contiguous unread bytes.
+     */
+    uint32_t peek(const uint8_t** data) const;
+    /**
+     * @brief Discards bytes from the stream.
+     * @param length Number of bytes to discard.
+     */
+    void skip(uint32_t length);
+
+    /**
+     * @brief Gets the number of bytes lost due to the stream being full.
+     * @returns uint32_t Number of bytes lost.
+     */
+    uint32_t getLost() const { return m_lost; }
+    /**
+     * @brief Gets the free running count of bytes written to the stream.
+     * @returns uint32_t Number of bytes written.
+     */
+    uint32_t getWritten() const { return m_head; }
+    /**
+     * @brief Gets the free running count of bytes read (or discarded) from the stream.
+     * @returns uint32_t Number of bytes read.
+     */
+    uint32_t getRead() const { return m_tail; }
+
+private:
+    uint8_t m_buffer[HOST_STREAM_SIZE];
+
+    uint32_t m_head;
+    uint32_t m_tail;
+
+    uint32_t m_lost;
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements the simulated ADF7021 air interface and host serial port.
+ * @ingroup host_sim
+ */
+class DSP_FW_API HostSim {
+public:
+    /**
+     * @brief Initializes a new instance of the HostSim class.
+     */
+    HostSim();
+
+    /**
+     * @brief Resets the simulated hardware state.
+     */
+    void reset();
+
+    /**
+     * @brief Toggles the virtual symbol clock and runs the hardware interrupt handlers.
+     */
+    void clockEdge();
+    /**
+     * @brief Runs one full bit period (a rising and a falling edge) of the virtual symbol clock.
+     */
+    void clockBit();
+    /**
+     * @brief Gets the current level of the virtual symbol clock.
+     * @returns bool Level of the symbol clock.
+     */
+    bool getCLK() const { return m_clk; }
+    /**
+     * @brief Flag indicating the hardware interrupt handlers are running.
+     * @returns bool True, if a simulated interrupt is in progress.
+     */
+    bool inInterrupt() const { return m_inInterrupt; }
+    /**
+     * @brief Gets the number of bit periods elapsed on the virtual symbol clock.
+     * @returns uint64_t Number of bit periods elapsed.
+     */
+    uint64_t getBitClock() const { return m_bitClock; }
+
+    /**
+     * @brief Sets the bit stream presented on the RXD pin.
+     * @param bits Packed (MSB first) bit stream; NULL for pseudo-random bits.
+     * @param length Length of the bit stream in bits.
+     * @param loop Flag indicating the bit stream restarts once exhausted.
+     */
+    void setRXSource(const uint8_t* bits, uint32_t length, bool loop);
+    /**
+     * @brief Flag indicating the RX bit stream has been exhausted.
+     * @returns bool True, if there are no more bits to present on the RXD pin.
+     */
+    bool isRXDone() const;
+    /**
+     * @brief Gets the current level of the RXD pin.
+     * @returns bool Level of the RXD pin.
+     */
+    bool getRXD() const { return m_rxd; }
+
+    /**
+     * @brief Sets the level of the TXD pin.
+     * @param on Level of the TXD pin.
+     */
+    void setTXD(bool on);
+    /**
+     * @brief Gets the number of bits clocked out of the TXD pin.
+     * @returns uint64_t Number of bits transmitted.
+     */
+    uint64_t getTXBits() const { return m_txBits; }
+    /**
+     * @brief Gets the FNV-1a hash of the bits clocked out of the TXD pin.
+     * @returns uint32_t Hash of the bits transmitted.
+     */
+    uint32_t getTXHash() const { return m_txHash; }
+    /**
+     * @brief Sets the buffer the bits clocked out of the TXD pin are captured into, each at the bit it is
+     *  sent at from the current bit clock (see IO::getClock()) on.
+     * @param[out] bits Buffer for the packed (MSB first) bits, cleared by the caller; NULL to stop capturing.
+     * @param length Length of the buffer in bits.
+     */
+    void setTXCapture(uint8_t* bits, uint32_t length);
+    /**
+     * @brief Gets the bit clock of the first bit captured from the TXD pin.
+     * @param[out] clock Bit clock the first bit captured was sent at.
+     * @returns bool True, if a bit was captured.
+     */
+    bool getTXFirst(uint32_t& clock) const { clock = m_txFirst; return m_txCaptured; }
+    /**
+     * @brief Sets the PTT state.
+     * @param on PTT state.
+     */
+    void setPTT(bool on) { m_ptt = on; }
+    /**
+     * @brief Gets the PTT state.
+     * @returns bool PTT state.
+     */
+    bool getPTT() const { return m_ptt; }
+
+    /**
+     * @brief Writes bytes from the host to the modem.
+     * @param data Data to write.
+     * @param length Length of data to write.
+     */
+    void hostWrite(const uint8_t* data, uint16_t length);
+    /**
+     * @brief Reads a complete frame written by the modem to the host.
+     * @param[out] buffer Buffer to read the frame into.
+     * @param[in,out] length Length of the buffer; length of the frame read.
+     * @returns bool True, if a complete frame was read.
+     */
+    bool hostReadFrame(uint8_t* buffer, uint16_t& length);
+    /**
+     * @brief Writes the modem configuration for the given modem state from the host to the modem.
+     * @param state Modem state.
+     * @param colorCode DMR color code.
+     * @param nac P25 NAC.
+     * @param debug Flag indicating modem debug messages are enabled.
+     */
+    void hostSetConfig(DVM_STATE state, uint8_t colorCode, uint16_t nac, bool debug);
+    /**
+     * @brief Writes a receive allow list from the host to the modem.
+     * @param type Allow list type (0 for a DMR color code bitmask, 1 for a list of P25 NACs).
+     * @param[in] data Allow list.
+     * @param length Length of the allow list.
+     */
+    void hostSetAllowList(uint8_t type, const uint8_t* data, uint8_t length);
+    /**
+     * @brief Writes the batch flush deadline from the host to the modem.
+     * @param timeout Time received frames may be held back to be batched together, in milliseconds (0 for off).
+     */
+    void hostSetBatch(uint8_t timeout);
+    /**
+     * @brief Writes the TX credit reporting from the host to the modem.
+     * @param ack Flag indicating acknowlegements carry the TX FIFO credits.
+     * @param interval Minimum time between TX credit events, in milliseconds (0 for no events).
+     */
+    void hostSetCredits(bool ack, uint8_t interval);
+
+    /**
+     * @brief Gets the stream of bytes from the host to the modem.
+     * @returns HostStream& Host to modem stream.
+     */
+    HostStream& getModemRX() { return m_modemRX; }
+    /**
+     * @brief Gets the stream of bytes from the modem to the host.
+     * @returns HostStream& Modem to host stream.
+     */
+    HostStream& getModemTX() { return m_modemTX; }
+
+    /**
+     * @brief Gets the simulated configuration flash page.
+     * @returns uint8_t* Configuration flash page.
+     */
+    uint8_t* getFlash() { return m_flash; }
+
+    /**
+     * @brief Requests the simulated MCU reset.
+     */
+    void requestReset() { m_resetRequested = true; }
+    /**
+     * @brief Flag indicating a MCU reset was requested.
+     * @returns bool True, if the firmware requested a MCU reset.
+     */
+    bool isResetRequested() const { return m_resetRequested; }
+
+private:
+    bool m_clk;
+    volatile bool m_inInterrupt;
+    uint64_t m_bitClock;
+
+    const uint8_t* m_rxBits;
+    uint32_t m_rxLength;
+    uint32_t m_rxPtr;
+    bool m_rxLoop;
+    uint32_t m_rxSeed;
+    bool m_rxd;
+
+    uint64_t m_txBits;
+    uint32_t m_txHash;
+    uint8_t* m_txCapture;
+    uint32_t m_txCaptureLength;
+    uint32_t m_txBase;
+    uint32_t m_txFirst;
+    bool m_txCaptured;
+    bool m_ptt;
+
+    HostStream m_modemRX;
+    HostStream m_modemTX;
+
+    uint8_t m_flash[HOST_FLASH_SIZE];
+
+    bool m_resetRequested;
+};
+
+// ---------------------------------------------------------------------------
+//  Global Externs
+// ---------------------------------------------------------------------------
+
+extern HostSim hostSim;
+
+#endif // HOST_SIM
+#endif // __HOST_SIM_H__
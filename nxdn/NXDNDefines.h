@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016,2017,2018 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -49,6 +50,24 @@ namespace nxdn
     const uint32_t  NXDN_FSW_BITS = 0x000CDF59U;
     const uint32_t  NXDN_FSW_BITS_MASK = 0x000FFFFFU;
 
+    // link information channel; 8 bits, each sent as the first bit of a symbol (the second bit is always set)
+    const uint32_t  NXDN_LICH_LENGTH_BITS = 16U;
+
+    const uint8_t   NXDN_LICH_RFCT_RCCH = 0U;           // Control Channel
+    const uint8_t   NXDN_LICH_RFCT_RTCH = 1U;           // Traffic Channel
+    const uint8_t   NXDN_LICH_RFCT_RDCH = 2U;           // Data Channel
+    const uint8_t   NXDN_LICH_RFCT_RTCH_C = 3U;         // Composite Control/Traffic Channel
+
+    const uint8_t   NXDN_LICH_USC_SACCH_NS = 0U;        // SACCH (Non-Superframe)
+    const uint8_t   NXDN_LICH_USC_UDCH = 1U;            // UDCH
+    const uint8_t   NXDN_LICH_USC_SACCH_SS = 2U;        // SACCH (Superframe)
+    const uint8_t   NXDN_LICH_USC_SACCH_SS_IDLE = 3U;   // SACCH (Superframe/Idle)
+
+    // flags of the header byte of a NXDN frame sent to the host
+    const uint8_t   NXDN_FRAME_FLAG_SYNC = 0x01U;       // Frame sync was found for this frame
+    const uint8_t   NXDN_FRAME_FLAG_IDLE = 0x40U;       // LICH marks the frame idle
+    const uint8_t   NXDN_FRAME_FLAG_LICH_ERR = 0x80U;   // LICH failed its parity check
+
     const uint8_t   NXDN_PREAMBLE[] = { 0x57U, 0x75U, 0xFDU };
     const uint8_t   NXDN_SYNC = 0x5FU;
 
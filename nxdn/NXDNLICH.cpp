@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "nxdn/NXDNLICH.h"
+
+using namespace nxdn;
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// the frame is scrambled after the frame sync word (PN9, x^9 + x^4 + 1, seeded with 0x0E4; a set PN bit inverts
+// the polarity of a symbol, i.e. its first bit), these are the PN bits of the 8 LICH symbols
+const uint8_t LICH_SCRAMBLE_MASK = 0x27U;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the NXDNLICH class. */
+
+NXDNLICH::NXDNLICH() :
+    m_lich(0U)
+{
+    /* stub */
+}
+
+/* Decodes the NXDN LICH. */
+
+bool NXDNLICH::decode(const uint8_t* frame)
+{
+    uint8_t lich = 0U;
+    for (uint8_t i = 0U; i < NXDN_LICH_LENGTH_BITS; i += 2U)
+        lich = (lich << 1) | _READ_BIT(frame, NXDN_FSW_LENGTH_BITS + i);
+
+    m_lich = lich ^ LICH_SCRAMBLE_MASK;
+    return (m_lich & 0x01U) == getParity();
+}
+
+#if defined(HOST_SIM)
+/* Encodes the NXDN LICH. */
+
+void NXDNLICH::encode(uint8_t rfct, uint8_t fct, uint8_t option, bool outbound, uint8_t* frame)
+{
+    m_lich = ((rfct & 0x03U) << 6) | ((fct & 0x03U) << 4) | ((option & 0x03U) << 2) | (outbound ? 0x02U : 0x00U);
+    m_lich |= getParity();
+
+    uint8_t lich = m_lich ^ LICH_SCRAMBLE_MASK;
+    for (uint8_t i = 0U; i < NXDN_LICH_LENGTH_BITS; i += 2U) {
+        _WRITE_BIT(frame, NXDN_FSW_LENGTH_BITS + i, (lich & 0x80U) == 0x80U);
+        _WRITE_BIT(frame, NXDN_FSW_LENGTH_BITS + i + 1U, true);
+        lich <<= 1;
+    }
+}
+#endif
+
+/* Gets the flag indicating the frame is idle. */
+
+bool NXDNLICH::isIdle() const
+{
+    return getRFCT() != NXDN_LICH_RFCT_RCCH && getFCT() == NXDN_LICH_USC_SACCH_SS_IDLE;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Gets the parity bit expected for the LICH. */
+
+uint8_t NXDNLICH::getParity() const
+{
+    // matches the parity the host checks (and generates)
+    switch (m_lich & 0xF0U) {
+    case 0x80U:
+    case 0xB0U:
+        return 0x01U;
+    default:
+        return 0x00U;
+    }
+}
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file NXDNLICH.h
+ * @ingroup nxdn_hfw
+ * @file NXDNLICH.cpp
+ * @ingroup nxdn_hfw
+ */
+#if !defined(__NXDN_LICH_H__)
+#define __NXDN_LICH_H__
+
+#include "Defines.h"
+#include "nxdn/NXDNDefines.h"
+
+namespace nxdn
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the NXDN link information channel (LICH); the RF channel type, functional channel type,
+     *  option and direction of a frame, and a parity bit.
+     * @ingroup nxdn_hfw
+     */
+    class DSP_FW_API NXDNLICH {
+    public:
+        /**
+         * @brief Initializes a new instance of the NXDNLICH class.
+         */
+        NXDNLICH();
+
+        /**
+         * @brief Decodes the NXDN LICH.
+         * @param[in] frame NXDN frame (starting with the frame sync word, scrambled as received).
+         * @returns bool True, if the LICH parity is valid, otherwise false.
+         */
+        bool decode(const uint8_t* frame);
+#if defined(HOST_SIM)
+        /**
+         * @brief Encodes the NXDN LICH.
+         * @param rfct RF Channel Type.
+         * @param fct Functional Channel Type.
+         * @param option Channel Options.
+         * @param outbound Flag indicating the frame is outbound.
+         * @param[out] frame NXDN frame (starting with the frame sync word, scrambled as sent).
+         */
+        void encode(uint8_t rfct, uint8_t fct, uint8_t option, bool outbound, uint8_t* frame);
+#endif
+
+        /**
+         * @brief Gets the RF Channel Type.
+         * @returns uint8_t RF Channel Type.
+         */
+        uint8_t getRFCT() const { return (m_lich >> 6) & 0x03U; }
+        /**
+         * @brief Gets the Functional Channel Type.
+         * @returns uint8_t Functional Channel Type.
+         */
+        uint8_t getFCT() const { return (m_lich >> 4) & 0x03U; }
+        /**
+         * @brief Gets the Channel Options.
+         * @returns uint8_t Channel Options.
+         */
+        uint8_t getOption() const { return (m_lich >> 2) & 0x03U; }
+        /**
+         * @brief Gets the flag indicating the frame is outbound.
+         * @returns bool True, if the frame is outbound, otherwise false.
+         */
+        bool getOutbound() const { return (m_lich & 0x02U) == 0x02U; }
+
+        /**
+         * @brief Gets the flag indicating the frame is idle; a traffic or data channel frame carrying the idle
+         *  superframe SACCH.
+         * @returns bool True, if the frame is idle, otherwise false.
+         */
+        bool isIdle() const;
+
+    private:
+        uint8_t m_lich;
+
+        /**
+         * @brief Gets the parity bit expected for the LICH.
+         * @returns uint8_t Parity bit.
+         */
+        uint8_t getParity() const;
+    };
+} // namespace nxdn
+
+#endif // __NXDN_LICH_H__
@@ -10,6 +10,7 @@
  */
 #include "Globals.h"
 #include "nxdn/NXDNRX.h"
+#include "nxdn/NXDNLICH.h"
 #include "Utils.h"
 
 using namespace nxdn;
@@ -37,9 +38,10 @@ NXDNRX::NXDNRX() :
     m_buffer(NULL),
     m_dataPtr(0U),
     m_lostCount(0U),
-    m_state(NXDNRXS_NONE)
+    m_state(NXDNRXS_NONE),
+    m_filtered(0U)
 {
-    ::memset(m_outBuffer, 0x00U, NXDN_FRAME_LENGTH_BYTES + 3U);
+    ::memset(m_outBuffer, 0x00U, NXDN_FRAME_LENGTH_BYTES + 7U);
     m_buffer = m_outBuffer + 1U;
 }
 
@@ -59,6 +61,8 @@ void NXDNRX::reset()
 
 void NXDNRX::databit(bool bit)
 {
+    PROFILE_SCOPE(PROBE_NXDN_RX_DATABIT);
+
     if (m_state == NXDNRXS_DATA) {
         processData(bit);
     }
@@ -116,10 +120,40 @@ void NXDNRX::processData(bool bit)
             reset();
         }
         else {
-            m_outBuffer[0U] = m_lostCount == (MAX_FSW_FRAMES - 1U) ? 0x01U : 0x00U; // set sync flag
-            serial.writeNXDNData(m_outBuffer, NXDN_FRAME_LENGTH_BYTES + 1U);
-
-            ::memset(m_outBuffer, 0x00U, NXDN_FRAME_LENGTH_BYTES + 3U);
+            m_outBuffer[0U] = m_lostCount == (MAX_FSW_FRAMES - 1U) ? NXDN_FRAME_FLAG_SYNC : 0x00U; // set sync flag
+
+            // classify the frame by its LICH
+            NXDNLICH lich;
+            bool valid = lich.decode(m_buffer);
+            if (!valid) {
+                DEBUG1("NXDNRX::processData() LICH parity error");
+                m_outBuffer[0U] |= NXDN_FRAME_FLAG_LICH_ERR;
+            }
+            else if (lich.isIdle()) {
+                m_outBuffer[0U] |= NXDN_FRAME_FLAG_IDLE;
+            }
+
+            bool drop = false;
+#if defined(NXDN_DROP_LICH_ERRORS)
+            drop |= !valid;
+#endif
+#if defined(NXDN_DROP_IDLE)
+            drop |= valid && lich.isIdle();
+#endif
+            if (!drop) {
+                uint8_t length = NXDN_FRAME_LENGTH_BYTES + 1U;
+#if defined(SEND_RX_TIMESTAMP)
+                // the frame is written as its last bit is received
+                io.getRXTimestamp(NXDN_FRAME_LENGTH_BITS, m_outBuffer + length);
+                length += 4U;
+#endif
+                serial.writeNXDNData(m_outBuffer, length);
+            }
+            else {
+                m_filtered++;
+            }
+
+            ::memset(m_outBuffer, 0x00U, NXDN_FRAME_LENGTH_BYTES + 7U);
             m_dataPtr = 0U;
         }
     }
@@ -129,6 +163,8 @@ void NXDNRX::processData(bool bit)
 
 bool NXDNRX::correlateSync(bool first)
 {
+    PROFILE_SCOPE(PROBE_NXDN_RX_SYNC);
+
     uint8_t maxErrs;
     if (m_state == NXDNRXS_NONE)
         maxErrs = MAX_FSW_BIT_START_ERRS;
@@ -155,6 +191,7 @@ bool NXDNRX::correlateSync(bool first)
 
         m_lostCount = MAX_FSW_FRAMES;
         m_dataPtr = NXDN_FSW_LENGTH_BITS;
+        TRACE_SYNC();
 
         DEBUG2("NXDNRX::correlateSync() dataPtr", m_dataPtr - NXDN_FSW_LENGTH_BITS);
 
@@ -61,9 +61,15 @@ namespace nxdn
          */
         void databit(bool bit);
 
+        /**
+         * @brief Gets the number of frames dropped by their LICH (see NXDN_DROP_LICH_ERRORS and NXDN_DROP_IDLE).
+         * @returns uint32_t Number of frames dropped.
+         */
+        uint32_t getFiltered() const { return m_filtered; }
+
     private:
         uint64_t m_bitBuffer;
-        uint8_t m_outBuffer[NXDN_FRAME_LENGTH_BYTES + 3U];
+        uint8_t m_outBuffer[NXDN_FRAME_LENGTH_BYTES + 7U];
         uint8_t* m_buffer;
 
         uint16_t m_dataPtr;
@@ -72,6 +78,8 @@ namespace nxdn
 
         NXDNRX_STATE m_state;
 
+        uint32_t m_filtered;
+
         /**
          * @brief Helper to process NXDN data bits.
          * @param bit 
@@ -29,7 +29,8 @@ NXDNTX::NXDNTX() :
     m_poPtr(0U),
     m_preambleCnt(240U), // 200ms
     m_txHang(3000U),     // 5s
-    m_tailCnt(0U)
+    m_tailCnt(0U),
+    m_schedule(CMD_NXDN_DATA)
 {
     /* stub */
 }
@@ -38,25 +39,34 @@ NXDNTX::NXDNTX() :
 
 void NXDNTX::process()
 {
-    if (m_fifo.getData() == 0U && m_poLen == 0U && m_tailCnt > 0U &&
+    PROFILE_SCOPE(PROBE_NXDN_TX_PROCESS);
+
+    // as with P25, a frame with a launch time beyond the hang doesn't keep the transmitter keyed
+    bool waiting = m_fifo.getData() > 0U && m_schedule.isWaiting(m_tailCnt * 4U + (m_preambleCnt + 3U) * 8U);
+    if ((m_fifo.getData() == 0U || waiting) && m_poLen == 0U && m_tailCnt > 0U &&
         m_state != NXDNTXSTATE_CAL) {
         // transmit silence until the hang timer has expired
         uint16_t space = io.getSpace();
+        uint16_t count = 0U;
 
         while (space > 8U) {
-            writeSilence();
+            count++;
 
             space -= 8U;
             m_tailCnt--;
 
             if (m_tailCnt == 0U)
-                return;
-            if (m_fifo.getData() > 0U) {
+                break;
+            if (m_fifo.getData() > 0U && !waiting) {
                 m_tailCnt = 0U;
-                return;
+                break;
             }
         }
 
+        writeSilence(count);
+        if (m_tailCnt == 0U)
+            return;
+
         if (m_fifo.getData() == 0U && m_poLen == 0U)
             return;
     }
@@ -68,25 +78,32 @@ void NXDNTX::process()
         if (m_fifo.getData() == 0U)
             return;
 
+        // as with P25, hold a frame with a launch time (the preamble here includes the 3 NXDN preamble bytes)
+        if (!m_tx && m_schedule.isWaiting((m_preambleCnt + 3U) * 8U))
+            return;
+        if (m_tx && m_schedule.hold(0x00U, m_tailCnt * 4U + (m_preambleCnt + 3U) * 8U))
+            return;
+
         createData();
     }
 
     if (m_poLen > 0U) {
         uint16_t space = io.getSpace();
+        if (space <= 8U)
+            return;
 
-        while (space > 8U) {
-            uint8_t c = m_poBuffer[m_poPtr++];
+        // write as many whole bytes as fit in one go
+        uint16_t count = (space - 1U) / 8U;
+        if (count > m_poLen - m_poPtr)
+            count = m_poLen - m_poPtr;
 
-            writeByte(c);
+        io.writeBytes(m_poBuffer + m_poPtr, count);
+        m_poPtr += count;
+        m_tailCnt = m_txHang;
 
-            space -= 8U;
-            m_tailCnt = m_txHang;
-
-            if (m_poPtr >= m_poLen) {
-                m_poPtr = 0U;
-                m_poLen = 0U;
-                return;
-            }
+        if (m_poPtr >= m_poLen) {
+            m_poPtr = 0U;
+            m_poLen = 0U;
         }
     }
 }
@@ -95,17 +112,21 @@ void NXDNTX::process()
 
 uint8_t NXDNTX::writeData(const uint8_t* data, uint16_t length)
 {
+    uint32_t launch = 0U;
+    bool timed = TXSchedule::getLaunch(data, length, launch);
     if (length != (NXDN_FRAME_LENGTH_BYTES + 1U))
         return RSN_ILLEGAL_LENGTH;
 
     uint16_t space = m_fifo.getSpace();
     DEBUG3("NXDNTX::writeData() dataLength/fifoLength", length, space);
-    if (space < NXDN_FRAME_LENGTH_BYTES)
+    if (space < NXDN_FRAME_LENGTH_BYTES || (timed && !m_schedule.hasSpace()))
         return RSN_RINGBUFF_FULL;
 
     for (uint8_t i = 0U; i < NXDN_FRAME_LENGTH_BYTES; i++)
         m_fifo.put(data[i + 1U]);
 
+    m_schedule.put(timed, launch);
+
     return RSN_OK;
 }
 
@@ -114,6 +135,7 @@ uint8_t NXDNTX::writeData(const uint8_t* data, uint16_t length)
 void NXDNTX::clear()
 {
     m_fifo.reset();
+    m_schedule.reset();
 }
 
 /* Sets the FDMA preamble count. */
@@ -147,6 +169,7 @@ void NXDNTX::resizeBuffer(uint16_t size)
 {
     m_fifo.reset();
     m_fifo.reinitialize(size);
+    m_schedule.reset();
 }
 
 /* Helper to get how much space the ring buffer has for samples. */
@@ -156,6 +179,14 @@ uint8_t NXDNTX::getSpace() const
     return m_fifo.getSpace() / NXDN_FRAME_LENGTH_BYTES;
 }
 
+/* Helper to get how long the queued frames, and the rest of the frame being sent, take to go out. */
+
+uint16_t NXDNTX::getQueuedMs() const
+{
+    // 4800 bps
+    return (uint16_t)((uint32_t(m_fifo.getData() + (m_poLen - m_poPtr)) * 8000U) / 4800U);
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
@@ -173,6 +204,8 @@ void NXDNTX::createData()
         m_poBuffer[m_poLen++] = NXDN_PREAMBLE[2U];
     }
     else {
+        m_schedule.take();
+
         DEBUG2("NXDNTX::createData() fifoSpace", m_fifo.getSpace());
         for (uint8_t i = 0U; i < NXDN_FRAME_LENGTH_BYTES; i++) {
             m_poBuffer[m_poLen++] = m_fifo.get();
@@ -182,30 +215,14 @@ void NXDNTX::createData()
     m_poPtr = 0U;
 }
 
-/* Helper to write a raw byte to the DAC. */
-
-void NXDNTX::writeByte(uint8_t c)
-{
-    uint8_t bit;
-    uint8_t mask = 0x80U;
-    
-    for (uint8_t i = 0U; i < 8U; i++, c <<= 1) {
-        if ((c & mask) == mask)
-            bit = 1U;
-        else
-            bit = 0U;
-
-        io.write(&bit, 1);
-    }
-}
-
-/* */
+/* Helper to write silence (4 bits per count) to the DAC. */
 
-void NXDNTX::writeSilence()
+void NXDNTX::writeSilence(uint16_t count)
 {
-    uint8_t bit;
-    for (uint8_t i = 0U; i < 4U; i++) {
-        bit = 0U;
-        io.write(&bit, 1);
+    uint32_t bits = count * 4U;
+    while (bits > 0U) {
+        uint8_t n = (bits > 32U) ? 32U : uint8_t(bits);
+        io.writeBits(0U, n);
+        bits -= n;
     }
 }
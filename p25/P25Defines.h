@@ -75,6 +75,14 @@ namespace p25
     const uint32_t  P25_NID_LENGTH_SYMBOLS = P25_NID_LENGTH_BYTES * 4U;
     const uint32_t  P25_NID_LENGTH_SAMPLES = P25_NID_LENGTH_SYMBOLS * P25_RADIO_SYMBOL_LENGTH;
 
+    // NAC and DUID, BCH parity and the trailing parity bit
+    const uint32_t  P25_NID_FEC_LENGTH_BYTES = 8U;
+    const uint32_t  P25_NID_FEC_LENGTH_BITS = P25_NID_FEC_LENGTH_BYTES * 8U;
+
+    // status symbol, inserted after every 70 bits of the frame
+    const uint32_t  P25_SS_LENGTH_BITS = 2U;
+    const uint32_t  P25_SS_INCREMENT = 72U;
+
     const uint8_t   P25_SYNC_BYTES[] = { 0x55U, 0x75U, 0xF5U, 0xFFU, 0x77U, 0xFFU };
     const uint8_t   P25_SYNC_BYTES_LENGTH = 6U;
     const uint8_t   P25_START_SYNC = 0x5FU;
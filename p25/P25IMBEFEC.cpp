@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "p25/P25IMBEFEC.h"
+#include "Golay24128.h"
+#include "Utils.h"
+
+using namespace p25;
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t IMBE_FRAMES = 9U;
+const uint8_t IMBE_LENGTH_BITS = 144U;
+const uint8_t IMBE_LENGTH_BYTES = IMBE_LENGTH_BITS / 8U;
+const uint8_t IMBE_CODEWORDS = 8U;
+const uint8_t IMBE_GOLAY_CODEWORDS = 4U;
+
+// frame bit each IMBE frame starts at; each spans 148 bits, the 144 frame bits and two status symbols
+const uint16_t IMBE_START[] = { 114U, 262U, 452U, 640U, 830U, 1020U, 1208U, 1398U, 1578U };
+
+// lengths of u0 - u7
+const uint8_t IMBE_CODEWORD_LENGTHS[] = { 23U, 23U, 23U, 23U, 15U, 15U, 15U, 7U };
+
+// codeword bit n is sent as bit IMBE_INTERLEAVE[n] of the frame
+const uint8_t IMBE_INTERLEAVE[] = {
+    0U, 7U, 12U, 19U, 24U, 31U, 36U, 43U, 48U, 55U, 60U, 67U, 72U, 79U, 84U, 91U, 96U, 103U, 108U, 115U, 120U, 127U, 132U, 139U,
+    1U, 6U, 13U, 18U, 25U, 30U, 37U, 42U, 49U, 54U, 61U, 66U, 73U, 78U, 85U, 90U, 97U, 102U, 109U, 114U, 121U, 126U, 133U, 138U,
+    2U, 9U, 14U, 21U, 26U, 33U, 38U, 45U, 50U, 57U, 62U, 69U, 74U, 81U, 86U, 93U, 98U, 105U, 110U, 117U, 122U, 129U, 134U, 141U,
+    3U, 8U, 15U, 20U, 27U, 32U, 39U, 44U, 51U, 56U, 63U, 68U, 75U, 80U, 87U, 92U, 99U, 104U, 111U, 116U, 123U, 128U, 135U, 140U,
+    4U, 11U, 16U, 23U, 28U, 35U, 40U, 47U, 52U, 59U, 64U, 71U, 76U, 83U, 88U, 95U, 100U, 107U, 112U, 119U, 124U, 131U, 136U, 143U,
+    5U, 10U, 17U, 22U, 29U, 34U, 41U, 46U, 53U, 58U, 65U, 70U, 77U, 82U, 89U, 94U, 101U, 106U, 113U, 118U, 125U, 130U, 137U, 142U };
+
+// Hamming (15,11) checks of TIA-102.BABA (data bit 0 in bit 14; each mask includes its check bit)
+const uint16_t HAMMING_CHECK_MASKS[] = { 0x7F08U, 0x78E4U, 0x66D2U, 0x55B1U };
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the P25IMBEFEC class. */
+
+P25IMBEFEC::P25IMBEFEC()
+{
+    /* stub */
+}
+
+/* Gets the count of bit errors in the IMBE frames of a LDU. */
+
+void P25IMBEFEC::getErrors(const uint8_t* ldu, uint8_t& golayErrs, uint8_t& hammingErrs) const
+{
+    golayErrs = 0U;
+    hammingErrs = 0U;
+
+    for (uint8_t n = 0U; n < IMBE_FRAMES; n++) {
+        uint32_t u[IMBE_CODEWORDS];
+        readIMBE(ldu, n, u);
+
+        // u1 - u6 are scrambled by the u0 data; an uncorrectable u0 shows up as errors in the others too
+        uint8_t errs = 0U;
+        uint32_t data = Golay24128::decode23127(u[0U], errs);
+        golayErrs += errs;
+
+        scramble(data, u);
+
+        for (uint8_t i = 1U; i < IMBE_GOLAY_CODEWORDS; i++) {
+            Golay24128::decode23127(u[i], errs);
+            golayErrs += errs;
+        }
+
+        for (uint8_t i = IMBE_GOLAY_CODEWORDS; i < IMBE_CODEWORDS - 1U; i++) {
+            if (getSyndrome15113(u[i]) != 0U)
+                hammingErrs++;
+        }
+    }
+}
+
+#if defined(HOST_SIM)
+/* Regenerates the parity of the IMBE frames of a LDU from their data bits. */
+
+void P25IMBEFEC::encode(uint8_t* ldu) const
+{
+    for (uint8_t n = 0U; n < IMBE_FRAMES; n++) {
+        uint32_t u[IMBE_CODEWORDS];
+        readIMBE(ldu, n, u);
+
+        // keep the data bits as they are, and replace the parity
+        uint32_t data = (u[0U] >> 11) & 0xFFFU;
+        for (uint8_t i = 0U; i < IMBE_GOLAY_CODEWORDS; i++)
+            u[i] = Golay24128::encode23127((u[i] >> 11) & 0xFFFU);
+
+        for (uint8_t i = IMBE_GOLAY_CODEWORDS; i < IMBE_CODEWORDS - 1U; i++) {
+            uint32_t code = u[i] & 0x7FF0U;
+            for (uint8_t j = 0U; j < 4U; j++)
+                code |= (countBits16(uint16_t(code & HAMMING_CHECK_MASKS[j])) & 0x01U) << (3U - j);
+            u[i] = code;
+        }
+
+        scramble(data, u);
+        writeIMBE(ldu, n, u);
+    }
+}
+#endif
+
+/* Gets the 4 bit syndrome of a Hamming (15,11) codeword. */
+
+uint8_t P25IMBEFEC::getSyndrome15113(uint32_t code)
+{
+    uint8_t syndrome = 0U;
+    for (uint8_t i = 0U; i < 4U; i++)
+        syndrome |= (countBits16(uint16_t(code & HAMMING_CHECK_MASKS[i])) & 0x01U) << i;
+
+    return syndrome;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to read the eight codewords (u0 - u7) of an IMBE frame. */
+
+void P25IMBEFEC::readIMBE(const uint8_t* ldu, uint8_t n, uint32_t* u) const
+{
+    // gather the frame bits, stepping over the status symbols
+    uint8_t raw[IMBE_LENGTH_BYTES];
+    uint16_t pos = IMBE_START[n];
+    for (uint8_t i = 0U; i < IMBE_LENGTH_BITS; i++, pos++) {
+        if ((pos % P25_SS_INCREMENT) >= (P25_SS_INCREMENT - P25_SS_LENGTH_BITS))
+            pos += P25_SS_LENGTH_BITS;
+
+        _WRITE_BIT(raw, i, _READ_BIT(ldu, pos));
+    }
+
+    uint8_t i = 0U;
+    for (uint8_t w = 0U; w < IMBE_CODEWORDS; w++) {
+        u[w] = 0U;
+        for (uint8_t j = 0U; j < IMBE_CODEWORD_LENGTHS[w]; j++, i++)
+            u[w] = (u[w] << 1) | _READ_BIT(raw, IMBE_INTERLEAVE[i]);
+    }
+}
+
+#if defined(HOST_SIM)
+/* Helper to write the eight codewords (u0 - u7) of an IMBE frame. */
+
+void P25IMBEFEC::writeIMBE(uint8_t* ldu, uint8_t n, const uint32_t* u) const
+{
+    uint8_t raw[IMBE_LENGTH_BYTES];
+
+    uint8_t i = 0U;
+    for (uint8_t w = 0U; w < IMBE_CODEWORDS; w++) {
+        for (uint8_t j = 0U; j < IMBE_CODEWORD_LENGTHS[w]; j++, i++) {
+            bool bit = ((u[w] >> (IMBE_CODEWORD_LENGTHS[w] - 1U - j)) & 0x01U) != 0U;
+            _WRITE_BIT(raw, IMBE_INTERLEAVE[i], bit);
+        }
+    }
+
+    uint16_t pos = IMBE_START[n];
+    for (i = 0U; i < IMBE_LENGTH_BITS; i++, pos++) {
+        if ((pos % P25_SS_INCREMENT) >= (P25_SS_INCREMENT - P25_SS_LENGTH_BITS))
+            pos += P25_SS_LENGTH_BITS;
+
+        _WRITE_BIT(ldu, pos, _READ_BIT(raw, i));
+    }
+}
+#endif
+
+/* Helper to (un)scramble u1 - u6 with the PRNG seeded by the u0 data bits. */
+
+void P25IMBEFEC::scramble(uint32_t data, uint32_t* u) const
+{
+    uint16_t p = uint16_t(data << 4);
+    for (uint8_t i = 1U; i < IMBE_CODEWORDS - 1U; i++)
+        u[i] ^= vocoderPRNG(p, IMBE_CODEWORD_LENGTHS[i]);
+}
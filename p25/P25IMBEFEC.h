@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file P25IMBEFEC.h
+ * @ingroup p25_hfw
+ * @file P25IMBEFEC.cpp
+ * @ingroup p25_hfw
+ */
+#if !defined(__P25_IMBE_FEC_H__)
+#define __P25_IMBE_FEC_H__
+
+#include "Defines.h"
+#include "p25/P25Defines.h"
+
+namespace p25
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the FEC check of the nine IMBE vocoder frames carried by a P25 LDU; each frame
+     *  protects u0 - u3 with Golay (23,12) and u4 - u6 with Hamming (15,11), u1 - u6 are PRNG scrambled
+     *  and u7 is unprotected.
+     * @ingroup p25_hfw
+     */
+    class DSP_FW_API P25IMBEFEC {
+    public:
+        /**
+         * @brief Initializes a new instance of the P25IMBEFEC class.
+         */
+        P25IMBEFEC();
+
+        /**
+         * @brief Gets the count of bit errors in the IMBE frames of a LDU.
+         * @param[in] ldu P25 LDU (starting with the frame sync).
+         * @param[out] golayErrs Count of bits corrected in the 36 Golay (23,12) codewords (at most 108).
+         * @param[out] hammingErrs Count of the 27 Hamming (15,11) codewords with a bit error.
+         */
+        void getErrors(const uint8_t* ldu, uint8_t& golayErrs, uint8_t& hammingErrs) const;
+#if defined(HOST_SIM)
+        /**
+         * @brief Regenerates the parity of the IMBE frames of a LDU from their data bits.
+         * @param[in,out] ldu P25 LDU (starting with the frame sync).
+         */
+        void encode(uint8_t* ldu) const;
+#endif
+
+        /**
+         * @brief Gets the 4 bit syndrome of a Hamming (15,11) codeword.
+         * @param code 15 bit codeword; data in the upper 11 bits, parity in the lower 4 bits.
+         * @returns uint8_t Syndrome, or 0 if the codeword is valid.
+         */
+        static uint8_t getSyndrome15113(uint32_t code);
+
+    private:
+        /**
+         * @brief Helper to read the eight codewords (u0 - u7) of an IMBE frame; stepping over the status
+         *  symbols and deinterleaving.
+         * @param[in] ldu P25 LDU (starting with the frame sync).
+         * @param n IMBE frame (0 - 8).
+         * @param[out] u Codewords.
+         */
+        void readIMBE(const uint8_t* ldu, uint8_t n, uint32_t* u) const;
+#if defined(HOST_SIM)
+        /**
+         * @brief Helper to write the eight codewords (u0 - u7) of an IMBE frame.
+         * @param[in,out] ldu P25 LDU (starting with the frame sync).
+         * @param n IMBE frame (0 - 8).
+         * @param[in] u Codewords.
+         */
+        void writeIMBE(uint8_t* ldu, uint8_t n, const uint32_t* u) const;
+#endif
+        /**
+         * @brief Helper to (un)scramble u1 - u6 with the PRNG seeded by the u0 data bits.
+         * @param data 12 u0 data bits.
+         * @param[in,out] u Codewords.
+         */
+        void scramble(uint32_t data, uint32_t* u) const;
+    };
+} // namespace p25
+
+#endif // __P25_IMBE_FEC_H__
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Globals.h"
+#include "p25/P25NID.h"
+
+using namespace p25;
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t BCH_N = 63U;                  // codeword length
+const uint8_t BCH_K = 16U;                  // NAC and DUID
+const uint8_t BCH_T = 11U;                  // correctable bit errors
+
+// generator polynomial, g(x); the product of the minimal polynomials of a^1 - a^22
+const uint64_t BCH_GENERATOR = 0x0000CD930BDD3B2BU;
+
+// GF(2^6) antilogarithms (repeated, so a sum of two logarithms needs no reduction) and logarithms, for the
+// primitive polynomial x^6 + x + 1
+const uint8_t GF64_EXP[] = {
+    0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x03U, 0x06U, 0x0CU, 0x18U, 0x30U, 0x23U, 0x05U, 0x0AU, 0x14U, 0x28U,
+    0x13U, 0x26U, 0x0FU, 0x1EU, 0x3CU, 0x3BU, 0x35U, 0x29U, 0x11U, 0x22U, 0x07U, 0x0EU, 0x1CU, 0x38U, 0x33U, 0x25U,
+    0x09U, 0x12U, 0x24U, 0x0BU, 0x16U, 0x2CU, 0x1BU, 0x36U, 0x2FU, 0x1DU, 0x3AU, 0x37U, 0x2DU, 0x19U, 0x32U, 0x27U,
+    0x0DU, 0x1AU, 0x34U, 0x2BU, 0x15U, 0x2AU, 0x17U, 0x2EU, 0x1FU, 0x3EU, 0x3FU, 0x3DU, 0x39U, 0x31U, 0x21U, 0x01U,
+    0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x03U, 0x06U, 0x0CU, 0x18U, 0x30U, 0x23U, 0x05U, 0x0AU, 0x14U, 0x28U, 0x13U,
+    0x26U, 0x0FU, 0x1EU, 0x3CU, 0x3BU, 0x35U, 0x29U, 0x11U, 0x22U, 0x07U, 0x0EU, 0x1CU, 0x38U, 0x33U, 0x25U, 0x09U,
+    0x12U, 0x24U, 0x0BU, 0x16U, 0x2CU, 0x1BU, 0x36U, 0x2FU, 0x1DU, 0x3AU, 0x37U, 0x2DU, 0x19U, 0x32U, 0x27U, 0x0DU,
+    0x1AU, 0x34U, 0x2BU, 0x15U, 0x2AU, 0x17U, 0x2EU, 0x1FU, 0x3EU, 0x3FU, 0x3DU, 0x39U, 0x31U, 0x21U };
+
+const uint8_t GF64_LOG[] = {
+    0x00U, 0x00U, 0x01U, 0x06U, 0x02U, 0x0CU, 0x07U, 0x1AU, 0x03U, 0x20U, 0x0DU, 0x23U, 0x08U, 0x30U, 0x1BU, 0x12U,
+    0x04U, 0x18U, 0x21U, 0x10U, 0x0EU, 0x34U, 0x24U, 0x36U, 0x09U, 0x2DU, 0x31U, 0x26U, 0x1CU, 0x29U, 0x13U, 0x38U,
+    0x05U, 0x3EU, 0x19U, 0x0BU, 0x22U, 0x1FU, 0x11U, 0x2FU, 0x0FU, 0x17U, 0x35U, 0x33U, 0x25U, 0x2CU, 0x37U, 0x28U,
+    0x0AU, 0x3DU, 0x2EU, 0x1EU, 0x32U, 0x16U, 0x27U, 0x2BU, 0x1DU, 0x3CU, 0x2AU, 0x15U, 0x14U, 0x3BU, 0x39U, 0x3AU };
+
+#define GF64_MUL(a, b) (((a) != 0U && (b) != 0U) ? GF64_EXP[GF64_LOG[a] + GF64_LOG[b]] : 0U)
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the P25NID class. */
+
+P25NID::P25NID()
+{
+    /* stub */
+}
+
+/* Decodes the P25 NID, correcting up to 11 bit errors in place. */
+
+bool P25NID::decode(uint8_t* frame, uint16_t& nac, uint8_t& duid, uint8_t& errs) const
+{
+    uint64_t nid = readNID(frame);
+
+    // the trailing parity bit isn't covered by the BCH code
+    uint64_t codeword = nid >> 1;
+
+    errs = 0U;
+    uint64_t remainder = getRemainder(codeword);
+    if (remainder != 0U) {
+        errs = correct(codeword, remainder);
+        if (errs > BCH_T)
+            return false;
+
+        writeNID(frame, (codeword << 1) | (nid & 0x01U));
+    }
+
+    nac = uint16_t((codeword >> (BCH_N - 12U)) & 0xFFFU);
+    duid = uint8_t((codeword >> (BCH_N - BCH_K)) & 0x0FU);
+    return true;
+}
+
+/* Encodes the P25 NID. */
+
+void P25NID::encode(uint16_t nac, uint8_t duid, uint8_t* frame) const
+{
+    uint64_t codeword = (uint64_t(nac & 0xFFFU) << (BCH_N - 12U)) | (uint64_t(duid & 0x0FU) << (BCH_N - BCH_K));
+    codeword |= getRemainder(codeword);
+
+    // the trailing parity bit is left clear
+    writeNID(frame, codeword << 1);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to read the 64 NID bits from around the status symbol that follows them in the frame. */
+
+uint64_t P25NID::readNID(const uint8_t* frame) const
+{
+    // frame bits 48 - 119; NID bits 0 - 21, the status symbol, NID bits 22 - 63 (and 6 bits that follow)
+    uint64_t bits = 0U;
+    for (uint8_t i = 6U; i < 14U; i++)
+        bits = (bits << 8) | frame[i];
+
+    return (bits & 0xFFFFFC0000000000U) | ((bits << 2) & 0x000003FFFFFFFFFCU) | (frame[14U] >> 6);
+}
+
+/* Helper to write the 64 NID bits around the status symbol that follows them in the frame. */
+
+void P25NID::writeNID(uint8_t* frame, uint64_t nid) const
+{
+    uint64_t bits = (nid & 0xFFFFFC0000000000U) | ((nid >> 2) & 0x000000FFFFFFFFFFU);
+    bits |= ((uint64_t)frame[8U] << 40) & 0x0000030000000000U;
+
+    for (uint8_t i = 13U; i >= 6U; i--) {
+        frame[i] = uint8_t(bits & 0xFFU);
+        bits >>= 8;
+    }
+
+    frame[14U] = (frame[14U] & 0x3FU) | (uint8_t(nid << 6) & 0xC0U);
+}
+
+/* Gets the remainder of a 63 bit pattern modulo the BCH generator polynomial. */
+
+uint64_t P25NID::getRemainder(uint64_t pattern) const
+{
+    for (uint8_t i = BCH_N - 1U; i >= BCH_N - BCH_K; i--) {
+        if ((pattern >> i) & 0x01U)
+            pattern ^= BCH_GENERATOR << (i - (BCH_N - BCH_K));
+    }
+
+    return pattern;
+}
+
+/* Corrects a 63 bit pattern; from its syndromes (Berlekamp-Massey) and the roots of the resulting error locator (Chien search). */
+
+uint8_t P25NID::correct(uint64_t& pattern, uint64_t remainder) const
+{
+    // syndromes S1 - S22; as a^1 - a^22 are roots of every codeword, the odd ones are those of the remainder
+    // (each bit i adds a^(i * j) to Sj), the even ones the squares of the odd ones
+    uint8_t s[2U * BCH_T + 1U];
+    ::memset(s, 0x00U, sizeof(s));
+
+    for (uint8_t i = 0U; i < BCH_N - BCH_K; i++) {
+        if (!((remainder >> i) & 0x01U))
+            continue;
+
+        uint8_t e = i;
+        uint8_t step = (2U * i) % BCH_N;
+        for (uint8_t j = 1U; j < 2U * BCH_T; j += 2U) {
+            s[j] ^= GF64_EXP[e];
+            e += step;
+            if (e >= BCH_N)
+                e -= BCH_N;
+        }
+    }
+
+    for (uint8_t j = 2U; j <= 2U * BCH_T; j += 2U)
+        s[j] = GF64_MUL(s[j / 2U], s[j / 2U]);
+
+    // error locator polynomial
+    uint8_t c[2U * BCH_T + 2U], b[2U * BCH_T + 2U], t[2U * BCH_T + 2U];
+    ::memset(c, 0x00U, sizeof(c));
+    ::memset(b, 0x00U, sizeof(b));
+    c[0U] = b[0U] = 0x01U;
+
+    uint8_t l = 0U, m = 1U, bd = 0x01U;
+    for (uint8_t n = 0U; n < 2U * BCH_T; n++) {
+        uint8_t d = s[n + 1U];
+        for (uint8_t i = 1U; i <= l; i++)
+            d ^= GF64_MUL(c[i], s[n + 1U - i]);
+
+        if (d == 0U) {
+            m++;
+            continue;
+        }
+
+        // coefficient d / bd
+        uint8_t coef = GF64_EXP[GF64_LOG[d] + BCH_N - GF64_LOG[bd]];
+        bool lengthen = (2U * l) <= n;
+        if (lengthen)
+            ::memcpy(t, c, sizeof(c));
+
+        for (uint8_t i = 0U; i + m < sizeof(c); i++)
+            c[i + m] ^= GF64_MUL(coef, b[i]);
+
+        if (lengthen) {
+            l = n + 1U - l;
+            ::memcpy(b, t, sizeof(b));
+            bd = d;
+            m = 1U;
+        }
+        else {
+            m++;
+        }
+    }
+
+    if (l > BCH_T)
+        return 0xFFU;
+
+    // an error at bit i is a root a^-i of the locator; step each term by a^-k per bit
+    uint8_t term[BCH_T + 1U];
+    for (uint8_t k = 1U; k <= l; k++)
+        term[k] = (c[k] != 0U) ? GF64_LOG[c[k]] : 0xFFU;
+
+    uint8_t errs = 0U;
+    for (uint8_t i = 0U; i < BCH_N; i++) {
+        uint8_t sum = c[0U];
+        for (uint8_t k = 1U; k <= l; k++) {
+            if (term[k] == 0xFFU)
+                continue;
+
+            sum ^= GF64_EXP[term[k]];
+            term[k] = (term[k] >= k) ? (term[k] - k) : (term[k] + BCH_N - k);
+        }
+
+        if (sum == 0U) {
+            pattern ^= (uint64_t)0x01U << i;
+            errs++;
+        }
+    }
+
+    // a locator without as many roots as its degree means more errors than can be corrected
+    if (errs != l)
+        return 0xFFU;
+
+    return errs;
+}
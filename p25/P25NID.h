@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Hotspot Firmware
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2026 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file P25NID.h
+ * @ingroup p25_hfw
+ * @file P25NID.cpp
+ * @ingroup p25_hfw
+ */
+#if !defined(__P25_NID_H__)
+#define __P25_NID_H__
+
+#include "Defines.h"
+
+namespace p25
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the P25 network identifier (NID); the NAC and DUID protected by a BCH (63,16,23) code
+     *  and a trailing parity bit.
+     * @ingroup p25_hfw
+     */
+    class DSP_FW_API P25NID {
+    public:
+        /**
+         * @brief Initializes a new instance of the P25NID class.
+         */
+        P25NID();
+
+        /**
+         * @brief Decodes the P25 NID, correcting up to 11 bit errors in place.
+         * @param[in,out] frame P25 frame (starting with the frame sync).
+         * @param[out] nac Network Access Code.
+         * @param[out] duid Data Unit ID.
+         * @param[out] errs Number of bit errors corrected.
+         * @returns bool True, if the P25 NID was decoded, otherwise false.
+         */
+        bool decode(uint8_t* frame, uint16_t& nac, uint8_t& duid, uint8_t& errs) const;
+        /**
+         * @brief Encodes the P25 NID.
+         * @param nac Network Access Code.
+         * @param duid Data Unit ID.
+         * @param[out] frame P25 frame (starting with the frame sync).
+         */
+        void encode(uint16_t nac, uint8_t duid, uint8_t* frame) const;
+
+    private:
+        /**
+         * @brief Helper to read the 64 NID bits from around the status symbol that follows them in the frame.
+         * @param[in] frame P25 frame (starting with the frame sync).
+         * @returns uint64_t NID bits.
+         */
+        uint64_t readNID(const uint8_t* frame) const;
+        /**
+         * @brief Helper to write the 64 NID bits around the status symbol that follows them in the frame.
+         * @param[out] frame P25 frame (starting with the frame sync).
+         * @param nid NID bits.
+         */
+        void writeNID(uint8_t* frame, uint64_t nid) const;
+
+        /**
+         * @brief Gets the remainder of a 63 bit pattern modulo the BCH generator polynomial.
+         * @param pattern Received 63 bit pattern.
+         * @returns uint64_t 47 bit remainder; zero for a codeword.
+         */
+        uint64_t getRemainder(uint64_t pattern) const;
+        /**
+         * @brief Corrects a 63 bit pattern; from its syndromes (Berlekamp-Massey) and the roots of the resulting
+         *  error locator (Chien search).
+         * @param[in,out] pattern Received 63 bit pattern.
+         * @param remainder Remainder of the pattern modulo the BCH generator polynomial.
+         * @returns uint8_t Number of bit errors corrected, or 0xFF if the pattern isn't correctable.
+         */
+        uint8_t correct(uint64_t& pattern, uint64_t remainder) const;
+    };
+} // namespace p25
+
+#endif // __P25_NID_H__
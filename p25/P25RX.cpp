@@ -11,6 +11,8 @@
  */
 #include "Globals.h"
 #include "p25/P25RX.h"
+#include "p25/P25IMBEFEC.h"
+#include "p25/P25NID.h"
 #include "Utils.h"
 
 using namespace p25;
@@ -26,6 +28,9 @@ const uint16_t MAX_SYNC_FRAMES = 7U;
 
 const uint16_t NOENDPTR = 9999U;
 
+// the NID is followed by the frame's first status symbol
+const uint16_t NID_END_PTR = P25_SYNC_LENGTH_BITS + P25_NID_FEC_LENGTH_BITS + P25_SS_LENGTH_BITS;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -39,11 +44,15 @@ P25RX::P25RX() :
     m_endPtr(NOENDPTR),
     m_pduEndPtr(NOENDPTR),
     m_lostCount(0U),
-    m_nac(0xF7EU),
+    m_nac(P25_NAC_ALL),
+    m_nacs(),
+    m_rejected(),
+    m_nidCorrected(0U),
     m_state(P25RXS_NONE),
     m_duid(0xFFU)
 {
     ::memset(m_buffer, 0x00U, P25_LDU_FRAME_LENGTH_BYTES + 3U);
+    setNAC(P25_NAC_ALL);
 }
 
 /* Helper to reset data values to defaults. */
@@ -69,6 +78,8 @@ void P25RX::reset()
 
 void P25RX::databit(bool bit)
 {
+    PROFILE_SCOPE(PROBE_P25_RX_DATABIT);
+
     m_bitBuffer <<= 1;
     if (bit)
         m_bitBuffer |= 0x01U;
@@ -113,6 +124,23 @@ void P25RX::databit(bool bit)
 void P25RX::setNAC(uint16_t nac)
 {
     m_nac = nac;
+
+    ::memset(m_nacs, 0x00U, sizeof(m_nacs));
+    allowNAC(nac);
+}
+
+/* Adds a P25 NAC to those allowed. */
+
+void P25RX::allowNAC(uint16_t nac)
+{
+    // $F7E allows any NAC, wherever it is in the list
+    if (nac == P25_NAC_ALL) {
+        ::memset(m_nacs, 0xFFU, sizeof(m_nacs));
+        return;
+    }
+
+    nac &= P25_NAC_COUNT - 1U;
+    m_nacs[nac >> 5] |= 1U << (nac & 0x1FU);
 }
 
 // ---------------------------------------------------------------------------
@@ -124,7 +152,7 @@ void P25RX::setNAC(uint16_t nac)
 void P25RX::processBit(bool bit)
 {
     // process NID
-    if (m_dataPtr == P25_SYNC_LENGTH_BITS + P25_NID_LENGTH_BITS + 1) {
+    if (m_dataPtr == NID_END_PTR) {
         DEBUG3("P25RX::processBit() dataPtr/endPtr", m_dataPtr, m_endPtr);
 
         if (!decodeNid()) {
@@ -175,6 +203,7 @@ void P25RX::processBit(bool bit)
                 break;
             default:
                 {
+                    m_rejected[P25RXR_DUID]++;
                     DEBUG3("P25RX::processBit() illegal DUID in NID", m_nac, m_duid);
                     reset();
                 }
@@ -194,11 +223,14 @@ void P25RX::processBit(bool bit)
             // DEBUG3("P25RX: m_buffer dump endPtr/endPtrB", m_endPtr, m_endPtr / 8U);
             // DEBUG_DUMP(m_buffer, P25_LDU_FRAME_LENGTH_BYTES + 3U);
 
-            uint8_t frame[P25_HDU_FRAME_LENGTH_BYTES + 1U];
-            ::memcpy(frame + 1U, m_buffer, m_endPtr / 8U);
+            uint8_t trailer[4U];
+            uint8_t length = 0U;
+#if defined(SEND_RX_TIMESTAMP)
+            io.getRXTimestamp(m_dataPtr, trailer);
+            length += 4U;
+#endif
 
-            frame[0U] = 0x01U; // has sync
-            serial.writeP25Data(frame, (m_endPtr / 8U) + 1U);
+            serial.writeP25Data(0x01U, m_buffer, m_endPtr / 8U, trailer, length); // has sync
             reset();
         }
     }
@@ -225,7 +257,7 @@ void P25RX::processVoice(bool bit)
     }
 
     // process NID
-    if (m_dataPtr == P25_SYNC_LENGTH_BITS + P25_NID_LENGTH_BITS + 1) {
+    if (m_dataPtr == NID_END_PTR) {
         DEBUG3("P25RX::processVoice() dataPtr/endPtr", m_dataPtr, m_endPtr);
 
         if (!decodeNid()) {
@@ -250,6 +282,7 @@ void P25RX::processVoice(bool bit)
                 return;
             default:
                 {
+                    m_rejected[P25RXR_DUID]++;
                     DEBUG3("P25RX::processVoice() illegal DUID in NID", m_nac, m_duid);
                     reset();
                 }
@@ -263,11 +296,14 @@ void P25RX::processVoice(bool bit)
     {
         DEBUG2("P25RX::processVoice() sync found in TDU pos", m_dataPtr);
 
-        uint8_t frame[P25_TDU_FRAME_LENGTH_BYTES + 1U];
-        ::memcpy(frame + 1U, m_buffer, m_endPtr / 8U);
+        uint8_t trailer[4U];
+        uint8_t length = 0U;
+#if defined(SEND_RX_TIMESTAMP)
+        io.getRXTimestamp(m_dataPtr, trailer);
+        length += 4U;
+#endif
 
-        frame[0U] = 0x01U; // has sync
-        serial.writeP25Data(frame, P25_TDU_FRAME_LENGTH_BYTES + 1U);
+        serial.writeP25Data(0x01U, m_buffer, P25_TDU_FRAME_LENGTH_BYTES, trailer, length); // has sync
 
         io.setDecode(false);
 
@@ -291,19 +327,30 @@ void P25RX::processVoice(bool bit)
         else {
             DEBUG2("P25RX::processVoice() sync found in LDU pos", m_dataPtr);
 
-            uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES + 3U];
-            ::memcpy(frame + 1U, m_buffer, m_endPtr / 8U);
+            uint8_t flags = m_lostCount == (MAX_SYNC_FRAMES - 1U) ? 0x01U : 0x00U; // set sync flag
 
-            frame[0U] = m_lostCount == (MAX_SYNC_FRAMES - 1U) ? 0x01U : 0x00U; // set sync flag
+            // the LDU is written straight from the receive buffer, followed by its metadata
+            uint8_t trailer[8U];
+            uint8_t length = 0U;
 #if defined(SEND_RSSI_DATA)
             uint16_t rssi = io.readRSSI();
-            frame[217U] = (rssi >> 8) & 0xFFU;
-            frame[218U] = (rssi >> 0) & 0xFFU;
-
-            serial.writeP25Data(false, frame, P25_LDU_FRAME_LENGTH_BYTES + 3U);
-#else
-            serial.writeP25Data(frame, P25_LDU_FRAME_LENGTH_BYTES + 1U);
+            trailer[length++] = (rssi >> 8) & 0xFFU;
+            trailer[length++] = (rssi >> 0) & 0xFFU;
+#endif
+#if defined(SEND_BER_DATA)
+            // the LDU ends with the count of bits corrected in the Golay codewords of its IMBE frames, and
+            // the count of its Hamming codewords in error
+            P25IMBEFEC imbeFEC;
+            imbeFEC.getErrors(m_buffer, trailer[length], trailer[length + 1U]);
+            length += 2U;
 #endif
+#if defined(SEND_RX_TIMESTAMP)
+            // the LDU is written as its last bit is received
+            io.getRXTimestamp(m_dataPtr, trailer + length);
+            length += 4U;
+#endif
+
+            serial.writeP25Data(flags, m_buffer, P25_LDU_FRAME_LENGTH_BYTES, trailer, length);
 
         }
     }
@@ -319,7 +366,7 @@ void P25RX::processData(bool bit)
     }
 
     // process NID
-    if (m_dataPtr == P25_SYNC_LENGTH_BITS + P25_NID_LENGTH_BITS + 1) {
+    if (m_dataPtr == NID_END_PTR) {
         DEBUG3("P25RX::processData() dataPtr/pduEndPtr", m_dataPtr, m_pduEndPtr);
 
         if (!decodeNid()) {
@@ -335,6 +382,7 @@ void P25RX::processData(bool bit)
                 return;
             default:
                 {
+                    m_rejected[P25RXR_DUID]++;
                     DEBUG3("P25RX::processData() illegal DUID in NID", m_nac, m_duid);
                     reset();
                 }
@@ -359,11 +407,16 @@ void P25RX::processData(bool bit)
         else {
             DEBUG2("P25RX::processData() sync found in PDU pos", m_dataPtr);
 
-            uint8_t frame[P25_PDU_FRAME_LENGTH_BYTES + 1U];
-            ::memcpy(frame + 1U, m_buffer, m_pduEndPtr / 8U);
+            uint8_t flags = m_lostCount == (MAX_SYNC_FRAMES - 1U) ? 0x01U : 0x00U; // set sync flag
 
-            frame[0U] = m_lostCount == (MAX_SYNC_FRAMES - 1U) ? 0x01U : 0x00U; // set sync flag
-            serial.writeP25Data(frame, P25_PDU_FRAME_LENGTH_BYTES + 1U);
+            uint8_t trailer[4U];
+            uint8_t length = 0U;
+#if defined(SEND_RX_TIMESTAMP)
+            io.getRXTimestamp(m_dataPtr, trailer);
+            length += 4U;
+#endif
+
+            serial.writeP25Data(flags, m_buffer, P25_PDU_FRAME_LENGTH_BYTES, trailer, length);
         }
     }
 }
@@ -372,6 +425,8 @@ void P25RX::processData(bool bit)
 
 bool P25RX::correlateSync()
 {
+    PROFILE_SCOPE(PROBE_P25_RX_SYNC);
+
     uint8_t maxErrs;
     if (m_state == P25RXS_NONE)
         maxErrs = MAX_SYNC_BITS_START_ERRS;
@@ -412,6 +467,7 @@ bool P25RX::correlateSync()
 
         m_lostCount = MAX_SYNC_FRAMES;
         m_dataPtr = P25_SYNC_LENGTH_BITS;
+        TRACE_SYNC();
 
         DEBUG4("P25RX::correlateSync() dataPtr/endPtr/pduEndPtr", m_dataPtr, m_endPtr, m_pduEndPtr);
 
@@ -425,24 +481,28 @@ bool P25RX::correlateSync()
 
 bool P25RX::decodeNid()
 {
-    uint8_t nid[P25_NID_LENGTH_BYTES];
-    for (int i = 6U; i < 8U; i++)
-        nid[i - 6U] = m_buffer[i];
-
-    if (m_nac == 0xF7EU) {
-        m_duid = nid[1U] & 0x0FU;
-        DEBUG2("P25RX::decodeNid() DUID for xDU", m_duid);
-        return true;
+    PROFILE_SCOPE(PROBE_P25_RX_NID);
+
+    // the NID is corrected in place, so the host receives the corrected NAC and DUID
+    P25NID nid;
+    uint16_t nac;
+    uint8_t duid, errs;
+    if (!nid.decode(m_buffer, nac, duid, errs)) {
+        m_rejected[P25RXR_NID]++;
+        DEBUG1("P25RX::decodeNid() uncorrectable NID");
+        return false;
     }
 
-    uint16_t nac = (nid[0U] << 4) | ((nid[1U] & 0xF0U) >> 4);
-    if (nac == m_nac) {
-        m_duid = nid[1U] & 0x0FU;
-        DEBUG2("P25RX::decodeNid() DUID for xDU", m_duid);
+    m_nidCorrected += errs;
+
+    if (((m_nacs[nac >> 5] >> (nac & 0x1FU)) & 0x01U) == 0x01U) {
+        m_duid = duid;
+        DEBUG3("P25RX::decodeNid() DUID for xDU, errs", m_duid, errs);
         return true;
     }
     else {
-        DEBUG3("P25RX::decodeNid() invalid NAC found; nac != m_nac", nac, m_nac);
+        m_rejected[P25RXR_NAC]++;
+        DEBUG3("P25RX::decodeNid() invalid NAC found; nac not allowed", nac, m_nac);
     }
 
     return false;
@@ -38,6 +38,21 @@ namespace p25
         P25RXS_DATA         //! PDU Data
     };
 
+    /**
+     * @brief P25 Receiver Frame Reject Reasons
+     * @ingroup p25_hfw
+     */
+    enum P25RX_REJECT {
+        P25RXR_NID,         //! Uncorrectable NID
+        P25RXR_NAC,         //! NAC Not Allowed
+        P25RXR_DUID,        //! Illegal DUID
+
+        P25RXR_COUNT
+    };
+
+    const uint16_t P25_NAC_ALL = 0xF7EU;
+    const uint16_t P25_NAC_COUNT = 4096U;
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
@@ -69,6 +84,23 @@ namespace p25
          * @param nac Network Access Code.
          */
         void setNAC(uint16_t nac);
+        /**
+         * @brief Adds a P25 NAC to those allowed.
+         * @param nac Network Access Code.
+         */
+        void allowNAC(uint16_t nac);
+
+        /**
+         * @brief Gets the number of frames rejected at the NID for the given reason.
+         * @param reason Reject reason.
+         * @returns uint32_t Number of frames rejected.
+         */
+        uint32_t getRejected(P25RX_REJECT reason) const { return m_rejected[reason]; }
+        /**
+         * @brief Gets the number of bits the BCH (63,16) decoder corrected in the NIDs decoded.
+         * @returns uint32_t Number of NID bits corrected.
+         */
+        uint32_t getNIDCorrected() const { return m_nidCorrected; }
 
     private:
         uint64_t m_bitBuffer;
@@ -82,6 +114,10 @@ namespace p25
         uint16_t m_lostCount;
 
         uint16_t m_nac;
+        uint32_t m_nacs[P25_NAC_COUNT / 32U];   // 512 bytes
+
+        uint32_t m_rejected[P25RXR_COUNT];
+        uint32_t m_nidCorrected;
 
         P25RX_STATE m_state;
 
@@ -111,7 +147,7 @@ namespace p25
 
         /**
          * @brief Helper to decode the P25 NID.
-         * @returns bool True, if P25 NID was decoded, otherwise false.
+         * @returns bool True, if P25 NID was decoded and its NAC is allowed, otherwise false.
          */
         bool decodeNid();
     };
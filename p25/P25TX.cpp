@@ -29,7 +29,8 @@ P25TX::P25TX() :
     m_poPtr(0U),
     m_preambleCnt(P25_FIXED_DELAY),
     m_txHang(P25_FIXED_TX_HANG),
-    m_tailCnt(0U)
+    m_tailCnt(0U),
+    m_schedule(CMD_P25_DATA)
 {
     /* stub */
 }
@@ -38,25 +39,35 @@ P25TX::P25TX() :
 
 void P25TX::process()
 {
-    if (m_fifo.getData() == 0U && m_poLen == 0U && m_tailCnt > 0U &&
+    PROFILE_SCOPE(PROBE_P25_TX_PROCESS);
+
+    // a frame with a launch time beyond the hang (and the preamble to key up again) doesn't keep the
+    // transmitter keyed; the hang runs out as if the FIFO were empty
+    bool waiting = m_fifo.getData() > 0U && m_schedule.isWaiting(m_tailCnt * 4U + m_preambleCnt * 8U);
+    if ((m_fifo.getData() == 0U || waiting) && m_poLen == 0U && m_tailCnt > 0U &&
         m_state != P25TXSTATE_CAL) {
         // transmit silence until the hang timer has expired
         uint16_t space = io.getSpace();
+        uint16_t count = 0U;
 
         while (space > 8U) {
-            writeSilence();
+            count++;
 
             space -= 8U;
             m_tailCnt--;
 
             if (m_tailCnt == 0U)
-                return;
-            if (m_fifo.getData() > 0U) {
+                break;
+            if (m_fifo.getData() > 0U && !waiting) {
                 m_tailCnt = 0U;
-                return;
+                break;
             }
         }
 
+        writeSilence(count);
+        if (m_tailCnt == 0U)
+            return;
+
         if (m_fifo.getData() == 0U && m_poLen == 0U)
             return;
     }
@@ -70,26 +81,34 @@ void P25TX::process()
             if (m_fifo.getData() == 0U)
                 return;
 
+            // a frame with a launch time is held, unkeyed until its preamble is due and then with
+            // silence, until it goes out
+            if (!m_tx && m_schedule.isWaiting(m_preambleCnt * 8U))
+                return;
+            if (m_tx && m_schedule.hold(0x00U, m_tailCnt * 4U + m_preambleCnt * 8U))
+                return;
+
             createData();
         }
     }
 
     if (m_poLen > 0U) {
         uint16_t space = io.getSpace();
+        if (space <= 8U)
+            return;
 
-        while (space > 8U) {
-            uint8_t c = m_poBuffer[m_poPtr++];
+        // write as many whole bytes as fit in one go
+        uint16_t count = (space - 1U) / 8U;
+        if (count > m_poLen - m_poPtr)
+            count = m_poLen - m_poPtr;
 
-            writeByte(c);
+        io.writeBytes(m_poBuffer + m_poPtr, count);
+        m_poPtr += count;
+        m_tailCnt = m_txHang;
 
-            space -= 8U;
-            m_tailCnt = m_txHang;
-
-            if (m_poPtr >= m_poLen) {
-                m_poPtr = 0U;
-                m_poLen = 0U;
-                return;
-            }
+        if (m_poPtr >= m_poLen) {
+            m_poPtr = 0U;
+            m_poLen = 0U;
         }
     }
 }
@@ -98,15 +117,15 @@ void P25TX::process()
 
 uint8_t P25TX::writeData(const uint8_t* data, uint16_t length)
 {
+    uint32_t launch = 0U;
+    bool timed = TXSchedule::getLaunch(data, length, launch);
     if (length < (P25_TDU_FRAME_LENGTH_BYTES + 1U))
         return RSN_ILLEGAL_LENGTH;
 
     uint16_t space = m_fifo.getSpace();
     DEBUG3("P25TX::writeData() dataLength/fifoLength", length, space);
-    if (space < length) {
-        m_fifo.reset();
+    if (space < length || (timed && !m_schedule.hasSpace()))
         return RSN_RINGBUFF_FULL;
-    }
 
     if (length <= 255U) {
         m_fifo.put(DVM_SHORT_FRAME_START);
@@ -120,6 +139,7 @@ uint8_t P25TX::writeData(const uint8_t* data, uint16_t length)
     for (uint16_t i = 0U; i < (length - 1U); i++)
         m_fifo.put(data[i + 1U]);
 
+    m_schedule.put(timed, launch);
     return RSN_OK;
 }
 
@@ -128,6 +148,7 @@ uint8_t P25TX::writeData(const uint8_t* data, uint16_t length)
 void P25TX::clear()
 {
     m_fifo.reset();
+    m_schedule.reset();
 }
 
 /* Sets the FDMA preamble count. */
@@ -168,6 +189,7 @@ void P25TX::resizeBuffer(uint16_t size)
 {
     m_fifo.reset();
     m_fifo.reinitialize(size);
+    m_schedule.reset();
 }
 
 /* Helper to get how much space the ring buffer has for samples. */
@@ -177,6 +199,14 @@ uint8_t P25TX::getSpace() const
     return m_fifo.getSpace() / P25_LDU_FRAME_LENGTH_BYTES;
 }
 
+/* Helper to get how long the queued frames, and the rest of the frame being sent, take to go out. */
+
+uint16_t P25TX::getQueuedMs() const
+{
+    // 9600 bps; this counts the 2 or 3 byte length header of each queued frame as airtime too
+    return (uint16_t)((uint32_t(m_fifo.getData() + (m_poLen - m_poPtr)) * 8000U) / 9600U);
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
@@ -190,6 +220,8 @@ void P25TX::createData()
             m_poBuffer[m_poLen++] = P25_START_SYNC;
     }
     else {
+        m_schedule.take();
+
         uint8_t frameType = m_fifo.get();
         uint16_t length = 0U;
         switch (frameType) {
@@ -227,30 +259,14 @@ void P25TX::createCal()
     m_poPtr = 0U;
 }
 
-/* Helper to write a raw byte to the DAC. */
-
-void P25TX::writeByte(uint8_t c)
-{
-    uint8_t bit;
-    uint8_t mask = 0x80U;
-
-    for (uint8_t i = 0U; i < 8U; i++, c <<= 1) {
-        if ((c & mask) == mask)
-            bit = 1U;
-        else
-            bit = 0U;
-
-        io.write(&bit, 1);
-    }
-}
-
-/* */
+/* Helper to write silence (4 bits per count) to the DAC. */
 
-void P25TX::writeSilence()
+void P25TX::writeSilence(uint16_t count)
 {
-    uint8_t bit;
-    for (uint8_t i = 0U; i < 4U; i++) {
-        bit = 0U;
-        io.write(&bit, 1);
+    uint32_t bits = count * 4U;
+    while (bits > 0U) {
+        uint8_t n = (bits > 32U) ? 32U : uint8_t(bits);
+        io.writeBits(0U, n);
+        bits -= n;
     }
 }
@@ -20,6 +20,7 @@
 
 #include "Defines.h"
 #include "SerialBuffer.h"
+#include "TXSchedule.h"
 
 namespace p25
 {
@@ -99,6 +100,16 @@ namespace p25
          * @returns uint8_t Amount of space in ring buffer for samples. 
          */
         uint8_t getSpace() const;
+        /**
+         * @brief Helper to get how many bytes are free in the ring buffer.
+         * @returns uint16_t Free space in the ring buffer, in bytes.
+         */
+        uint16_t getFreeBytes() const { return m_fifo.getSpace(); }
+        /**
+         * @brief Helper to get how long the queued frames, and the rest of the frame being sent, take to go out.
+         * @returns uint16_t Queued airtime, in milliseconds.
+         */
+        uint16_t getQueuedMs() const;
 
     private:
         SerialBuffer m_fifo;
@@ -113,6 +124,8 @@ namespace p25
         uint32_t m_txHang;
         uint32_t m_tailCnt;
 
+        TXSchedule m_schedule;
+
         /**
          * @brief Helper to generate data.
          */
@@ -123,14 +136,10 @@ namespace p25
         void createCal();
 
         /**
-         * @brief Helper to write a raw byte to the DAC.
-         * @param c Byte.
-         */
-        void writeByte(uint8_t c);
-        /**
-         * @brief 
+         * @brief Helper to write silence to the DAC.
+         * @param count Number of 4 bit silences to write.
          */
-        void writeSilence();
+        void writeSilence(uint16_t count);
     };
 } // namespace p25
 